@@ -0,0 +1,46 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "DenseFactorization.h"
+
+/**
+ * Times the factorizations of DenseFactorization, which dominate the cost of the inverse power methods, on a general
+ * matrix and on a symmetric positive definite matrix of increasing size.
+ */
+template <typename T>
+double Time(const Eigen::Matrix<T, -1, -1> &A, const std::string &factorization) {
+    DenseFactorization<T> dense_factorization(factorization);
+    auto start = std::chrono::steady_clock::now();
+    dense_factorization.Compute(A);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main() {
+    std::vector<std::string> factorizations = {"fullpivlu", "partialpivlu", "qr", "llt", "auto"};
+    std::cout << std::setw(6) << "n" << std::setw(12) << "matrix";
+    for (const std::string &factorization : factorizations) {
+        std::cout << std::setw(14) << factorization;
+    }
+    std::cout << std::endl;
+
+    for (int n : {250, 500, 1000, 2000}) {
+        std::srand(0);
+        Eigen::Matrix<double, -1, -1> A = Eigen::Matrix<double, -1, -1>::Random(n, n);
+        Eigen::Matrix<double, -1, -1> S = A.transpose() * A + Eigen::Matrix<double, -1, -1>::Identity(n, n);
+        for (const auto &[name, M] : {std::make_pair("general", A), std::make_pair("spd", S)}) {
+            std::cout << std::setw(6) << n << std::setw(12) << name;
+            for (const std::string &factorization : factorizations) {
+                if (factorization == "llt" && std::string(name) == "general") {
+                    std::cout << std::setw(14) << "-";
+                    continue;
+                }
+                std::cout << std::setw(14) << std::fixed << std::setprecision(4) << Time<double>(M, factorization);
+            }
+            std::cout << std::endl;
+        }
+    }
+    return 0;
+}
@@ -5,11 +5,19 @@
 
 #include "AbstractEigs.h"
 #include "AbstractPowerMethod.h"
+#include "ArnoldiMethod.h"
+#include "BisectionMethod.h"
+#include "CpuDispatch.h"
+#include "EigsPlanner.h"
 #include "InvPowerMethod.h"
+#include "LanczosMethod.h"
+#include "LOBPCGMethod.h"
 #include "PowerMethod.h"
 #include "QRMethod.h"
 #include "ShiftPowerMethod.h"
 #include "ShiftInvPowerMethod.h"
+#include "SubspaceIteration.h"
+#include "SymmetricQRMethod.h"
 
 #include "Reader.h"
 #include "FileReader.h"
@@ -47,7 +55,20 @@ int main(int argc, char **argv) {
     std::unique_ptr<AbstractEigs<std::complex<double>>> p_eigsSolver_complex;
 
     // Creating the solver according to the method and the type
-    if (method == "power"){
+    if (method == "auto"){
+        // The method is chosen by the planner looking at the structure of the matrix
+        if (type == "real") {
+            EigsPlanner<double> planner(p_Reader_real->_map);
+            p_eigsSolver_real = planner.CreateSolver();
+            method += " (" + planner.GetMethod() + ")";
+        }
+        else { // type == "complex"
+            EigsPlanner<std::complex<double>> planner(p_Reader_complex->_map);
+            p_eigsSolver_complex = planner.CreateSolver();
+            method += " (" + planner.GetMethod() + ")";
+        }
+    }
+    else if (method == "power"){
         if (type == "real") {
             p_eigsSolver_real = std::make_unique<PowerMethod<double>>(p_Reader_real->_map);
         }
@@ -84,7 +105,55 @@ int main(int argc, char **argv) {
             p_eigsSolver_real = std::make_unique<QRMethod<double>>(p_Reader_real->_map);
         }
         else { // type == "complex"
-            throw (std::runtime_error("QR Method implemented for real matrices only"));
+            p_eigsSolver_complex = std::make_unique<QRMethod<std::complex<double>>>(p_Reader_complex->_map);
+        }
+    }
+    else if (method == "symqr"){
+        if (type == "real") {
+            p_eigsSolver_real = std::make_unique<SymmetricQRMethod<double>>(p_Reader_real->_map);
+        }
+        else { // type == "complex"
+            p_eigsSolver_complex = std::make_unique<SymmetricQRMethod<std::complex<double>>>(p_Reader_complex->_map);
+        }
+    }
+    else if (method == "bisection"){
+        if (type == "real") {
+            p_eigsSolver_real = std::make_unique<BisectionMethod<double>>(p_Reader_real->_map);
+        }
+        else { // type == "complex"
+            p_eigsSolver_complex = std::make_unique<BisectionMethod<std::complex<double>>>(p_Reader_complex->_map);
+        }
+    }
+    else if (method == "subspace"){
+        if (type == "real") {
+            p_eigsSolver_real = std::make_unique<SubspaceIteration<double>>(p_Reader_real->_map);
+        }
+        else { // type == "complex"
+            p_eigsSolver_complex = std::make_unique<SubspaceIteration<std::complex<double>>>(p_Reader_complex->_map);
+        }
+    }
+    else if (method == "arnoldi"){
+        if (type == "real") {
+            p_eigsSolver_real = std::make_unique<ArnoldiMethod<double>>(p_Reader_real->_map);
+        }
+        else { // type == "complex"
+            p_eigsSolver_complex = std::make_unique<ArnoldiMethod<std::complex<double>>>(p_Reader_complex->_map);
+        }
+    }
+    else if (method == "lanczos"){
+        if (type == "real") {
+            p_eigsSolver_real = std::make_unique<LanczosMethod<double>>(p_Reader_real->_map);
+        }
+        else { // type == "complex"
+            p_eigsSolver_complex = std::make_unique<LanczosMethod<std::complex<double>>>(p_Reader_complex->_map);
+        }
+    }
+    else if (method == "lobpcg"){
+        if (type == "real") {
+            p_eigsSolver_real = std::make_unique<LOBPCGMethod<double>>(p_Reader_real->_map);
+        }
+        else { // type == "complex"
+            p_eigsSolver_complex = std::make_unique<LOBPCGMethod<std::complex<double>>>(p_Reader_complex->_map);
         }
     }
     else { // The method is not one of the specified ones
@@ -106,4 +175,5 @@ int main(int argc, char **argv) {
     
     std::cout << "Eigenvalues computed using " << method << " method" << std::endl;
     std::cout << eigs << std::endl;
+    std::cout << "Kernels compiled for the instruction set: " << CpuDispatch::GetPathName() << std::endl;
 }
@@ -1,4 +1,6 @@
 #include "AbstractEigs.h"
+#include "IterationKernels.h"
+#include <random>
 
 // CONSTRUCTORS
 /**
@@ -21,12 +23,46 @@ AbstractEigs<T>::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &t
     SetMaxit(maxit);
 }
 
+/**
+ * @details The matrix is stored in compressed sparse row format, so that its memory cost scales with the number of
+ * nonzero entries.
+ */
+template <typename T>
+AbstractEigs<T>::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) {
+    SetMatrix(A);
+}
+
+template <typename T>
+AbstractEigs<T>::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit) {
+    SetMatrix(A);
+    SetTol(tol);
+    SetMaxit(maxit);
+}
+
+/**
+ * @details The matrix is never stored: the methods supporting linear operators only apply it to vectors, so that
+ * their memory cost is \f$O(n)\f$.
+ */
+template <typename T>
+AbstractEigs<T>::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A) {
+    SetMatrix(A);
+}
+
+template <typename T>
+AbstractEigs<T>::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit) {
+    SetMatrix(A);
+    SetTol(tol);
+    SetMaxit(maxit);
+}
+
 /**
  * @details This constructor is useful in cases in which the user reads the input from a file and wants to pass it to
  * the eigenvalues problem solver in a format such that is the solver itself who picks the arguments it needs.
  *
- * At least the matrix has to be provided. If the tolerance or the maximum number of iterations are not provided they
- * are set to the default value and a warning is given to the user.
+ * At least the matrix has to be provided, either as <tt>Eigen::Matrix<T, -1, -1></tt>, as
+ * <tt>Eigen::SparseMatrix<T, Eigen::RowMajor></tt> or as <tt>std::shared_ptr<const LinearOperator<T>></tt>. If the tolerance or the maximum number of iterations are not provided they
+ * are set to the default value and a warning is given to the user. The matrix is balanced if the key <tt>balance</tt>
+ * is associated with a nonzero number, otherwise it is not.
  */
 template <typename T>
 AbstractEigs<T>::AbstractEigs(std::map<std::string, std::any> &map) {
@@ -34,11 +70,19 @@ AbstractEigs<T>::AbstractEigs(std::map<std::string, std::any> &map) {
     if (map.count("matrix") == 0) {
         throw(InitializationError("Missing argument: matrix"));
     }
-    try {
-        SetMatrix(std::any_cast<Eigen::Matrix<T, -1, -1>>(map["matrix"]));
+    if (map["matrix"].type() == typeid(Eigen::SparseMatrix<T, Eigen::RowMajor>)) {
+        SetMatrix(std::any_cast<const Eigen::SparseMatrix<T, Eigen::RowMajor> &>(map["matrix"]));
+    }
+    else if (map["matrix"].type() == typeid(std::shared_ptr<const LinearOperator<T>>)) {
+        SetMatrix(std::any_cast<const std::shared_ptr<const LinearOperator<T>> &>(map["matrix"]));
     }
-    catch (std::bad_any_cast &e){
-        throw(InitializationError("Unable to cast the matrix to the expected type"));
+    else {
+        try {
+            SetMatrix(std::any_cast<Eigen::Matrix<T, -1, -1>>(map["matrix"]));
+        }
+        catch (std::bad_any_cast &e){
+            throw(InitializationError("Unable to cast the matrix to the expected type"));
+        }
     }
 
     // Getting and setting the tolerance
@@ -74,6 +118,18 @@ AbstractEigs<T>::AbstractEigs(std::map<std::string, std::any> &map) {
     else {// map.count("tol") == 0
         std::cerr << "WARNING: Unspecified maximum number of iterations (maxit). Set by default maxit = 10000" << std::endl;
     }
+
+    // Getting and setting the balancing flag
+    if (map.count("balance") > 0) {
+        double balance;
+        try {
+            balance = std::any_cast<double>(map["balance"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the balance to double"));
+        }
+        SetBalance(balance != 0);
+    }
 }
 
 // SETTING METHODS
@@ -101,6 +157,26 @@ void AbstractEigs<T>::SetMaxit(const int &maxit) {
     _maxit = maxit;
 }
 
+/**
+ * @details The balancing of the matrix is computed once, when it is enabled, and reused by every call of ComputeEigs().
+ * Sparse matrices cannot be balanced: if the matrix is sparse, it throws an exception of type InitializationError with
+ * message: <tt>Attempting to balance a sparse matrix</tt>. Similarly, if a linear operator is set, the message is
+ * <tt>Attempting to balance a linear operator</tt>.
+ */
+template <typename T>
+void AbstractEigs<T>::SetBalance(const bool &balance) {
+    if (balance && _sparse) {
+        throw(InitializationError("Attempting to balance a sparse matrix"));
+    }
+    if (balance && _operator) {
+        throw(InitializationError("Attempting to balance a linear operator"));
+    }
+    if (balance && !_balance) {
+        _balancing.Compute(_A);
+    }
+    _balance = balance;
+}
+
 /**
  * @details Protected method to set the matrix whose eigenvalues are to be computed.
  * If the given matrix is non square, it throws an exception of type InitializationError with message: <tt>Attempting to set a
@@ -112,6 +188,161 @@ void AbstractEigs<T>::SetMatrix(const Eigen::Matrix<T, -1, -1> &A) {
         throw(InitializationError("Attempting to set a non square matrix"));
     }
     _A = A;
+    _A_sparse.resize(0, 0);
+    _sparse = false;
+    _operator.reset();
+    if (_balance) {
+        _balancing.Compute(_A);
+    }
+}
+
+/**
+ * @details Protected method to set the sparse matrix whose eigenvalues are to be computed. The dense matrix
+ * AbstractEigs::_A is left empty.
+ * If the given matrix is non square, it throws an exception of type InitializationError with message: <tt>Attempting
+ * to set a non square matrix</tt>.
+ */
+template <typename T>
+void AbstractEigs<T>::SetMatrix(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) {
+    if (A.rows() != A.cols()){
+        throw(InitializationError("Attempting to set a non square matrix"));
+    }
+    _A_sparse = A;
+    _A_sparse.makeCompressed();
+    _A.resize(0, 0);
+    _sparse = true;
+    _operator.reset();
+}
+
+/**
+ * @details Protected method to set the linear operator whose eigenvalues are to be computed. The matrices
+ * AbstractEigs::_A and AbstractEigs::_A_sparse are left empty.
+ * If the given pointer is null, it throws an exception of type InitializationError with message: <tt>Attempting to set
+ * a null linear operator</tt>.
+ */
+template <typename T>
+void AbstractEigs<T>::SetMatrix(const std::shared_ptr<const LinearOperator<T>> &A) {
+    if (!A){
+        throw(InitializationError("Attempting to set a null linear operator"));
+    }
+    _operator = A;
+    _A.resize(0, 0);
+    _A_sparse.resize(0, 0);
+    _sparse = false;
+}
+
+/**
+ * @details The whole block is multiplied at once: a dense matrix is read once for all the columns, with the
+ * matrix-matrix product of Eigen (GEMM) instead of a product with each column (GEMV), and so is a sparse matrix. A
+ * linear operator is applied with LinearOperator::ApplyBlock.
+ */
+template <typename T>
+void AbstractEigs<T>::ApplyMatrix(const Eigen::Matrix<T, -1, -1> &X, Eigen::Matrix<T, -1, -1> &Y) const {
+    if (_operator) {
+        _operator->ApplyBlock(X, Y);
+    }
+    else if (_sparse) {
+        Y.noalias() = _A_sparse * X;
+    }
+    else {
+        Y.noalias() = WorkMatrix() * X;
+    }
+}
+
+/**
+ * @details The product with a dense matrix is executed by IterationKernels::Gemv, with the instruction set selected at
+ * run time.
+ */
+template <typename T>
+void AbstractEigs<T>::ApplyMatrix(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) const {
+    if (_operator) {
+        _operator->Apply(x, y);
+    }
+    else if (_sparse) {
+        y.noalias() = _A_sparse * x;
+    }
+    else {
+        const Eigen::Matrix<T, -1, -1> &A = WorkMatrix();
+        IterationKernels<T>::Gemv(A.data(), x.data(), y.data(), A.rows(), A.cols());
+    }
+}
+
+// RANDOM VECTORS
+/*
+ * Entries uniformly distributed in [-1, 1], generated by the given generator.
+ */
+static Eigen::Matrix<double, -1, -1> UniformMatrix(const int &n, const int &p, std::mt19937 &generator) {
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    Eigen::Matrix<double, -1, -1> X(n, p);
+    for (int j = 0; j < p; j++) {
+        for (int i = 0; i < n; i++) {
+            X(i, j) = distribution(generator);
+        }
+    }
+    return X;
+}
+
+template <>
+Eigen::Matrix<double, -1, -1> AbstractEigs<double>::RandomBlock(const int &n, const int &p) {
+    std::mt19937 generator(0);
+    return UniformMatrix(n, p, generator);
+}
+
+template <>
+Eigen::Matrix<std::complex<double>, -1, -1> AbstractEigs<std::complex<double>>::RandomBlock(const int &n,
+                                                                                           const int &p) {
+    std::mt19937 generator(0);
+    Eigen::Matrix<double, -1, -1> real = UniformMatrix(n, p, generator);
+    Eigen::Matrix<double, -1, -1> imag = UniformMatrix(n, p, generator);
+    Eigen::Matrix<std::complex<double>, -1, -1> X(n, p);
+    X.real() = real;
+    X.imag() = imag;
+    return X;
+}
+
+/**
+ * @details If the matrix, either dense or sparse, does not satisfy \f$||A - A^*|| \leq 10^{-12} ||A||\f$, it throws an
+ * exception of type InitializationError with message: <tt>Attempting to set a non self-adjoint matrix</tt>. Linear
+ * operators cannot be checked and are assumed to be self-adjoint.
+ */
+template <typename T>
+void AbstractEigs<T>::CheckSelfAdjoint() {
+    if (_sparse) {
+        Eigen::SparseMatrix<T, Eigen::RowMajor> adjoint = _A_sparse.adjoint();
+        if ((_A_sparse - adjoint).norm() > 1e-12 * _A_sparse.norm()) {
+            throw(InitializationError("Attempting to set a non self-adjoint matrix"));
+        }
+        return;
+    }
+    if ((_A - _A.adjoint()).norm() > 1e-12 * _A.norm()) {
+        throw(InitializationError("Attempting to set a non self-adjoint matrix"));
+    }
+}
+
+/**
+ * @details If the matrix is sparse, it throws an exception of type InitializationError with message:
+ * <tt>Sparse matrices are not supported by this method</tt>. If a linear operator is set, the message is
+ * <tt>Linear operators are not supported by this method</tt>.
+ */
+template <typename T>
+void AbstractEigs<T>::CheckDense() {
+    if (_sparse) {
+        throw(InitializationError("Sparse matrices are not supported by this method"));
+    }
+    if (_operator) {
+        throw(InitializationError("Linear operators are not supported by this method"));
+    }
+}
+
+/**
+ * @details If a linear operator is set, it throws an exception of type InitializationError with message:
+ * <tt>Linear operators are not supported by this method</tt>.
+ */
+template <typename T>
+void AbstractEigs<T>::CheckStored() {
+    if (_operator) {
+        throw(InitializationError("Linear operators are not supported by this method"));
+    }
 }
 
 // Explicit instantiation for double and std::complex<double>
@@ -2,13 +2,17 @@
 #define ABSTRACTEIGS_H_
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include <iostream>
 #include <complex>
 #include <vector>
 #include <map>
 #include <string>
 #include <any>
+#include <memory>
 #include "Exceptions.h"
+#include "Balancing.h"
+#include "LinearOperator.h"
 
 /** @class AbstractEigs
  * @brief Abstract class for computing eigenvalues of general matrices.
@@ -48,6 +52,36 @@
  *  \f$\sigma\f$ can be used. Call the function ShiftInvPowerMethod::ComputeEigs() to have returned the eigenvalue
  *  closest to a previously set shift \f$\sigma\f$, computed using the Inverse Power Method with shift.
  *  @see ShiftInvPowerMethod
+ *  - to compute the \f$k\f$ largest magnitude eigenvalues, the Subspace Iteration @cite GolubVanLoan can be used. Call
+ *  the function SubspaceIteration::ComputeEigs() to have returned the \f$k\f$ largest magnitude eigenvalues of a real or
+ *  complex matrix, computed iterating a block of vectors.
+ *  @see SubspaceIteration
+ *  - to compute a few eigenvalues of a large matrix, of largest magnitude, of largest real part or closest to a shift,
+ *  the implicitly restarted Arnoldi method @cite GolubVanLoan can be used. Call the function
+ *  ArnoldiMethod::ComputeEigs() to have returned the \f$k\f$ wanted eigenvalues, computed from a Krylov subspace of
+ *  fixed size.
+ *  @see ArnoldiMethod
+ *  - to compute a few eigenvalues of a large symmetric or Hermitian matrix, the thick-restart Lanczos method
+ *  @cite GolubVanLoan can be used. Call the function LanczosMethod::ComputeEigs() to have returned the \f$k\f$ largest
+ *  magnitude, largest or smallest eigenvalues, computed with a three-term recurrence and partial reorthogonalization.
+ *  @see LanczosMethod
+ *  - to compute the \f$k\f$ smallest eigenvalues of a large symmetric or Hermitian positive definite matrix without
+ *  factorizing it, the LOBPCG method @cite Knyazev2001 can be used. Call the function LOBPCGMethod::ComputeEigs() to
+ *  have returned them, computed iterating a block of vectors with an optional preconditioner.
+ *  @see LOBPCGMethod
+ *
+ * Matrices whose entries differ by many orders of magnitude can be balanced before any of the methods is executed,
+ * calling AbstractEigs::SetBalance or setting the key <tt>balance</tt> in the map-based constructor. The methods are then
+ * executed on the balanced matrix \f$B = D^{-1} P^T A P D\f$, which has the same eigenvalues of \f$A\f$, and usually
+ * need fewer iterations. @see Balancing
+ *
+ * Large sparse matrices can be stored in compressed sparse row format, as <tt>Eigen::SparseMatrix<T, Eigen::RowMajor></tt>,
+ * instead of as dense matrices. Their memory cost and the cost of a product with a vector scale with the number of
+ * nonzero entries instead of \f$n^2\f$. Sparse matrices are supported by PowerMethod, ShiftPowerMethod,
+ * SubspaceIteration, ArnoldiMethod, LanczosMethod and LOBPCGMethod, and by InvPowerMethod and ShiftInvPowerMethod
+ * through a sparse factorization, while the other
+ * methods transform the matrix and would fill it in. For the same reason, the methods that only multiply by the matrix
+ * can also iterate on a LinearOperator, which is never stored as a matrix.
  */
 template <typename T> class AbstractEigs {
 public:
@@ -66,11 +100,40 @@ public:
      */
     AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit);
 
+    /**
+     * @brief Constructor; sets the given sparse matrix.
+     * @param A Square sparse matrix whose eigenvalues are to be computed.
+     */
+    AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A);
+
+    /**
+     * @brief Constructor; sets the given sparse matrix, tolerance and maximum number of iterations.
+     * @param A Square sparse matrix whose eigenvalues are to be computed.
+     * @param tol Tolerance to be used in the stopping criterion of the method.
+     * @param maxit Maximum number of iterations for which the method is to be executed.
+     */
+    AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit);
+
+    /**
+     * @brief Constructor; sets the given linear operator.
+     * @param A Linear operator whose eigenvalues are to be computed.
+     */
+    AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A);
+
+    /**
+     * @brief Constructor; sets the given linear operator, tolerance and maximum number of iterations.
+     * @param A Linear operator whose eigenvalues are to be computed.
+     * @param tol Tolerance to be used in the stopping criterion of the method.
+     * @param maxit Maximum number of iterations for which the method is to be executed.
+     */
+    AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit);
+
     /**
      * @brief Constructor; sets the parameters of the method from a map.
      * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
-     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt> and the maximum number of iterations
-     * with <tt>maxit</tt>.
+     * associated with the key <tt>matrix</tt>, either as a dense matrix, as a sparse matrix or as a linear operator, the
+     * tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt> and whether to balance the matrix with <tt>balance</tt>.
      */
     AbstractEigs(std::map<std::string, std::any> &map);
 
@@ -89,11 +152,42 @@ public:
      */
     void SetMaxit(const int &maxit);
 
+    /**
+     * @brief Sets whether the matrix is balanced before executing the method.
+     * @param balance If true, the method is executed on the balanced matrix.
+     */
+    void SetBalance(const bool &balance);
+
     /**
      * @brief Returns the matrix whose eigenvalues are to be computed.
      */
     Eigen::Matrix<T,-1,-1> GetMatrix() {return _A;};
 
+    /**
+     * @brief Returns the sparse matrix whose eigenvalues are to be computed, if a sparse matrix is set.
+     */
+    Eigen::SparseMatrix<T, Eigen::RowMajor> GetSparseMatrix() {return _A_sparse;};
+
+    /**
+     * @brief Returns the linear operator whose eigenvalues are to be computed, if a linear operator is set.
+     */
+    std::shared_ptr<const LinearOperator<T>> GetOperator() {return _operator;};
+
+    /**
+     * @brief Returns true if the matrix is stored as a sparse matrix.
+     */
+    bool IsSparse() {return _sparse;};
+
+    /**
+     * @brief Returns true if a linear operator is set instead of a matrix.
+     */
+    bool IsMatrixFree() {return bool(_operator);};
+
+    /**
+     * @brief Returns the size of the matrix, either dense or sparse, or of the linear operator.
+     */
+    int GetSize() {return _operator ? _operator->GetSize() : (_sparse ? _A_sparse.rows() : _A.rows());};
+
     /**
      * @brief Returns the tolerance used in the stopping criterion of the method.
      */
@@ -104,6 +198,16 @@ public:
      */
     int GetMaxit() {return _maxit;};
 
+    /**
+     * @brief Returns true if the matrix is balanced before executing the method.
+     */
+    bool GetBalance() {return _balance;};
+
+    /**
+     * @brief Returns the number of iterations executed by the last call of ComputeEigs().
+     */
+    int GetIterations() {return _it;};
+
     /**
      * @brief Returns the eigenvalues computed according to the method.
      * @return Vector of complex numbers containing the eigenvalues computed according to the method.
@@ -117,6 +221,25 @@ protected:
      * */
     Eigen::Matrix<T,-1,-1> _A;
 
+    /** @brief Sparse matrix
+     * @details Square matrix whose eigenvalues are to be computed, in compressed sparse row format. It is set instead
+     * of AbstractEigs::_A, which is then empty.
+     * */
+    Eigen::SparseMatrix<T, Eigen::RowMajor> _A_sparse;
+
+    /**
+     * @brief Sparse flag
+     * @details True if the matrix is stored in AbstractEigs::_A_sparse.
+     * Default value: <tt>false</tt>.
+     */
+    bool _sparse = false;
+
+    /** @brief Linear operator
+     * @details Linear operator whose eigenvalues are to be computed, if set instead of a matrix. The matrices
+     * AbstractEigs::_A and AbstractEigs::_A_sparse are then empty.
+     * */
+    std::shared_ptr<const LinearOperator<T>> _operator;
+
     /**
      * @brief Tolerance
      * @details Tolerance to be used in the stopping criterion of the method.
@@ -133,11 +256,86 @@ protected:
      */
     int _maxit = 10000;
 
+    /**
+     * @brief Balancing flag
+     * @details If true, the method is executed on the balanced matrix AbstractEigs::_balancing.
+     * Default value: <tt>false</tt>.
+     */
+    bool _balance = false;
+
+    /**
+     * @brief Balancing of the matrix, computed when the balancing is enabled.
+     */
+    Balancing<T> _balancing;
+
+    /**
+     * @brief Number of iterations executed by the last call of ComputeEigs().
+     */
+    int _it = 0;
+
+    /**
+     * @brief Returns the matrix on which the method is executed: the balanced matrix if the balancing is enabled,
+     * the matrix AbstractEigs::_A otherwise.
+     */
+    const Eigen::Matrix<T, -1, -1> &WorkMatrix() const {return _balance ? _balancing.GetMatrix() : _A;};
+
+    /**
+     * @brief Protected method to apply the matrix on which the method is executed to a block of vectors.
+     * @param X Matrix with \f$n\f$ rows, whose columns are the vectors to which the matrix is applied.
+     * @param Y Matrix in which the result is written, resized if necessary. It cannot be X.
+     */
+    void ApplyMatrix(const Eigen::Matrix<T, -1, -1> &X, Eigen::Matrix<T, -1, -1> &Y) const;
+
+    /**
+     * @brief Protected method to apply the matrix on which the method is executed to a vector.
+     * @param x Vector of size \f$n\f$.
+     * @param y Vector in which the result is written, already of size \f$n\f$. It cannot be x.
+     */
+    void ApplyMatrix(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) const;
+
+    /**
+     * @brief Protected method returning a block of pseudo-random vectors, generated with a fixed seed so that the
+     * results of the methods starting from it are reproducible.
+     * @param n Number of rows.
+     * @param p Number of columns.
+     * @return Matrix whose entries have real and imaginary parts uniformly distributed in \f$[-1, 1]\f$.
+     */
+    static Eigen::Matrix<T, -1, -1> RandomBlock(const int &n, const int &p);
+
     /**
      * @brief Protected method to set the matrix.
      * @param A Square matrix whose eigenvalues are to be computed.
      */
     void SetMatrix(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Protected method to set the sparse matrix.
+     * @param A Square sparse matrix whose eigenvalues are to be computed.
+     */
+    void SetMatrix(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A);
+
+    /**
+     * @brief Protected method to set the linear operator.
+     * @param A Linear operator whose eigenvalues are to be computed.
+     */
+    void SetMatrix(const std::shared_ptr<const LinearOperator<T>> &A);
+
+    /**
+     * @brief Protected method to check that the matrix is dense, for the methods that do not support sparse matrices
+     * and linear operators.
+     */
+    void CheckDense();
+
+    /**
+     * @brief Protected method to check that the matrix is stored, either as a dense or as a sparse matrix, for the
+     * methods that do not support linear operators.
+     */
+    void CheckStored();
+
+    /**
+     * @brief Protected method to check that the matrix is symmetric or Hermitian, for the methods that require it.
+     */
+    void CheckSelfAdjoint();
 };
 
 
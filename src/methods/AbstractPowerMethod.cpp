@@ -1,4 +1,8 @@
 #include "AbstractPowerMethod.h"
+#include "IterationKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
 
 // CONSTRUCTORS
@@ -21,6 +25,38 @@ AbstractPowerMethod<T>::AbstractPowerMethod(const Eigen::Matrix<T, -1, -1> &A, c
     SetInitVec(x0);
 }
 
+/**
+ * Sets the given sparse matrix and sets by default the initial vector to a vector of all ones.
+ */
+template <typename T>
+AbstractPowerMethod<T>::AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractEigs<T>(A) {
+    // Setting by default the initial vector to the vector of all ones.
+    _x0 = Eigen::Vector<T, -1>::Ones(A.cols());
+}
+
+template <typename T>
+AbstractPowerMethod<T>::AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol,
+                                            const int maxit, const Eigen::Matrix<T, -1, 1> &x0)
+                                            : AbstractEigs<T>(A, tol, maxit) {
+    SetInitVec(x0);
+}
+
+/**
+ * Sets the given linear operator and sets by default the initial vector to a vector of all ones.
+ */
+template <typename T>
+AbstractPowerMethod<T>::AbstractPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractEigs<T>(A) {
+    // Setting by default the initial vector to the vector of all ones.
+    _x0 = Eigen::Vector<T, -1>::Ones(this->GetSize());
+}
+
+template <typename T>
+AbstractPowerMethod<T>::AbstractPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol,
+                                            const int maxit, const Eigen::Matrix<T, -1, 1> &x0)
+                                            : AbstractEigs<T>(A, tol, maxit) {
+    SetInitVec(x0);
+}
+
 /**
  * @details At least the matrix has to be provided. If the initial vector is not provided, it is set by default to a
  * vector of all ones and a warning is given to the user. If the tolerance or the maximum number of iterations are not
@@ -31,7 +67,7 @@ AbstractPowerMethod<T>::AbstractPowerMethod(std::map<std::string, std::any> &map
     // Getting and setting the initial vector
     if (map.count("x0") == 0) {
         std::cerr << "WARNING: Unspecified initial vector (x0). Set by default to vector of all ones" << std::endl;
-        _x0 = Eigen::Vector<T, -1>::Ones(this->_A.cols());
+        _x0 = Eigen::Vector<T, -1>::Ones(this->GetSize());
     }
     else { // map.count("x0") == 0
         try {
@@ -41,6 +77,54 @@ AbstractPowerMethod<T>::AbstractPowerMethod(std::map<std::string, std::any> &map
             throw (InitializationError("Unable to cast the initial vector to the expected type"));
         }
     }
+
+    // Getting and setting the layout
+    if (map.count("planar") > 0) {
+        double planar;
+        try {
+            planar = std::any_cast<double>(map["planar"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the planar layout to double"));
+        }
+        SetPlanar(planar != 0);
+    }
+
+    // Getting and setting the degree of the Chebyshev filter
+    if (map.count("filter") > 0) {
+        double degree;
+        try {
+            degree = std::any_cast<double>(map["filter"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the filter degree to double"));
+        }
+        SetFilterDegree(int(degree));
+    }
+
+    // Getting and setting the acceleration
+    if (map.count("acceleration") > 0) {
+        std::string acceleration;
+        try {
+            acceleration = std::any_cast<std::string>(map["acceleration"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the acceleration to string"));
+        }
+        SetAcceleration(acceleration);
+    }
+
+    // Getting and setting the estimate of the second eigenvalue
+    if (map.count("lambda2") > 0) {
+        double second;
+        try {
+            second = std::any_cast<double>(map["lambda2"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the second eigenvalue to double"));
+        }
+        SetSecondEigenvalue(second);
+    }
 }
 
 //SETTING METHODS
@@ -56,16 +140,93 @@ void AbstractPowerMethod<T>::SetInitVec(const Eigen::Matrix<T, -1, 1> &x0) {
     if(x0.norm() < 1e-8){
         throw(InitializationError("Attempting to set initial vector with norm almost zero"));
     }
-    if (x0.rows() != this -> _A.cols()){
+    if (x0.rows() != this->GetSize()){
         throw(InitializationError("Attempting to set initial vector with incorrect size"));
     }
     _x0 = x0;
 }
 
+/**
+ * @details If the name is not <tt>none</tt>, <tt>aitken</tt> or <tt>momentum</tt>, it throws an exception of type
+ * InitializationError with message: <tt>Unknown acceleration</tt>.
+ */
+template <typename T>
+void AbstractPowerMethod<T>::SetAcceleration(const std::string &acceleration) {
+    if (acceleration != "none" && acceleration != "aitken" && acceleration != "momentum") {
+        throw(InitializationError("Unknown acceleration"));
+    }
+    _acceleration = acceleration;
+}
+
+/**
+ * @details If the estimate is negative, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a negative estimate of the second eigenvalue</tt>.
+ */
+template <typename T>
+void AbstractPowerMethod<T>::SetSecondEigenvalue(const double &second) {
+    if (second < 0) {
+        throw(InitializationError("Attempting to set a negative estimate of the second eigenvalue"));
+    }
+    _second_eigenvalue = second;
+}
+
+template <typename T>
+Eigen::Vector<T, -1> AbstractPowerMethod<T>::StartingVector() {
+    if (!this->_balance) {
+        return _x0;
+    }
+    Eigen::Matrix<T, -1, -1> x = _x0;
+    this->_balancing.Apply(x);
+    return x.col(0);
+}
+
+template <typename T>
+Eigen::Vector<T, -1> AbstractPowerMethod<T>::BackTransform(const Eigen::Vector<T, -1> &x) {
+    if (!this->_balance) {
+        return x;
+    }
+    Eigen::Matrix<T, -1, -1> y = x;
+    this->_balancing.BackTransform(y);
+    return y.col(0);
+}
+
 // COMPUTATION OF EIGENVALUES
 /**
  * @details Computes the eigenvalues following the general scheme of a power method iteration. The method changes
- * according to how the multiplication step is executed.
+ * according to how the multiplication step is executed. The last iterate, mapped back to the basis of the matrix, is
+ * stored as approximation of the eigenvector.
+ *
+ * The iterates are stored in the workspace AbstractPowerMethod::_x and AbstractPowerMethod::_x_mul, and the
+ * multiplication step writes in place, so that after the first iteration the loop does not allocate memory.
+ *
+ * The iterate is not normalized before the multiplication step: since the step is linear, the result is divided by the
+ * norm of the iterate afterwards, in the same pass that computes its norm and the Rayleigh quotient
+ * (IterationKernels::ScaleNormDot). The two vectors are then swapped, so that each iteration reads the vectors twice
+ * and writes once after the multiplication step, instead of reading them five times. The stored vectors have norm
+ * close to the largest eigenvalue of the iterated matrix, so that they neither overflow nor underflow.
+ *
+ * If the degree of the Chebyshev filter is positive, the damped interval is estimated from Lanczos steps started from
+ * the initial vector (ChebyshevFilter::Estimate). If the estimate fails, for instance because the initial vector is an
+ * eigenvector, the iterations are not filtered. Otherwise the initial vector and each product are filtered before the
+ * multiplication step that gives the Rayleigh quotient, and the iterate is then divided by its actual norm.
+ *
+ * With the acceleration <tt>aitken</tt>, the stopping criterion and the returned eigenvalue use the extrapolated
+ * sequence
+ * \f[ \hat\lambda^{(k)} = \lambda^{(k)} - \frac{(\Delta\lambda^{(k)})^2}{\Delta\lambda^{(k)} - \Delta\lambda^{(k-1)}},
+ * \qquad \Delta\lambda^{(k)} = \lambda^{(k)} - \lambda^{(k-1)}, \f]
+ * which is exact for sequences converging geometrically. It is used only when the differences decrease; otherwise the
+ * criterion falls back to the one of the plain iteration. The iterations saved are estimated from the last ratio
+ * \f$q = \Delta\lambda^{(k)} / \Delta\lambda^{(k-1)}\f$, as the number of iterations needed by the plain sequence to
+ * reduce \f$|\Delta\lambda^{(k)}|\f$ below the tolerance.
+ *
+ * With the acceleration <tt>momentum</tt>, the iterates satisfy the heavy-ball recurrence
+ * \f$x^{(k+1)} = Mx^{(k)} - \beta x^{(k-1)}\f$, with \f$\beta = \lambda_2^2 / 4\f$, and \f$x^{(k+1)}\f$ and
+ * \f$x^{(k)}\f$ are divided by the same factor, so that the recurrence is preserved. If no estimate of \f$|\lambda_2|\f$
+ * is set, it is the second largest magnitude Ritz value of \f$\min(n, 20)\f$ Lanczos steps on \f$M\f$
+ * (ChebyshevFilter::RitzValues), which underestimates it. The Chebyshev filter is not applied. The iterations saved
+ * are estimated assuming that the Rayleigh quotient of the plain iteration converges with ratio
+ * \f$(\lambda_2 / \lambda_1)^2\f$, as for symmetric or Hermitian matrices, from the residual of the first iteration,
+ * which is the same for the two iterations.
  *
  * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
  * <tt>Reached maximum number of iterations</tt>
@@ -73,43 +234,135 @@ void AbstractPowerMethod<T>::SetInitVec(const Eigen::Matrix<T, -1, 1> &x0) {
 template <typename T>
 Eigen::Vector<std::complex<double>, -1> AbstractPowerMethod<T>::ComputeEigs() {
     // Initializing the necessary variables
-    Eigen::Vector<T, -1> x; // Vector before the multiplication step
-    Eigen::Vector<T, -1> x_mul; // Vector after the multiplication step
     int it; // Number of iterations
     T lambda; // Current approximation of the eigenvalue
     T lambda_prev; // Approximation of the eigenvalue at the previous iteration
+    T estimate; // Approximation of the eigenvalue used in the stopping criterion, extrapolated for aitken
+    T difference_prev = 0; // Difference of the approximations at the previous iteration, for aitken
     double res; // Residual
+    double first_res = 0; // Residual of the first iteration of the loop, for momentum
+    double ratio = 1; // Ratio of the last two differences of the approximations, for aitken
+    double norm = 1; // Norm of the vector before the multiplication step
+    double norm2; // Squared norm of the vector after the multiplication step
+    bool aitken = _acceleration == "aitken";
+    bool momentum = _acceleration == "momentum";
+
+    // Multiplication step counting the products
+    _products = 0;
+    _iterations_saved = 0;
+    typename ChebyshevFilter<T>::Operator multiply = [this](const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+        Multiply(x, y);
+        _products++;
+    };
 
     // First iteration outside the loop, necessary for having an initial approximation of lambda.
-    x = _x0 / _x0.norm();
-    x_mul = Multiply(x);
-    lambda = x.adjoint() * x_mul;
+    _x = StartingVector();
+    _x /= _x.norm();
+    _x_mul.resize(_x.size());
+    bool filter = !momentum && _filter.GetDegree() > 0
+                  && _filter.Estimate(multiply, _x, std::min(int(_x.size()), 20), 1);
+    if (filter) {
+        _filter.Apply(multiply, _x, _x_mul);
+        _x.swap(_x_mul);
+        _x /= _x.norm();
+    }
+
+    // Coefficient of the momentum, from the estimate of the second largest magnitude eigenvalue of the iterated matrix
+    double second = _second_eigenvalue;
+    double beta = 0;
+    if (momentum) {
+        if (second == 0) {
+            double lower_bound, upper_bound;
+            Eigen::VectorXd theta = ChebyshevFilter<T>::RitzValues(multiply, _x, std::min(int(_x.size()), 20),
+                                                                    lower_bound, upper_bound);
+            if (theta.size() > 1) {
+                theta = theta.cwiseAbs();
+                std::sort(theta.data(), theta.data() + theta.size(), std::greater<double>());
+                second = theta[1];
+            }
+        }
+        beta = second * second / 4;
+        _x_prev.setZero(_x.size());
+    }
+
+    multiply(_x, _x_mul);
+    lambda = IterationKernels<T>::ScaleNormDot(_x.data(), _x_mul.data(), _x.size(), 1, norm2);
+    estimate = lambda;
 
     // Setting iterations to 1 and residual such that the algorithm is not stopped
     it = 1;
     res = (this->_tol + 1) * std::abs(lambda);
 
     // Loop
-    while ((res > this->_tol * std::abs(lambda)) && (it < this->_maxit)) {
-        // Normalization and multiplication step
-        x = x_mul / x_mul.norm();
-        x_mul = Multiply(x);
-        // Computing the approximation of the eigenvalue
+    while ((res > this->_tol * std::abs(estimate)) && (it < this->_maxit)) {
         lambda_prev = lambda;
-        lambda = x.adjoint() * x_mul;
-        // Computing the residual and updating the iteration
-        res = std::abs(lambda - lambda_prev);
+        if (momentum) {
+            // Heavy-ball step from the normalized iterate: the product is not scaled, and the previous iterate is
+            // divided by the same factor as the new one.
+            _x_mul -= beta * _x_prev;
+            norm = _x_mul.norm();
+            _x_prev.swap(_x);
+            _x_prev /= norm;
+            _x.swap(_x_mul);
+            _x /= norm;
+            multiply(_x, _x_mul);
+            lambda = IterationKernels<T>::ScaleNormDot(_x.data(), _x_mul.data(), _x.size(), 1, norm2);
+        }
+        else {
+            // The vector after the multiplication step becomes the next iterate without being normalized: its norm is
+            // divided out of the next product in the fused pass.
+            _x.swap(_x_mul);
+            norm = std::sqrt(norm2);
+            if (filter) {
+                // Damping the unwanted eigenvalues before the Rayleigh quotient
+                _filter.Apply(multiply, _x, _x_mul);
+                _x.swap(_x_mul);
+                norm = _x.norm();
+            }
+            multiply(_x, _x_mul);
+            // Scaling the product, computing its norm and the approximation of the eigenvalue in a single pass
+            lambda = IterationKernels<T>::ScaleNormDot(_x.data(), _x_mul.data(), _x.size(), 1 / norm, norm2) / norm;
+        }
         it++;
+
+        // Computing the residual, on the extrapolated sequence for aitken
+        T difference = lambda - lambda_prev;
+        res = std::abs(difference);
+        if (it == 2) {
+            first_res = res;
+        }
+        ratio = (it > 2 && difference_prev != T(0)) ? std::abs(difference / difference_prev) : 1;
+        T estimate_prev = estimate;
+        estimate = lambda;
+        if (aitken && ratio < 1) {
+            estimate = lambda - difference * difference / (difference - difference_prev);
+            res = std::abs(estimate - estimate_prev);
+        }
+        difference_prev = difference;
     }
 
     // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    this->_it = it;
     if (it == this->_maxit){
         throw(ConvergenceError("Reached maximum number of iterations"));
     }
 
-    // Returning the eigenvalue
+    // Estimating the iterations needed by the plain iteration from its ratio of convergence
+    double tol = this->_tol * std::abs(estimate);
+    if (aitken && std::abs(difference_prev) > tol && ratio > 0 && ratio < 1) {
+        _iterations_saved = int(std::ceil(std::log(tol / std::abs(difference_prev)) / std::log(ratio)));
+    }
+    if (momentum && first_res > tol && second > 0 && second < std::abs(lambda)) {
+        double ratio = std::pow(second / std::abs(lambda), 2);
+        int plain = 2 + int(std::ceil(std::log(tol / first_res) / std::log(ratio)));
+        _iterations_saved = std::max(0, plain - it);
+    }
+
+    // Storing the eigenvector and returning the eigenvalue
+    _v = BackTransform(_x);
+    _v = _v / _v.norm();
     Eigen::Vector<std::complex<double>, 1> eigs;
-    eigs[0] = _return(lambda);
+    eigs[0] = _return(estimate);
     return eigs;
 }
 
@@ -1,7 +1,9 @@
 #ifndef ABSTRACTPOWERMETHOD_H_
 #define ABSTRACTPOWERMETHOD_H_
 
+#include <type_traits>
 #include "AbstractEigs.h"
+#include "ChebyshevFilter.h"
 
 /** @class AbstractPowerMethod
  * @brief Abstract class for computing eigenvalues of general matrices using the power method scheme.
@@ -37,8 +39,41 @@
  *  differs is just the multiplication step, i.e. the computation of \f$Mx^{(k)}\f$ where \f$M = A \f$ for the Power
  *  Method, \f$M = A^{-1} \f$ for the Inverse Power Method, \f$M = (A - \sigma I)\f$ for the Power Method with shift and
  *  \f$M = (A - \sigma I)^{-1}\f$ for the Inverse Power Method with shift. Therefore, this class exploits the pure
- *  virtual protected method AbstractPowerMethod::Multiply(const Eigen::Vector<T,-1> &x) to implement the general Power Method scheme. The
+ *  virtual protected method AbstractPowerMethod::Multiply(const Eigen::Vector<T,-1> &x, Eigen::Vector<T,-1> &y) to implement the general Power Method scheme. The
  *  specific method is distinguished by the definition of the Multiply method in the corresponding derived class.
+ *
+ *  The multiplication step writes its result in a vector of the workspace of the solver, which is allocated by the
+ *  first call of ComputeEigs() and then reused: apart from the first iteration, the iterations do not allocate memory.
+ *
+ *  Since the scheme only needs the multiplication step, PowerMethod and ShiftPowerMethod can iterate on a
+ *  LinearOperator that is never stored as a matrix: the memory cost of the iterations is then \f$O(n)\f$.
+ *
+ *  For complex dense matrices, AbstractPowerMethod::SetPlanar selects the planar layout: the matrix of PowerMethod and
+ *  ShiftPowerMethod is copied in planar layout (PlanarMatrix) and the inverse methods factorize with the strategy
+ *  <tt>planarlu</tt> (PlanarLU), so that the iterations use real arithmetic on the separate real and imaginary parts.
+ *
+ *  When the eigenvalues of the iterated matrix \f$M\f$ are real and the ratio \f$|\lambda_2 / \lambda_1|\f$ is close
+ *  to one, AbstractPowerMethod::SetFilterDegree adds a Chebyshev filter stage (ChebyshevFilter) built on the
+ *  multiplication step: before each Rayleigh quotient the iterate is multiplied by a Chebyshev polynomial of \f$M\f$ of
+ *  the given degree, which damps the interval of the unwanted eigenvalues. The interval is estimated once per call of
+ *  ComputeEigs() from \f$\min(n, 20)\f$ Lanczos steps on \f$M\f$. Each iteration then costs the degree plus one
+ *  multiplication steps, but the number of iterations is much smaller.
+ *
+ *  AbstractPowerMethod::SetAcceleration selects an accelerator that does not change the multiplication step:
+ *  - <tt>none</tt> (default): the plain iteration;
+ *  - <tt>aitken</tt>: Aitken's \f$\Delta^2\f$ extrapolation of the sequence \f$\lambda^{(k)}\f$, which removes the
+ *  leading geometric term of its error, so that the extrapolated eigenvalue reaches the tolerance in fewer iterations.
+ *  The returned eigenvector is the last iterate, which is not extrapolated;
+ *  - <tt>momentum</tt>: the heavy-ball power iteration \f$x^{(k+1)} = Mx^{(k)} - \beta x^{(k-1)}\f$ with
+ *  \f$\beta = \lambda_2^2 / 4\f$, whose ratio of convergence is about
+ *  \f$(|\lambda_2| / |\lambda_1|) / (1 + \sqrt{1 - \lambda_2^2 / \lambda_1^2})\f$, so that the number of iterations
+ *  grows with the inverse of the square root of the gap instead of the inverse of the gap. It assumes that the
+ *  eigenvalues of \f$M\f$ are real, and needs an estimate of the magnitude \f$|\lambda_2|\f$ of the second largest
+ *  magnitude eigenvalue of \f$M\f$, set with AbstractPowerMethod::SetSecondEigenvalue or estimated from a few Lanczos
+ *  steps. An underestimate only slows down the convergence, while \f$|\lambda_2| \geq |\lambda_1|\f$ prevents it.
+ *
+ *  The number of iterations saved with respect to the plain iteration is estimated by
+ *  AbstractPowerMethod::GetIterationsSaved.
  */
 
 template <typename T> class AbstractPowerMethod : public AbstractEigs<T>{
@@ -60,11 +95,44 @@ public:
     AbstractPowerMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int maxit,
                         const Eigen::Matrix<T,-1,1> &x0);
 
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A);
+
+    /**
+     * @brief Constructor; sets the given sparse matrix, tolerance, maximum number of iterations and initial vector.
+     * @param A Square sparse matrix whose eigenvalues are to be computed.
+     * @param tol Tolerance to be used in the stopping criterion of the method.
+     * @param maxit Maximum number of iterations for which the method is to be executed.
+     * @param x0 Initial vector for the iterations of the method.
+     */
+    AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int maxit,
+                        const Eigen::Matrix<T,-1,1> &x0);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    AbstractPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A);
+
+    /**
+     * @brief Constructor; sets the given linear operator, tolerance, maximum number of iterations and initial vector.
+     * @param A Linear operator whose eigenvalues are to be computed.
+     * @param tol Tolerance to be used in the stopping criterion of the method.
+     * @param maxit Maximum number of iterations for which the method is to be executed.
+     * @param x0 Initial vector for the iterations of the method.
+     */
+    AbstractPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int maxit,
+                        const Eigen::Matrix<T,-1,1> &x0);
+
     /**
      * @brief Constructor; sets the parameters of the method from a map.
      * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
      * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
-     * with <tt>maxit</tt> and the initial vector with <tt>x0</tt>.
+     * with <tt>maxit</tt> and the initial vector with <tt>x0</tt>. The planar layout is selected if the key
+     * <tt>planar</tt> is associated with a nonzero value. The degree of the Chebyshev filter is associated with
+     * <tt>filter</tt>, the name of the accelerator, as <tt>std::string</tt>, with <tt>acceleration</tt> and the estimate
+     * of the second eigenvalue with <tt>lambda2</tt>.
      */
     AbstractPowerMethod(std::map<std::string, std::any> &map);
 
@@ -82,6 +150,72 @@ public:
      */
     Eigen::Vector<T,-1> GetInitVec() {return _x0;};
 
+    /**
+     * @brief Returns the approximation of the eigenvector computed by the last call of ComputeEigs().
+     * @details The vector is normalized and expressed in the basis of the matrix \f$A\f$, even if the iterations are
+     * executed on the balanced matrix or on a similar matrix.
+     */
+    Eigen::Vector<T,-1> GetEigenvector() {return _v;};
+
+    /**
+     * @brief Sets whether dense complex matrices are stored in planar layout during the iterations.
+     * @param planar True to store the real and the imaginary parts in separate arrays. It has no effect on real,
+     * sparse or matrix-free problems, and on the Hessenberg factorization of ShiftInvPowerMethod.
+     */
+    void SetPlanar(const bool &planar) {_planar = planar;};
+
+    /**
+     * @brief Returns true if the planar layout is selected.
+     */
+    bool IsPlanar() {return _planar;};
+
+    /**
+     * @brief Sets the degree of the Chebyshev filter applied before each Rayleigh quotient.
+     * @param degree Degree of the polynomial; zero (default) disables the filter. The filter assumes that the
+     * iterated matrix is symmetric or Hermitian.
+     */
+    void SetFilterDegree(const int &degree) {_filter.SetDegree(degree);};
+
+    /**
+     * @brief Returns the degree of the Chebyshev filter.
+     */
+    int GetFilterDegree() {return _filter.GetDegree();};
+
+    /**
+     * @brief Returns the number of multiplication steps executed by the last call of ComputeEigs(), including the
+     * ones of the Chebyshev filter and of the estimate of its interval.
+     */
+    int GetProducts() {return _products;};
+
+    /**
+     * @brief Sets the accelerator of the iterations.
+     * @param acceleration Name of the accelerator: <tt>none</tt> (default), <tt>aitken</tt> or <tt>momentum</tt>.
+     */
+    void SetAcceleration(const std::string &acceleration);
+
+    /**
+     * @brief Returns the name of the accelerator of the iterations.
+     */
+    std::string GetAcceleration() {return _acceleration;};
+
+    /**
+     * @brief Sets the estimate of the magnitude of the second largest magnitude eigenvalue of the iterated matrix,
+     * used by the accelerator <tt>momentum</tt>.
+     * @param second Nonnegative estimate of \f$|\lambda_2|\f$; zero (default) estimates it from a few Lanczos steps.
+     */
+    void SetSecondEigenvalue(const double &second);
+
+    /**
+     * @brief Returns the estimate of the magnitude of the second largest magnitude eigenvalue set by the user.
+     */
+    double GetSecondEigenvalue() {return _second_eigenvalue;};
+
+    /**
+     * @brief Returns the estimated number of iterations saved by the accelerator in the last call of ComputeEigs(),
+     * with respect to the plain iteration.
+     */
+    int GetIterationsSaved() {return _iterations_saved;};
+
     /**
      * @brief Returns the eigenvalues computed according to the method.
      * @return Vector of complex numbers containing the eigenvalues computed according to one of the schemes of the
@@ -97,12 +231,73 @@ protected:
      * */
     Eigen::Vector<T,-1> _x0;
 
+    /** @brief Eigenvector.
+     * @details Approximation of the eigenvector computed by the last call of ComputeEigs().
+     * */
+    Eigen::Vector<T,-1> _v;
+
+    /** @brief True if dense matrices are stored in planar layout during the iterations. */
+    bool _planar = false;
+
+    /** @brief Chebyshev filter applied before each Rayleigh quotient, disabled by default. */
+    ChebyshevFilter<T> _filter;
+
+    /** @brief Number of multiplication steps executed by the last call of ComputeEigs(). */
+    int _products = 0;
+
+    /** @brief Name of the accelerator of the iterations. Default value: <tt>none</tt>. */
+    std::string _acceleration = "none";
+
+    /** @brief Estimate of the magnitude of the second eigenvalue of the iterated matrix, zero if not set. */
+    double _second_eigenvalue = 0;
+
+    /** @brief Estimated number of iterations saved by the accelerator in the last call of ComputeEigs(). */
+    int _iterations_saved = 0;
+
+    /** @brief Workspace storing the previous iterate, for the accelerator <tt>momentum</tt>. */
+    Eigen::Vector<T,-1> _x_prev;
+
+    /**
+     * @brief Returns true if the planar layout is selected and the matrix is dense and complex.
+     */
+    bool UsePlanarLayout() const {
+        return _planar && !this->_sparse && !this->_operator && std::is_same<T, std::complex<double>>::value;
+    };
+
+    /** @brief Workspace storing the vector before the multiplication step.
+     * @details The vectors of the iterations are stored in members of the solver, allocated by the first call of
+     * ComputeEigs() and reused by the following calls, so that the iterations do not allocate memory.
+     * */
+    Eigen::Vector<T,-1> _x;
+
+    /** @brief Workspace storing the vector after the multiplication step. */
+    Eigen::Vector<T,-1> _x_mul;
+
     /**
      * Protected pure virtual method to execute the multiplication step according to the method.
      * @param x vector to be multiplied.
-     * @return Result of the multiplication step.
+     * @param y result of the multiplication step, with the same size of \f$x\f$. It is distinct from \f$x\f$ and it
+     * has to be overwritten without allocating memory.
+     */
+    virtual void Multiply(const Eigen::Vector<T,-1> &x, Eigen::Vector<T,-1> &y) = 0;
+
+    /**
+     * Protected virtual method returning the vector from which the iterations start.
+     * @return The initial vector, expressed in the basis in which the multiplication step is executed.
+     * @details By default it returns the initial vector AbstractPowerMethod::_x0, mapped to \f$D^{-1}P^Tx^{(0)}\f$ if
+     * the matrix is balanced. Derived classes that iterate on a matrix similar to \f$A\f$ override it to map the
+     * initial vector in the corresponding basis.
+     */
+    virtual Eigen::Vector<T,-1> StartingVector();
+
+    /**
+     * Protected virtual method mapping a vector back to the basis of the matrix \f$A\f$.
+     * @param x vector expressed in the basis in which the multiplication step is executed.
+     * @return The vector expressed in the basis of \f$A\f$.
+     * @details By default it maps \f$x\f$ to \f$PDx\f$ if the matrix is balanced. Derived classes that override
+     * AbstractPowerMethod::StartingVector override also this method with the inverse mapping.
      */
-    virtual Eigen::Vector<T,-1> Multiply(const Eigen::Vector<T,-1> &x) = 0;
+    virtual Eigen::Vector<T,-1> BackTransform(const Eigen::Vector<T,-1> &x);
 
     /**
      * Protected pure virtual method to return the eigenvalue of the matrix _A.
@@ -0,0 +1,319 @@
+#include "ArnoldiMethod.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// CONSTRUCTORS
+/**
+ * @details At least the matrix has to be provided. If the number of eigenvalues is not provided, only the largest
+ * magnitude eigenvalue is computed and a warning is given to the user. If the subspace size, the selection rule or the
+ * shift are not provided, they are set to the default value. If the tolerance or the maximum number of iterations are
+ * not provided, they are set to the default value and a warning is given to the user.
+ */
+template <typename T>
+ArnoldiMethod<T>::ArnoldiMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+    // Getting and setting the number of eigenvalues
+    if (map.count("neigs") > 0) {
+        double neigs;
+        try {
+            neigs = std::any_cast<double>(map["neigs"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the number of eigenvalues to double"));
+        }
+        SetNumEigs(int(neigs));
+    }
+    else { // map.count("neigs") == 0
+        std::cerr << "WARNING: Unspecified number of eigenvalues (neigs). Set by default neigs = 1" << std::endl;
+    }
+
+    // Getting and setting the subspace size
+    if (map.count("subspace") > 0) {
+        double subspace_size;
+        try {
+            subspace_size = std::any_cast<double>(map["subspace"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the subspace size to double"));
+        }
+        SetSubspaceSize(int(subspace_size));
+    }
+
+    // Getting and setting the selection rule
+    if (map.count("selection") > 0) {
+        std::string selection;
+        try {
+            selection = std::any_cast<std::string>(map["selection"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the selection to string"));
+        }
+        SetSelection(selection);
+    }
+
+    // Getting and setting the shift
+    if (map.count("shift") > 0) {
+        try {
+            SetShift(std::any_cast<T>(map["shift"]));
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the shift to the expected type"));
+        }
+    }
+}
+
+// SETTING METHODS
+/**
+ * @details If the number of eigenvalues is not between one and the size of the matrix, it throws an exception of type
+ * InitializationError with message: <tt>Attempting to set a number of eigenvalues out of range</tt>. If a subspace size
+ * too small for the new number of eigenvalues was set, it is reset to the default one.
+ */
+template <typename T>
+void ArnoldiMethod<T>::SetNumEigs(const int &neigs) {
+    if (neigs <= 0 || neigs > this->GetSize()) {
+        throw(InitializationError("Attempting to set a number of eigenvalues out of range"));
+    }
+    _neigs = neigs;
+    if (_subspace_size < std::min(_neigs + 2, this->GetSize())) {
+        _subspace_size = 0;
+    }
+}
+
+/**
+ * @details Two more vectors than the number of eigenvalues are needed to restart with at least one shift, also when
+ * the last wanted Ritz value is the first of a pair of complex conjugate ones. If the subspace size is smaller than the
+ * number of eigenvalues plus two, unless it is the size of the matrix, or larger than the size of the matrix, it throws
+ * an exception of type InitializationError with message: <tt>Attempting to set a subspace size out of range</tt>.
+ */
+template <typename T>
+void ArnoldiMethod<T>::SetSubspaceSize(const int &subspace_size) {
+    if (subspace_size < std::min(_neigs + 2, this->GetSize()) || subspace_size > this->GetSize()) {
+        throw(InitializationError("Attempting to set a subspace size out of range"));
+    }
+    _subspace_size = subspace_size;
+}
+
+/**
+ * @details If the rule is not one of <tt>magnitude</tt>, <tt>real</tt> and <tt>shift</tt>, it throws an exception of
+ * type InitializationError with message: <tt>Unknown selection rule</tt>.
+ */
+template <typename T>
+void ArnoldiMethod<T>::SetSelection(const std::string &selection) {
+    if (selection != "magnitude" && selection != "real" && selection != "shift") {
+        throw(InitializationError("Unknown selection rule"));
+    }
+    _selection = selection;
+}
+
+// APPLICATION OF THE OPERATOR
+template <typename T>
+void ArnoldiMethod<T>::Apply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+    _products++;
+    if (_selection != "shift") {
+        this->ApplyMatrix(x, y);
+    }
+    else if (this->_sparse) {
+        _sparse_factorization.Solve(x, y);
+    }
+    else {
+        _factorization->Solve(x, y);
+    }
+}
+
+// ARNOLDI FACTORIZATION
+/**
+ * @details The new vector is orthogonalized with the classical Gram-Schmidt process, which uses matrix-vector products
+ * with the basis, and the orthogonalization is repeated once if the norm of the vector is reduced by more than a factor
+ * \f$1/\sqrt{2}\f$ (DGKS correction).
+ */
+template <typename T>
+void ArnoldiMethod<T>::Extend(Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<T, -1, -1> &H, const int &j) {
+    int n = V.rows();
+    int m = H.cols();
+    Eigen::Vector<T, -1> v(n), w(n), h, c;
+    for (int i = j; i < m; i++) {
+        v = V.col(i);
+        Apply(v, w);
+        double norm = w.norm();
+
+        // Classical Gram-Schmidt with one reorthogonalization if needed
+        h.noalias() = V.leftCols(i + 1).adjoint() * w;
+        w.noalias() -= V.leftCols(i + 1) * h;
+        if (w.norm() < M_SQRT1_2 * norm) {
+            c.noalias() = V.leftCols(i + 1).adjoint() * w;
+            w.noalias() -= V.leftCols(i + 1) * c;
+            h += c;
+        }
+        H.col(i).head(i + 1) = h;
+        H.col(i).tail(m - i).setZero();
+        Continue(V, H, i, w, std::max(norm, h.norm()));
+    }
+}
+
+/**
+ * @details If the norm of the residual is negligible with respect to the given scale, the Krylov subspace is
+ * invariant: the subdiagonal entry of \f$H\f$ is set to zero and the basis is continued with a pseudo-random vector,
+ * orthogonalized twice against it.
+ */
+template <typename T>
+void ArnoldiMethod<T>::Continue(Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<T, -1, -1> &H, const int &i,
+                                Eigen::Vector<T, -1> &f, const double &scale) {
+    double beta = f.norm();
+    if (beta > std::numeric_limits<double>::epsilon() * scale) {
+        H(i + 1, i) = beta;
+        V.col(i + 1) = f / beta;
+        return;
+    }
+    H(i + 1, i) = 0;
+    f = this->RandomBlock(V.rows(), i + 2).col(i + 1);
+    for (int pass = 0; pass < 2; pass++) {
+        f -= V.leftCols(i + 1) * (V.leftCols(i + 1).adjoint() * f);
+    }
+    V.col(i + 1) = f.normalized();
+}
+
+// Conversion of a Ritz value to the scalar type of the matrix; for real matrices only the real part is used.
+static void ToScalar(const std::complex<double> &theta, double &mu) {mu = theta.real();}
+static void ToScalar(const std::complex<double> &theta, std::complex<double> &mu) {mu = theta;}
+
+// COMPUTATION OF EIGENVALUES
+/**
+ * @details The method starts from the normalized pseudo-random vector given by AbstractEigs::RandomBlock. After each
+ * extension of the factorization to size \f$m\f$, the Ritz pairs of \f$H_m\f$ are sorted according to the selection
+ * rule and the first \f$k\f$ are tested for convergence with the residual estimate \f$||f_m|| |e_m^Tz_i|\f$. To allow
+ * zero eigenvalues, the tolerance is relative to \f$\max(|\theta_i|, \epsilon_m^{2/3} |\theta_1|)\f$, where
+ * \f$\epsilon_m\f$ is the machine precision.
+ *
+ * At each restart \f$k' \geq k\f$ vectors are kept, where \f$k'\f$ is increased by half of the number of converged
+ * Ritz pairs, as in ARPACK, to avoid the stagnation of the method when the wanted Ritz values are close to the unwanted
+ * ones. Each shift \f$\mu\f$ is applied as an explicit QR step on the small matrix, \f$H - \mu I = QR\f$ and
+ * \f$H \leftarrow Q^*HQ\f$; a pair of complex conjugate shifts of a real matrix is applied at once factorizing
+ * \f$H^2 - 2Re(\mu)H + |\mu|^2I\f$, which is real. The entries below the subdiagonal created by rounding are set to
+ * zero. Given the accumulated orthogonal matrix \f$Q\f$, the truncated factorization is
+ * \f[ AV_mQ_{k'} = V_mQ_{k'}H_{k'} + (V_mQe_{k'+1}h_{k'+1,k'} + f_mq_{m,k'})e_{k'}^T. \f]
+ *
+ * If the selection rule is <tt>shift</tt>, it throws an exception of type InitializationError for linear operators,
+ * and the eigenvalues \f$\mu\f$ of \f$(A - \sigma I)^{-1}\f$ are mapped back to \f$\lambda = \sigma + 1/\mu\f$.
+ *
+ * If the maximum number of iteration is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> ArnoldiMethod<T>::ComputeEigs() {
+    typedef Eigen::Matrix<T, -1, -1> Matrix;
+    int n = this->GetSize();
+    int k = _neigs;
+    int m = GetSubspaceSize();
+    double eps = std::pow(std::numeric_limits<double>::epsilon(), 2.0 / 3);
+    _products = 0;
+
+    // Factorization of the shifted matrix
+    if (_selection == "shift") {
+        this->CheckStored();
+        if (this->_sparse) {
+            if (!_sparse_factorization.IsAnalyzed()) {
+                _sparse_factorization.Analyze(this->_A_sparse);
+            }
+            _sparse_factorization.Factorize(_shift);
+        }
+        else {
+            _factorization = _cache->Factorize(this->WorkMatrix(), _shift, "auto");
+        }
+    }
+    typename RitzPairs<T>::Order order =
+            (_selection == "real") ? RitzPairs<T>::LARGEST_REAL : RitzPairs<T>::LARGEST_MAGNITUDE;
+
+    // Arnoldi factorization of size m, with the basis in the first m columns of V and f = V(:, m) * H(m, m - 1)
+    Matrix V(n, m + 1), H = Matrix::Zero(m + 1, m), Hm, Q, M, X;
+    V.col(0) = this->RandomBlock(n, 1).normalized();
+    RitzPairs<T> ritz;
+    int j = 0; // Current size of the factorization
+    int converged = 0; // Number of converged Ritz pairs
+    int it = 0;
+
+    while (true) {
+        Extend(V, H, j);
+        it++;
+
+        // Ritz pairs and their residual estimates
+        Hm = H.topLeftCorner(m, m);
+        ritz.Compute(Hm, order);
+        const Eigen::Vector<std::complex<double>, -1> &theta = ritz.GetValues();
+        const Matrix &Z = ritz.GetVectors();
+        Matrix last = std::abs(H(m, m - 1)) * Z.row(m - 1);
+        double threshold = eps * std::abs(theta[0]);
+        converged = 0;
+        for (int i = 0; i < k; i += std::max(ritz.GetUnit(i), 1)) {
+            double res = ritz.Norm(last, i);
+            if (res <= this->_tol * std::max(std::abs(theta[i]), threshold) * ritz.Norm(Z, i)) {
+                converged += std::max(ritz.GetUnit(i), 1);
+            }
+        }
+        if (converged >= k || it == this->_maxit) {
+            break;
+        }
+
+        // Number of kept vectors, without splitting a pair of complex conjugate Ritz values
+        int kept = ritz.Cover(k);
+        kept = ritz.Cover(kept + std::min(converged, (m - kept) / 2));
+        if (kept >= m) {
+            kept = ritz.Cover(k);
+        }
+
+        // Exact shifts with the unwanted Ritz values
+        Q = Matrix::Identity(m, m);
+        for (int i = kept; i < m; i++) {
+            if (ritz.GetUnit(i) == 0) {
+                continue;
+            }
+            T mu;
+            ToScalar(theta[i], mu);
+            M = Hm;
+            M.diagonal().array() -= mu;
+            if (ritz.GetUnit(i) == 2) {
+                M = Hm * Hm;
+                M.noalias() -= 2 * theta[i].real() * Hm;
+                M.diagonal().array() += std::norm(theta[i]);
+            }
+            Eigen::HouseholderQR<Matrix> qr(M);
+            Matrix Qi = qr.householderQ();
+            Hm = Qi.adjoint() * Hm * Qi;
+            Q = Q * Qi;
+            for (int col = 0; col < m - 2; col++) {
+                Hm.col(col).tail(m - col - 2).setZero();
+            }
+        }
+
+        // Truncation of the factorization to size kept
+        Eigen::Vector<T, -1> f = V.col(m) * (H(m, m - 1) * Q(m - 1, kept - 1));
+        f.noalias() += (V.leftCols(m) * Q.col(kept)) * Hm(kept, kept - 1);
+        X.noalias() = V.leftCols(m) * Q.leftCols(kept);
+        V.leftCols(kept) = X;
+        H.setZero();
+        H.topLeftCorner(kept, kept) = Hm.topLeftCorner(kept, kept);
+        Continue(V, H, kept - 1, f, Hm.norm());
+        j = kept;
+    }
+
+    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    this->_it = it;
+    if (converged < k){
+        throw(ConvergenceError("Reached maximum number of iterations"));
+    }
+
+    // Storing the eigenvectors, mapped back to the basis of A
+    X.noalias() = V.leftCols(m) * ritz.GetVectors().leftCols(ritz.Cover(k));
+    if (this->_balance) {
+        this->_balancing.BackTransform(X);
+    }
+    _eigenvectors = ritz.ComplexVectors(X, k);
+    Eigen::Vector<std::complex<double>, -1> eigenvalues = ritz.GetValues().head(k);
+    if (_selection == "shift") {
+        eigenvalues = (std::complex<double>(_shift) + eigenvalues.array().inverse()).matrix();
+    }
+    return eigenvalues;
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class ArnoldiMethod<double>;
+template class ArnoldiMethod<std::complex<double>>;
@@ -0,0 +1,255 @@
+#ifndef ARNOLDIMETHOD_H_
+#define ARNOLDIMETHOD_H_
+
+#include "AbstractEigs.h"
+#include "DenseFactorization.h"
+#include "FactorizationCache.h"
+#include "RitzPairs.h"
+#include "SparseFactorization.h"
+
+/** @class ArnoldiMethod
+ * @brief Class for computing a few eigenvalues of large general matrices using the implicitly restarted Arnoldi method.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The Arnoldi method @cite GolubVanLoan builds an orthonormal basis \f$V_m = [v_1, \dots, v_m]\f$ of the
+ * Krylov subspace \f$\mathcal{K}_m(A, v_1) = span\{v_1, Av_1, \dots, A^{m-1}v_1\}\f$, together with the upper
+ * Hessenberg matrix \f$H_m = V_m^*AV_m\f$, such that
+ * \f[ AV_m = V_mH_m + f_me_m^T, \qquad V_m^*f_m = 0. \f]
+ * At each step the new vector \f$Av_j\f$ is orthogonalized against the previous ones with the classical Gram-Schmidt
+ * process, repeated once when cancellation is detected. The eigenpairs \f$(\theta_i, z_i)\f$ of \f$H_m\f$ are the Ritz
+ * pairs of \f$A\f$ in the subspace, and the residual of the Ritz vector \f$V_mz_i\f$ is \f$||f_m|| |e_m^Tz_i|\f$, which is
+ * computed without any product with \f$A\f$. The Ritz pair is converged if
+ * \f$||f_m|| |e_m^Tz_i| \leq \epsilon |\theta_i| ||z_i||\f$, where \f$\epsilon\f$ is a prescribed tolerance.
+ *
+ * The eigenvalues at the ends of the spectrum are well approximated by the Ritz values long before \f$m\f$ reaches
+ * \f$n\f$, but the memory and the orthogonalization cost grow with \f$m\f$. The implicitly restarted Arnoldi method
+ * @cite GolubVanLoan keeps \f$m\f$ fixed: when the \f$k\f$ wanted Ritz pairs are not converged, \f$m - k\f$ QR steps
+ * with the unwanted Ritz values as shifts (exact shifts) are applied to \f$H_m\f$, so that the first \f$k\f$ vectors of
+ * the transformed basis span the Krylov subspace of the filtered starting vector
+ * \f$\prod_j (A - \theta_jI)v_1\f$. The factorization is truncated to size \f$k\f$ without any product with \f$A\f$ and
+ * extended again to size \f$m\f$. Therefore the memory cost is \f$O(nm)\f$ and each restart costs \f$m - k\f$ products
+ * with \f$A\f$. For real matrices the pairs of complex conjugate shifts are applied together with a real double-shift
+ * step and the pairs of complex conjugate Ritz values are never split between the wanted and the unwanted ones.
+ *
+ * The wanted eigenvalues are chosen with ArnoldiMethod::SetSelection:
+ *  - <tt>magnitude</tt> (default): the \f$k\f$ eigenvalues of largest magnitude;
+ *  - <tt>real</tt>: the \f$k\f$ eigenvalues of largest real part;
+ *  - <tt>shift</tt>: the \f$k\f$ eigenvalues closest to the shift \f$\sigma\f$, set with ArnoldiMethod::SetShift.
+ *  The method is applied to \f$(A - \sigma I)^{-1}\f$, whose largest magnitude eigenvalues \f$\mu = 1/(\lambda-\sigma)\f$
+ *  correspond to the eigenvalues \f$\lambda\f$ of \f$A\f$ closest to \f$\sigma\f$ and are well separated from the rest
+ *  of the spectrum. As in ShiftInvPowerMethod, the shifted matrix is factorized once, with the strategy
+ *  <tt>auto</tt> of DenseFactorization if it is dense and with SparseFactorization if it is sparse, and each product
+ *  is the solution of two triangular systems. This selection is not supported for linear operators.
+ *
+ * The matrix can be given as a dense matrix, as a sparse matrix in compressed sparse row format or as a LinearOperator.
+ * The starting vector is pseudo-random, generated with a fixed seed so that the results are reproducible. The maximum
+ * number of iterations bounds the number of restarts. If it is reached the method is said to be non-convergent for the
+ * specific instance. The eigenvalues are returned in the order of the selection: descending magnitude, descending real
+ * part or ascending distance from the shift.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::SparseMatrix<double, Eigen::RowMajor> A = ...;
+    ArnoldiMethod<double> eigs_solver(A, 1e-10, 1000);
+    eigs_solver.SetNumEigs(10);
+    eigs_solver.SetSelection("shift");
+    eigs_solver.SetShift(0.5);
+    std::cout << "The ten eigenvalues of A closest to 0.5 are:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class ArnoldiMethod : public AbstractEigs<T>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     * @details By default the largest magnitude eigenvalue is computed.
+     */
+    ArnoldiMethod(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     * @details By default the largest magnitude eigenvalue is computed.
+     */
+    ArnoldiMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    ArnoldiMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+     */
+    ArnoldiMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    ArnoldiMethod(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+     */
+    ArnoldiMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the number of eigenvalues with <tt>neigs</tt>, the size of the subspace with
+     * <tt>subspace</tt>, the selection rule, as <tt>std::string</tt>, with <tt>selection</tt> and the shift with
+     * <tt>shift</tt>.
+     */
+    ArnoldiMethod(std::map<std::string, std::any> &map);
+
+    // Destructor
+    virtual ~ArnoldiMethod() override {};
+
+    /**
+     * @brief Sets the number of eigenvalues to be computed.
+     * @param neigs Number of eigenvalues to be computed.
+     */
+    void SetNumEigs(const int &neigs);
+
+    /**
+     * @brief Sets the maximum size of the Krylov subspace.
+     * @param subspace_size Number \f$m\f$ of vectors of the basis before each restart, at least the number of
+     * eigenvalues plus two, or the size of the matrix.
+     */
+    void SetSubspaceSize(const int &subspace_size);
+
+    /**
+     * @brief Sets the rule selecting the wanted eigenvalues.
+     * @param selection Name of the rule: <tt>magnitude</tt> (default), <tt>real</tt> or <tt>shift</tt>.
+     */
+    void SetSelection(const std::string &selection);
+
+    /**
+     * @brief Sets the shift used by the selection rule <tt>shift</tt>.
+     * @param shift Value \f$\sigma\f$ to which the wanted eigenvalues are closest.
+     */
+    void SetShift(const T &shift) {_shift = shift;};
+
+    /**
+     * @brief Returns the number of eigenvalues to be computed.
+     */
+    int GetNumEigs() {return _neigs;};
+
+    /**
+     * @brief Returns the maximum size of the Krylov subspace.
+     */
+    int GetSubspaceSize() {
+        return _subspace_size > 0 ? _subspace_size : std::min(this->GetSize(), std::max(2 * _neigs + 1, 20));
+    };
+
+    /**
+     * @brief Returns the rule selecting the wanted eigenvalues.
+     */
+    std::string GetSelection() {return _selection;};
+
+    /**
+     * @brief Returns the shift used by the selection rule <tt>shift</tt>.
+     */
+    T GetShift() {return _shift;};
+
+    /**
+     * @brief Returns the number of products with the matrix, or of solutions with the shifted matrix, executed by the
+     * last call of ComputeEigs().
+     */
+    int GetProducts() {return _products;};
+
+    /**
+     * @brief Returns the approximations of the eigenvectors computed by the last call of ComputeEigs().
+     * @details The columns are normalized and expressed in the basis of the matrix \f$A\f$, even if the iterations are
+     * executed on the balanced matrix. They are complex even for real matrices, whose eigenvectors can be complex.
+     */
+    Eigen::Matrix<std::complex<double>, -1, -1> GetEigenvectors() {return _eigenvectors;};
+
+    /**
+     * @brief Returns the eigenvalues computed using the implicitly restarted Arnoldi method.
+     * @return Vector of complex numbers containing the requested eigenvalues, in the order of the selection rule.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Number of eigenvalues to be computed.
+     * Default value: <tt>1</tt>.
+     */
+    int _neigs = 1;
+
+    /**
+     * @brief Maximum size of the Krylov subspace.
+     * @details If zero, the size is \f$\min(n, \max(2k + 1, 20))\f$, where \f$k\f$ is the number of eigenvalues.
+     * Default value: <tt>0</tt>.
+     */
+    int _subspace_size = 0;
+
+    /**
+     * @brief Rule selecting the wanted eigenvalues.
+     * Default value: <tt>magnitude</tt>.
+     */
+    std::string _selection = "magnitude";
+
+    /**
+     * @brief Shift used by the selection rule <tt>shift</tt>.
+     * Default value: <tt>0</tt>.
+     */
+    T _shift = 0;
+
+    /**
+     * @brief Number of products executed by the last call of ComputeEigs().
+     */
+    int _products = 0;
+
+    /**
+     * @brief Approximations of the eigenvectors computed by the last call of ComputeEigs().
+     */
+    Eigen::Matrix<std::complex<double>, -1, -1> _eigenvectors;
+
+    /**
+     * @brief Factorization of the shifted matrix, if it is dense and the selection rule is <tt>shift</tt>.
+     */
+    std::shared_ptr<const DenseFactorization<T>> _factorization;
+
+    /**
+     * @brief Cache of the factorizations of the shifted matrix, storing only the last factorization.
+     */
+    std::shared_ptr<FactorizationCache<T>> _cache = std::make_shared<FactorizationCache<T>>();
+
+    /**
+     * @brief Sparse factorization of the shifted matrix, if it is sparse and the selection rule is <tt>shift</tt>.
+     */
+    SparseFactorization<T> _sparse_factorization;
+
+    /**
+     * @brief Applies the operator of the method, \f$A\f$ or \f$(A - \sigma I)^{-1}\f$, to a vector.
+     * @param x Vector to be multiplied.
+     * @param y Result of the product, already of the size of x. It cannot be x.
+     */
+    void Apply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y);
+
+    /**
+     * @brief Extends the Arnoldi factorization from size \f$j\f$ to size \f$m\f$.
+     * @param V Matrix whose first \f$j+1\f$ columns are the orthonormal basis; on exit its \f$m+1\f$ columns.
+     * @param H Matrix of size \f$(m+1) \times m\f$ whose first \f$j\f$ columns are the Hessenberg matrix; on exit all
+     * its columns.
+     * @param j Current size of the factorization.
+     */
+    void Extend(Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<T, -1, -1> &H, const int &j);
+
+    /**
+     * @brief Normalizes the residual of the factorization of size \f$i+1\f$ into the next vector of the basis.
+     * @param V Orthonormal basis, whose column \f$i+1\f$ is set.
+     * @param H Hessenberg matrix, whose entry \f$(i+1, i)\f$ is set.
+     * @param i Index of the last column of the factorization.
+     * @param f Residual, orthogonal to the first \f$i+1\f$ columns of V; it is overwritten.
+     * @param scale Norm with which the norm of the residual is compared.
+     */
+    void Continue(Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<T, -1, -1> &H, const int &i, Eigen::Vector<T, -1> &f,
+                  const double &scale);
+};
+
+#endif //ARNOLDIMETHOD_H_
@@ -0,0 +1,134 @@
+#include "Balancing.h"
+#include <limits>
+#include <numeric>
+#include <utility>
+
+/**
+ * @details If the given matrix is non square, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to balance a non square matrix</tt>.
+ *
+ * In the scaling step, for each index \f$i\f$ of the diagonal block let \f$c\f$ and \f$r\f$ be the 1-norms of the
+ * off-diagonal parts of the column and of the row \f$i\f$ of the block. The scaling factor \f$f\f$ is the power of two
+ * such that \f$c f\f$ and \f$r / f\f$ are within a factor of two, and the column is multiplied by \f$f\f$ and the row
+ * divided by \f$f\f$ only if this reduces \f$c + r\f$ by at least 5%. The sweeps over the block are repeated until no
+ * scaling factor changes.
+ */
+template <typename T>
+void Balancing<T>::Compute(const Eigen::Matrix<T, -1, -1> &A) {
+    if (A.rows() != A.cols()) {
+        throw(InitializationError("Attempting to balance a non square matrix"));
+    }
+    int n = A.rows();
+    _B = A;
+    _scaling = Eigen::Vector<double, -1>::Ones(n);
+    _perm.resize(n);
+    std::iota(_perm.begin(), _perm.end(), 0);
+    _low = 0;
+    _high = n - 1;
+
+    // Permutation: rows isolating an eigenvalue are moved to the bottom
+    bool found = true;
+    while (found) {
+        found = false;
+        for (int j = _high; j >= _low; j--) {
+            bool isolated = true;
+            for (int k = _low; k <= _high && isolated; k++) {
+                isolated = (k == j || _B(j, k) == T(0));
+            }
+            if (isolated) {
+                Swap(j, _high);
+                _high--;
+                found = true;
+                break;
+            }
+        }
+    }
+    // Permutation: columns isolating an eigenvalue are moved to the top
+    found = true;
+    while (found) {
+        found = false;
+        for (int j = _low; j <= _high; j++) {
+            bool isolated = true;
+            for (int k = _low; k <= _high && isolated; k++) {
+                isolated = (k == j || _B(k, j) == T(0));
+            }
+            if (isolated) {
+                Swap(j, _low);
+                _low++;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    // Scaling of the remaining diagonal block by powers of two
+    const double radix = 2;
+    const double sfmin = std::numeric_limits<double>::min() / std::numeric_limits<double>::epsilon();
+    const double sfmax = 1 / sfmin;
+    bool converged = false;
+    while (!converged) {
+        converged = true;
+        for (int i = _low; i <= _high; i++) {
+            double c = 0, r = 0;
+            for (int k = _low; k <= _high; k++) {
+                if (k != i) {
+                    c += std::abs(_B(k, i));
+                    r += std::abs(_B(i, k));
+                }
+            }
+            if (c == 0 || r == 0) {
+                continue;
+            }
+            double s = c + r;
+            double f = 1;
+            double g = r / radix;
+            while (c < g && f < sfmax) {
+                f *= radix;
+                c *= radix * radix;
+            }
+            g = r * radix;
+            while (c >= g && f > sfmin) {
+                f /= radix;
+                c /= radix * radix;
+            }
+            if ((c + r) / f < 0.95 * s) {
+                _scaling(i) *= f;
+                _B.row(i) /= f;
+                _B.col(i) *= f;
+                converged = false;
+            }
+        }
+    }
+}
+
+template <typename T>
+void Balancing<T>::Apply(Eigen::Matrix<T, -1, -1> &X) const {
+    Eigen::Matrix<T, -1, -1> Y(X.rows(), X.cols());
+    for (int i = 0; i < X.rows(); i++) {
+        Y.row(i) = X.row(_perm[i]) / _scaling(i);
+    }
+    X = Y;
+}
+
+template <typename T>
+void Balancing<T>::BackTransform(Eigen::Matrix<T, -1, -1> &X) const {
+    Eigen::Matrix<T, -1, -1> Y(X.rows(), X.cols());
+    for (int i = 0; i < X.rows(); i++) {
+        Y.row(_perm[i]) = X.row(i) * _scaling(i);
+    }
+    X = Y;
+}
+
+template <typename T>
+void Balancing<T>::Swap(const int &i, const int &j) {
+    if (i == j) {
+        return;
+    }
+    _B.row(i).swap(_B.row(j));
+    _B.col(i).swap(_B.col(j));
+    std::swap(_perm[i], _perm[j]);
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class Balancing<double>;
+template class Balancing<std::complex<double>>;
@@ -0,0 +1,128 @@
+#ifndef BALANCING_H_
+#define BALANCING_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include <vector>
+#include "Exceptions.h"
+
+/** @class Balancing
+ * @brief Class for balancing a square matrix by a permutation and a diagonal similarity transformation.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details Matrices whose entries differ by many orders of magnitude have eigenvalues that are badly approximated and
+ * slowly converging iterations, since the errors of the methods are proportional to the norm of the matrix. The
+ * balancing algorithm of Parlett and Reinsch @cite GolubVanLoan computes a matrix
+ * \f$B = D^{-1} P^T A P D\f$, where \f$P\f$ is a permutation matrix and \f$D\f$ a diagonal matrix, that has the same
+ * eigenvalues of \f$A\f$ and usually a much smaller norm. It consists of two steps, as in the LAPACK routine
+ * <tt>dgebal</tt>:
+ *  1. Permutation: rows and columns are permuted to isolate the eigenvalues that can be read directly on the diagonal.
+ *  A row whose off-diagonal entries are all zero is moved to the bottom, a column whose off-diagonal entries are all zero
+ *  is moved to the top, and the search is repeated on the remaining part of the matrix. At the end \f$P^T A P\f$ is
+ *  upper triangular except for the diagonal block of rows and columns from GetLow() to GetHigh().
+ *  2. Scaling: the rows and columns of this diagonal block are scaled by powers of two, chosen such that for each index
+ *  the off-diagonal parts of the row and of the column have about the same norm. Since the scaling factors are powers of
+ *  two, the scaling does not introduce any rounding error.
+ *
+ * If \f$Av = \lambda v\f$, then \f$Bw = \lambda w\f$ with \f$w = D^{-1}P^Tv\f$: vectors are transformed to the basis of
+ * the balanced matrix with Balancing::Apply and mapped back with Balancing::BackTransform.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::Matrix<double, -1, -1> A(3,3);
+    A <<    1, 1e-8, 0,
+            1e8, 2, 1e4,
+            0, 1e-4, 3;
+    Balancing<double> balancing(A);
+    std::cout << "The balanced matrix is:\n" << balancing.GetMatrix() << std::endl;
+ *  @endcode
+ */
+template <typename T> class Balancing {
+public:
+    /**
+     * @brief Default constructor; the balancing has to be computed calling Balancing::Compute.
+     */
+    Balancing() {};
+
+    /**
+     * @brief Constructor; computes the balancing of the given matrix.
+     * @param A Square matrix to be balanced.
+     */
+    Balancing(const Eigen::Matrix<T, -1, -1> &A) {Compute(A);};
+
+    /**
+     * @brief Computes the balancing of the given matrix.
+     * @param A Square matrix to be balanced.
+     */
+    void Compute(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Returns the balanced matrix \f$B = D^{-1} P^T A P D\f$.
+     */
+    const Eigen::Matrix<T, -1, -1> &GetMatrix() const {return _B;};
+
+    /**
+     * @brief Returns the diagonal entries of the scaling matrix \f$D\f$.
+     */
+    const Eigen::Vector<double, -1> &GetScaling() const {return _scaling;};
+
+    /**
+     * @brief Returns the permutation: the row \f$i\f$ of \f$P^T A P\f$ is the row GetPermutation()[i] of \f$A\f$.
+     */
+    const std::vector<int> &GetPermutation() const {return _perm;};
+
+    /**
+     * @brief Returns the index of the first row and column of the diagonal block that is not triangular.
+     */
+    int GetLow() const {return _low;};
+
+    /**
+     * @brief Returns the index of the last row and column of the diagonal block that is not triangular.
+     */
+    int GetHigh() const {return _high;};
+
+    /**
+     * @brief Overwrites the given matrix \f$X\f$ with \f$D^{-1}P^TX\f$.
+     * @param X Matrix with as many rows as the balanced matrix.
+     */
+    void Apply(Eigen::Matrix<T, -1, -1> &X) const;
+
+    /**
+     * @brief Overwrites the given matrix \f$X\f$ with \f$PDX\f$.
+     * @param X Matrix with as many rows as the balanced matrix.
+     */
+    void BackTransform(Eigen::Matrix<T, -1, -1> &X) const;
+
+private:
+
+    /**
+     * @brief Balanced matrix.
+     */
+    Eigen::Matrix<T, -1, -1> _B;
+
+    /**
+     * @brief Diagonal entries of the scaling matrix, all powers of two.
+     */
+    Eigen::Vector<double, -1> _scaling;
+
+    /**
+     * @brief Permutation of the rows and columns.
+     */
+    std::vector<int> _perm;
+
+    /**
+     * @brief Index of the first row and column of the diagonal block that is not triangular.
+     */
+    int _low = 0;
+
+    /**
+     * @brief Index of the last row and column of the diagonal block that is not triangular.
+     */
+    int _high = -1;
+
+    /**
+     * @brief Swaps the rows and the columns \f$i\f$ and \f$j\f$ of the balanced matrix and updates the permutation.
+     */
+    void Swap(const int &i, const int &j);
+};
+
+#endif //BALANCING_H_
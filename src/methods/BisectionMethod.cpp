@@ -0,0 +1,184 @@
+#include "BisectionMethod.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// CONSTRUCTORS
+template <typename T>
+BisectionMethod<T>::BisectionMethod(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {
+    this->CheckSelfAdjoint();
+    _last = A.rows() - 1;
+}
+
+template <typename T>
+BisectionMethod<T>::BisectionMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+: AbstractEigs<T>(A, tol, maxit) {
+    this->CheckSelfAdjoint();
+    _last = A.rows() - 1;
+}
+
+/**
+ * @details At least the matrix has to be provided. If the interval is provided, the eigenvalues in the interval are
+ * computed; otherwise, if the indices are provided, the eigenvalues with the given indices are computed. If neither
+ * is provided, all the eigenvalues are computed and a warning is given to the user. If the tolerance or the maximum
+ * number of iterations are not provided, they are set to the default value and a warning is given to the user.
+ */
+template <typename T>
+BisectionMethod<T>::BisectionMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+    this->CheckDense();
+    this->CheckSelfAdjoint();
+    _last = (this->_A).rows() - 1;
+    try {
+        if (map.count("lower") > 0 && map.count("upper") > 0) {
+            SetInterval(std::any_cast<double>(map["lower"]), std::any_cast<double>(map["upper"]));
+        }
+        else if (map.count("first") > 0 && map.count("last") > 0) {
+            double first = std::any_cast<double>(map["first"]);
+            double last = std::any_cast<double>(map["last"]);
+            if (first != int(first) || last != int(last)) {
+                std::cerr << "WARNING: indices are not integers. Truncated to their floor" << std::endl;
+            }
+            SetIndices(int(first), int(last));
+        }
+        else {
+            std::cerr << "WARNING: Unspecified interval (lower, upper) or indices (first, last). "
+                         "All the eigenvalues are computed" << std::endl;
+        }
+    }
+    catch (std::bad_any_cast &e) {
+        throw (InitializationError("Unable to cast the interval or the indices to double"));
+    }
+}
+
+// SETTING METHODS
+/**
+ * @details If \f$a \geq b\f$, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set an empty interval</tt>.
+ */
+template <typename T>
+void BisectionMethod<T>::SetInterval(const double &a, const double &b) {
+    if (!(a < b)) {
+        throw(InitializationError("Attempting to set an empty interval"));
+    }
+    _lower = a;
+    _upper = b;
+    _by_interval = true;
+}
+
+/**
+ * @details If the indices are not such that \f$0 \leq i \leq j < n\f$, it throws an exception of type
+ * InitializationError with message: <tt>Attempting to set indices out of range</tt>.
+ */
+template <typename T>
+void BisectionMethod<T>::SetIndices(const int &first, const int &last) {
+    if (first < 0 || first > last || last >= (this->_A).rows()) {
+        throw(InitializationError("Attempting to set indices out of range"));
+    }
+    _first = first;
+    _last = last;
+    _by_interval = false;
+}
+
+// COMPUTATION OF EIGENVALUES
+/**
+ * @details In the interval case, the indices of the eigenvalues in \f$[a, b)\f$ are \f$N(a), \dots, N(b) - 1\f$ and the
+ * bisection of each of them starts from \f$[a, b)\f$. In the indices case, it starts from the Gershgorin interval of the
+ * tridiagonal matrix, which contains all the eigenvalues.
+ *
+ * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> BisectionMethod<T>::ComputeEigs() {
+    // Reduction to real symmetric tridiagonal form
+    TridiagonalReduction<T> tridiagonal(this->WorkMatrix());
+    const Eigen::Vector<double, -1> &d = tridiagonal.GetDiagonal();
+    Eigen::Vector<double, -1> e2 = tridiagonal.GetSubdiagonal().cwiseAbs2();
+    int n = d.size();
+    if (n == 0) {
+        this->_it = 0;
+        return Eigen::Vector<std::complex<double>, -1>(0);
+    }
+
+    // Gershgorin interval and thresholds
+    Eigen::Vector<double, -1> radius = Eigen::Vector<double, -1>::Zero(n);
+    radius.head(n - 1) += tridiagonal.GetSubdiagonal().cwiseAbs();
+    radius.tail(n - 1) += tridiagonal.GetSubdiagonal().cwiseAbs();
+    double norm = std::max((d - radius).cwiseAbs().maxCoeff(), (d + radius).cwiseAbs().maxCoeff());
+    double eps = std::numeric_limits<double>::epsilon();
+    double pivmin = std::numeric_limits<double>::min() * std::max(1.0, n > 1 ? e2.maxCoeff() : 0.0);
+    double abstol = 2 * eps * std::max(norm, pivmin);
+    double gl = (d - radius).minCoeff() - 2 * abstol;
+    double gu = (d + radius).maxCoeff() + 2 * abstol;
+
+    // Initial interval and indices of the slice
+    double l0 = gl, u0 = gu;
+    int first = _first, last = _last;
+    if (_by_interval) {
+        l0 = std::max(_lower, gl);
+        u0 = std::min(_upper, gu);
+        first = (l0 < u0) ? SturmCount(d, e2, l0, pivmin) : 0;
+        last = (l0 < u0) ? SturmCount(d, e2, u0, pivmin) - 1 : -1;
+    }
+    int m = last - first + 1;
+    Eigen::Vector<std::complex<double>, -1> eigs(m);
+
+    // Bisection of the interval of each eigenvalue
+    int it = 0;
+    bool converged = true;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:it) reduction(&&:converged)
+#endif
+    for (int k = first; k <= last; k++) {
+        double l = l0, u = u0;
+        int steps = 0;
+        while (u - l > std::max(this->_tol * std::max(std::abs(l), std::abs(u)), abstol)) {
+            if (steps == this->_maxit) {
+                converged = false;
+                break;
+            }
+            double mid = l + (u - l) / 2;
+            if (SturmCount(d, e2, mid, pivmin) <= k) {
+                l = mid;
+            }
+            else {
+                u = mid;
+            }
+            steps++;
+        }
+        eigs[k - first] = l + (u - l) / 2;
+        it += steps;
+    }
+    this->_it = it;
+
+    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    if (!converged) {
+        throw(ConvergenceError("Reached maximum number of iterations"));
+    }
+    return eigs;
+}
+
+/**
+ * @details Pivots smaller than pivmin in absolute value are replaced by \f$-pivmin\f$, as in the LAPACK routine
+ * <tt>dstebz</tt>.
+ */
+template <typename T>
+int BisectionMethod<T>::SturmCount(const Eigen::Vector<double, -1> &d, const Eigen::Vector<double, -1> &e2,
+                                   const double &x, const double &pivmin) {
+    int count = 0;
+    double q = 0;
+    for (int i = 0; i < d.size(); i++) {
+        q = d(i) - x - ((i > 0) ? e2(i - 1) / q : 0);
+        if (std::abs(q) < pivmin) {
+            q = -pivmin;
+        }
+        if (q < 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class BisectionMethod<double>;
+template class BisectionMethod<std::complex<double>>;
@@ -0,0 +1,133 @@
+#ifndef BISECTIONMETHOD_H_
+#define BISECTIONMETHOD_H_
+
+#include "AbstractEigs.h"
+#include "TridiagonalReduction.h"
+
+/** @class BisectionMethod
+ * @brief Class for computing the eigenvalues of symmetric or Hermitian matrices that lie in an interval, or that have
+ * given indices, using the bisection method.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The matrix is first reduced to real symmetric tridiagonal form \f$T\f$ with the TridiagonalReduction. For
+ * every real number \f$x\f$, the number \f$N(x)\f$ of eigenvalues of \f$T\f$ smaller than \f$x\f$ is equal to the number
+ * of negative pivots of the \f$LDL^T\f$ factorization of \f$T - xI\f$ (Sturm sequence @cite GolubVanLoan ):
+ * \f[ q_0 = t_{00} - x, \qquad q_i = t_{ii} - x - t_{i,i-1}^2 / q_{i-1}, \f]
+ * which costs \f$O(n)\f$ operations. If \f$N(l) \leq k < N(u)\f$, the \f$k\f$-th smallest eigenvalue lies in
+ * \f$[l, u)\f$, and the interval can be halved checking the sign of \f$N((l + u)/2) - k\f$.
+ *
+ * The method computes either:
+ *  - the eigenvalues in the interval \f$[a, b)\f$, set with BisectionMethod::SetInterval;
+ *  - the eigenvalues with indices from \f$i\f$ to \f$j\f$ (from zero, in ascending order), set with
+ *  BisectionMethod::SetIndices.
+ *
+ * Each eigenvalue of the slice is found by bisection of its own interval, starting from \f$[a, b)\f$ or from the
+ * Gershgorin interval of \f$T\f$, and the intervals are split among threads when OpenMP is available. Therefore the
+ * cost of the method after the reduction is proportional to the number of eigenvalues in the slice. The bisection of an
+ * interval \f$[l, u)\f$ is stopped when \f$u - l \leq \epsilon \max(|l|, |u|)\f$, where \f$\epsilon\f$ is the
+ * prescribed tolerance, or when it is comparable with the machine precision times the norm of \f$T\f$.
+ *
+ * If the given matrix is not symmetric (or Hermitian) up to a relative error \f$10^{-12}\f$, the constructors throw an
+ * exception of type InitializationError with message <tt>Attempting to set a non self-adjoint matrix</tt>.
+ *
+ * The maximum number of iterations bounds the number of bisection steps for each eigenvalue. If it is reached the method
+ * is said to be non-convergent for the specific instance. The eigenvalues are returned in ascending order.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::Matrix<double, -1, -1> A(4,4);
+    A <<    4, 1, 2, 0,
+            1, 3, 0, 1,
+            2, 0, 1, 1,
+            0, 1, 1, 2;
+    BisectionMethod<double> eigs_solver(A);
+    eigs_solver.SetInterval(0, 3);
+    std::cout << "The eigenvalues of A in [0, 3) are:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class BisectionMethod : public AbstractEigs<T>{
+public:
+    /**
+     * @brief Constructor; sets the given matrix.
+     * @param A Symmetric or Hermitian matrix whose eigenvalues are to be computed.
+     * @details By default all the eigenvalues are computed.
+     */
+    BisectionMethod(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     * @details By default all the eigenvalues are computed.
+     */
+    BisectionMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit);
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the interval with <tt>lower</tt> and <tt>upper</tt> or the indices with <tt>first</tt> and
+     * <tt>last</tt>.
+     */
+    BisectionMethod(std::map<std::string, std::any> &map);
+
+    // Destructor
+    virtual ~BisectionMethod() override {};
+
+    /**
+     * @brief Sets the interval in which the eigenvalues are to be computed.
+     * @param a Lower end of the interval, included.
+     * @param b Upper end of the interval, excluded.
+     */
+    void SetInterval(const double &a, const double &b);
+
+    /**
+     * @brief Sets the indices of the eigenvalues to be computed.
+     * @param first Index of the smallest eigenvalue to be computed, from zero.
+     * @param last Index of the largest eigenvalue to be computed, from zero.
+     */
+    void SetIndices(const int &first, const int &last);
+
+    /**
+     * @brief Returns the eigenvalues computed using the bisection method.
+     * @return Vector of complex numbers, with zero imaginary part, containing the requested eigenvalues in ascending
+     * order.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief If true, the eigenvalues in the interval are computed, otherwise the eigenvalues with the given indices.
+     */
+    bool _by_interval = false;
+
+    /**
+     * @brief Lower end of the interval.
+     */
+    double _lower = 0;
+
+    /**
+     * @brief Upper end of the interval.
+     */
+    double _upper = 0;
+
+    /**
+     * @brief Index of the smallest eigenvalue to be computed.
+     */
+    int _first = 0;
+
+    /**
+     * @brief Index of the largest eigenvalue to be computed.
+     */
+    int _last = -1;
+
+    /**
+     * @brief Returns the number of eigenvalues of a tridiagonal matrix smaller than a given value.
+     * @param d Diagonal of the tridiagonal matrix.
+     * @param e2 Squares of the subdiagonal entries of the tridiagonal matrix.
+     * @param x Value to which the eigenvalues are compared.
+     * @param pivmin Minimum absolute value of the pivots, to avoid divisions by zero.
+     */
+    static int SturmCount(const Eigen::Vector<double, -1> &d, const Eigen::Vector<double, -1> &e2, const double &x,
+                          const double &pivmin);
+};
+
+#endif //BISECTIONMETHOD_H_
@@ -0,0 +1,175 @@
+#include "ChebyshevFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// SETTING METHODS
+/**
+ * @details If the degree is negative, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a negative filter degree</tt>.
+ */
+template <typename T>
+void ChebyshevFilter<T>::SetDegree(const int &degree) {
+    if (degree < 0) {
+        throw(InitializationError("Attempting to set a negative filter degree"));
+    }
+    _degree = degree;
+}
+
+/**
+ * @details If the lower end is not smaller than the upper end, it throws an exception of type InitializationError with
+ * message: <tt>Attempting to set an empty interval</tt>. If the scaling point is inside the interval, it throws an
+ * exception of type InitializationError with message: <tt>Attempting to set a scaling point inside the interval</tt>.
+ */
+template <typename T>
+void ChebyshevFilter<T>::SetInterval(const double &lower, const double &upper, const double &scale) {
+    if (!(lower < upper)) {
+        throw(InitializationError("Attempting to set an empty interval"));
+    }
+    if (scale >= lower && scale <= upper) {
+        throw(InitializationError("Attempting to set a scaling point inside the interval"));
+    }
+    _lower = lower;
+    _upper = upper;
+    _scale = scale;
+}
+
+// ESTIMATION OF THE INTERVAL
+/**
+ * @details Executes \f$m\f$ steps of the Lanczos method with full reorthogonalization, which is cheap since \f$m\f$ is
+ * small, and computes the eigenvalues \f$\theta_1 \leq \dots \leq \theta_m\f$ of the tridiagonal projected matrix and
+ * its eigenvectors \f$z_i\f$. The spectrum is contained, up to the accuracy of the estimate, in \f$[L, U]\f$, where
+ * \f[ L = \theta_1 - \beta_m|z_{m,1}|, \qquad U = \theta_m + \beta_m|z_{m,m}| \f]
+ * are the extreme Ritz values enlarged by the norm of their residual.
+ */
+template <typename T>
+Eigen::VectorXd ChebyshevFilter<T>::RitzValues(const Operator &multiply, const Eigen::Vector<T, -1> &x0,
+                                               const int &steps, double &lower_bound, double &upper_bound) {
+    int n = x0.size();
+    int m = std::max(1, std::min(steps, n));
+    Eigen::Matrix<T, -1, -1> V(n, m);
+    Eigen::Vector<T, -1> v(n), w(n);
+    Eigen::VectorXd alpha(m), beta(m);
+    V.col(0) = x0 / x0.norm();
+
+    // Lanczos steps, stopped early if the Krylov subspace is invariant
+    int j = 0;
+    while (true) {
+        v = V.col(j);
+        multiply(v, w);
+        alpha[j] = std::real(v.dot(w));
+        for (int pass = 0; pass < 2; pass++) {
+            w.noalias() -= V.leftCols(j + 1) * (V.leftCols(j + 1).adjoint() * w);
+        }
+        beta[j] = w.norm();
+        j++;
+        if (j == m || beta[j - 1] <= std::numeric_limits<double>::epsilon() * std::abs(alpha[j - 1])) {
+            break;
+        }
+        V.col(j) = w / beta[j - 1];
+    }
+
+    // Ritz values and bounds of the spectrum
+    Eigen::MatrixXd Tm = Eigen::MatrixXd::Zero(j, j);
+    Tm.diagonal() = alpha.head(j);
+    Tm.diagonal(1) = Tm.diagonal(-1) = beta.head(j - 1);
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(Tm);
+    lower_bound = eig.eigenvalues()[0] - beta[j - 1] * std::abs(eig.eigenvectors()(j - 1, 0));
+    upper_bound = eig.eigenvalues()[j - 1] + beta[j - 1] * std::abs(eig.eigenvectors()(j - 1, j - 1));
+    return eig.eigenvalues();
+}
+
+/**
+ * @details The Ritz values and the bounds \f$[L, U]\f$ of the spectrum are computed by ChebyshevFilter::RitzValues. If
+ * \f$r\f$ is the \f$(k+1)\f$-th largest magnitude Ritz value, the damped interval is \f$[\max(L, -r), \min(U, r)]\f$:
+ * it contains the eigenvalues with magnitude smaller than \f$r\f$, and the wanted eigenvalues are outside of it, also
+ * if they are at both ends of the spectrum. The polynomial is scaled at the end of the spectrum with the largest
+ * magnitude.
+ *
+ * Since the Ritz values are inside the spectrum, \f$r\f$ underestimates the magnitude of the \f$(k+1)\f$-th eigenvalue:
+ * the closest unwanted eigenvalues can be outside the interval, where they are amplified less than the wanted ones,
+ * so that the convergence is slower but not wrong. If the Krylov subspace has less than \f$k + 1\f$ vectors or the
+ * interval is empty, the interval is reset and the filter is not active.
+ */
+template <typename T>
+bool ChebyshevFilter<T>::Estimate(const Operator &multiply, const Eigen::Vector<T, -1> &x0, const int &steps,
+                                  const int &k) {
+    double lower_bound, upper_bound;
+    Eigen::VectorXd theta = RitzValues(multiply, x0, steps, lower_bound, upper_bound);
+    _lower = _upper = _scale = 0;
+    if (theta.size() <= k) {
+        return false;
+    }
+
+    // Damped interval below the (k+1)-th largest magnitude Ritz value
+    Eigen::VectorXd magnitude = theta.cwiseAbs();
+    std::sort(magnitude.data(), magnitude.data() + magnitude.size(), std::greater<double>());
+    double r = magnitude[k];
+    double lower = std::max(lower_bound, -r);
+    double upper = std::min(upper_bound, r);
+    double scale = std::abs(upper_bound) >= std::abs(lower_bound) ? upper_bound : lower_bound;
+    if (!(lower < upper) || (scale >= lower && scale <= upper)) {
+        return false;
+    }
+    SetInterval(lower, upper, scale);
+    return true;
+}
+
+// APPLICATION OF THE FILTER
+/**
+ * @details The recurrence is the scaled one of Zhou and Saad: with \f$\sigma_1 = e / (s - c)\f$,
+ * \f[ Y_1 = \frac{\sigma_1}{e}(M - cI)X, \qquad
+ * Y_{i+1} = \frac{2\sigma_{i+1}}{e}(M - cI)Y_i - \sigma_i\sigma_{i+1}Y_{i-1}, \qquad
+ * \sigma_{i+1} = \frac{1}{2 / \sigma_1 - \sigma_i}, \f]
+ * where \f$Y_0 = X\f$, so that \f$Y_i = T_i((M - cI)/e)X / T_i((s - c)/e)\f$.
+ */
+template <typename T>
+void ChebyshevFilter<T>::Apply(const Operator &multiply, const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+    double e = (_upper - _lower) / 2;
+    double c = (_upper + _lower) / 2;
+    double sigma1 = e / (_scale - c);
+    double sigma = sigma1;
+
+    _product.resize(x.size());
+    multiply(x, _product);
+    _previous = x;
+    _current = (_product - c * x) * (sigma1 / e);
+    for (int i = 1; i < _degree; i++) {
+        double sigma_next = 1 / (2 / sigma1 - sigma);
+        multiply(_current, _product);
+        _next = (_product - c * _current) * (2 * sigma_next / e) - (sigma * sigma_next) * _previous;
+        _previous.swap(_current);
+        _current.swap(_next);
+        sigma = sigma_next;
+    }
+    y = _current;
+}
+
+/**
+ * @details The same recurrence of ChebyshevFilter::Apply is applied to the whole block, so that each step is a single
+ * product of the matrix with a block.
+ */
+template <typename T>
+void ChebyshevFilter<T>::ApplyBlock(const BlockOperator &multiply, const Eigen::Matrix<T, -1, -1> &X,
+                                    Eigen::Matrix<T, -1, -1> &Y) const {
+    double e = (_upper - _lower) / 2;
+    double c = (_upper + _lower) / 2;
+    double sigma1 = e / (_scale - c);
+    double sigma = sigma1;
+
+    Eigen::Matrix<T, -1, -1> previous = X, product(X.rows(), X.cols()), next;
+    multiply(X, product);
+    Y = (product - c * X) * (sigma1 / e);
+    for (int i = 1; i < _degree; i++) {
+        double sigma_next = 1 / (2 / sigma1 - sigma);
+        multiply(Y, product);
+        next = (product - c * Y) * (2 * sigma_next / e) - (sigma * sigma_next) * previous;
+        previous.swap(Y);
+        Y.swap(next);
+        sigma = sigma_next;
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class ChebyshevFilter<double>;
+template class ChebyshevFilter<std::complex<double>>;
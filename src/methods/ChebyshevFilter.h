@@ -0,0 +1,147 @@
+#ifndef CHEBYSHEVFILTER_H_
+#define CHEBYSHEVFILTER_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include <functional>
+#include "../exceptions/Exceptions.h"
+
+/** @class ChebyshevFilter
+ * @brief Class applying a Chebyshev polynomial filter, which damps the eigenvalues in a given interval, to vectors or
+ * blocks of vectors.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The power method and the subspace iteration converge at the ratio \f$|\lambda_{k+1} / \lambda_k|\f$, which
+ * is close to one when the wanted eigenvalues are not well separated from the unwanted ones. Multiplying by a
+ * polynomial \f$p(M)\f$ of the matrix \f$M\f$ of the iterations, instead of by \f$M\f$, the ratio becomes
+ * \f$|p(\lambda_{k+1}) / p(\lambda_k)|\f$. Among the polynomials of degree \f$d\f$ bounded by one on an interval
+ * \f$[a, b]\f$, the Chebyshev polynomial
+ * \f[ p(t) = T_d\left(\frac{t - c}{e}\right), \qquad c = \frac{a + b}{2}, \quad e = \frac{b - a}{2}, \f]
+ * grows the fastest outside the interval @cite GolubVanLoan: if \f$[a, b]\f$ contains the unwanted eigenvalues, they
+ * are damped with respect to the wanted ones by a factor that grows exponentially with the degree. The filter is
+ * computed with the three-term recurrence \f$T_{i+1}(t) = 2tT_i(t) - T_{i-1}(t)\f$, at the cost of \f$d\f$ products
+ * with \f$M\f$ and \f$O(dn)\f$ operations, scaled so that \f$p(s) = 1\f$ at a point \f$s\f$ outside the interval close
+ * to the wanted eigenvalues, which avoids overflow for high degrees @cite Zhou2006.
+ *
+ * The interval can be set directly or estimated by ChebyshevFilter::Estimate from a few steps of the Lanczos method.
+ * The filter assumes that the eigenvalues of \f$M\f$ are real, as for symmetric or Hermitian matrices.
+ */
+template <typename T> class ChebyshevFilter {
+public:
+    /**
+     * @brief Type of the functions applying the matrix to a vector; the result has to be written in the second vector.
+     */
+    typedef std::function<void(const Eigen::Vector<T, -1> &, Eigen::Vector<T, -1> &)> Operator;
+
+    /**
+     * @brief Type of the functions applying the matrix to a block of vectors; the result has to be written in the
+     * second matrix.
+     */
+    typedef std::function<void(const Eigen::Matrix<T, -1, -1> &, Eigen::Matrix<T, -1, -1> &)> BlockOperator;
+
+    /**
+     * @brief Sets the degree of the polynomial.
+     * @param degree Degree of the polynomial; zero disables the filter.
+     */
+    void SetDegree(const int &degree);
+
+    /**
+     * @brief Sets the interval of the damped eigenvalues and the scaling point.
+     * @param lower Lower end of the interval.
+     * @param upper Upper end of the interval.
+     * @param scale Point outside the interval at which the polynomial is equal to one.
+     */
+    void SetInterval(const double &lower, const double &upper, const double &scale);
+
+    /**
+     * @brief Returns the degree of the polynomial.
+     */
+    int GetDegree() const {return _degree;};
+
+    /**
+     * @brief Returns the lower end of the interval of the damped eigenvalues.
+     */
+    double GetLower() const {return _lower;};
+
+    /**
+     * @brief Returns the upper end of the interval of the damped eigenvalues.
+     */
+    double GetUpper() const {return _upper;};
+
+    /**
+     * @brief Returns the point at which the polynomial is equal to one.
+     */
+    double GetScale() const {return _scale;};
+
+    /**
+     * @brief Returns true if the degree is positive and the interval is set.
+     */
+    bool IsActive() const {return _degree > 0 && _lower < _upper;};
+
+    /**
+     * @brief Estimates the interval of the damped eigenvalues when the largest magnitude eigenvalues are wanted.
+     * @param multiply Function applying the matrix.
+     * @param x0 Nonzero starting vector of the Lanczos method.
+     * @param steps Number of steps of the Lanczos method.
+     * @param k Number of wanted eigenvalues.
+     * @return True if the interval is set; otherwise the filter is not active.
+     */
+    bool Estimate(const Operator &multiply, const Eigen::Vector<T, -1> &x0, const int &steps, const int &k);
+
+    /**
+     * @brief Executes a few steps of the Lanczos method and returns the Ritz values.
+     * @param multiply Function applying the matrix, assumed symmetric or Hermitian.
+     * @param x0 Nonzero starting vector of the Lanczos method.
+     * @param steps Number of steps of the Lanczos method, fewer if the Krylov subspace is invariant.
+     * @param lower_bound Estimated lower bound of the spectrum.
+     * @param upper_bound Estimated upper bound of the spectrum.
+     * @return Ritz values in ascending order.
+     */
+    static Eigen::VectorXd RitzValues(const Operator &multiply, const Eigen::Vector<T, -1> &x0, const int &steps,
+                                      double &lower_bound, double &upper_bound);
+
+    /**
+     * @brief Applies the filter to a vector.
+     * @param multiply Function applying the matrix.
+     * @param x Vector to be filtered.
+     * @param y Filtered vector, with the same size of x. It cannot be x.
+     * @details The workspace of the recurrence is allocated by the first call and reused by the following ones.
+     */
+    void Apply(const Operator &multiply, const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y);
+
+    /**
+     * @brief Applies the filter to a block of vectors.
+     * @param multiply Function applying the matrix.
+     * @param X Block to be filtered.
+     * @param Y Filtered block, resized if necessary. It cannot be X.
+     */
+    void ApplyBlock(const BlockOperator &multiply, const Eigen::Matrix<T, -1, -1> &X, Eigen::Matrix<T, -1, -1> &Y) const;
+
+private:
+    /**
+     * @brief Degree of the polynomial.
+     * Default value: <tt>0</tt>.
+     */
+    int _degree = 0;
+
+    /**
+     * @brief Lower end of the interval of the damped eigenvalues.
+     */
+    double _lower = 0;
+
+    /**
+     * @brief Upper end of the interval of the damped eigenvalues.
+     */
+    double _upper = 0;
+
+    /**
+     * @brief Point at which the polynomial is equal to one.
+     */
+    double _scale = 0;
+
+    /**
+     * @brief Workspace of the recurrence applied to vectors: previous, current and next term, product.
+     */
+    Eigen::Vector<T, -1> _previous, _current, _next, _product;
+};
+
+#endif //CHEBYSHEVFILTER_H_
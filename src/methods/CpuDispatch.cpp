@@ -0,0 +1,71 @@
+#include "CpuDispatch.h"
+
+CpuDispatch::Path CpuDispatch::_path = CpuDispatch::Detect();
+
+/**
+ * @details The features are read by the builtins of GCC and Clang, which execute the CPUID instruction and check that
+ * the operating system saves the extended registers.
+ */
+CpuDispatch::Path CpuDispatch::Detect() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return AVX2;
+    }
+    return SSE2;
+#else
+    return GENERIC;
+#endif
+}
+
+std::string CpuDispatch::GetPathName() {
+    switch (_path) {
+        case AVX512: return "avx512";
+        case AVX2: return "avx2";
+        case SSE2: return "sse2";
+        default: return "generic";
+    }
+}
+
+std::vector<std::string> CpuDispatch::GetSupportedPaths() {
+    std::vector<std::string> paths;
+    Path best = Detect();
+    if (best >= AVX512) {
+        paths.emplace_back("avx512");
+    }
+    if (best >= AVX2) {
+        paths.emplace_back("avx2");
+    }
+    if (best >= SSE2) {
+        paths.emplace_back("sse2");
+    }
+    paths.emplace_back("generic");
+    return paths;
+}
+
+void CpuDispatch::SetPath(const std::string &name) {
+    Path best = Detect();
+    Path path;
+    if (name == "avx512") {
+        path = AVX512;
+    }
+    else if (name == "avx2") {
+        path = AVX2;
+    }
+    else if (name == "sse2") {
+        path = SSE2;
+    }
+    else if (name == "generic") {
+        path = GENERIC;
+    }
+    else {
+        throw(InitializationError("Unsupported kernel path"));
+    }
+    if (path > best) {
+        throw(InitializationError("Unsupported kernel path"));
+    }
+    _path = path;
+}
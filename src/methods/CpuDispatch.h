@@ -0,0 +1,63 @@
+#ifndef CPUDISPATCH_H_
+#define CPUDISPATCH_H_
+
+#include <string>
+#include <vector>
+#include "Exceptions.h"
+
+/** @class CpuDispatch
+ * @brief Class selecting at run time the instruction set used by the kernels of IterationKernels.
+ * @details The library is compiled for the baseline instruction set of the architecture, so that the same binary runs
+ * on every machine, and Eigen is vectorized at compile time for that baseline only. The kernels of IterationKernels are
+ * compiled several times, once for each of the following paths, and the path is chosen when the program starts,
+ * reading the features of the processor with the CPUID instruction:
+ *  - <tt>avx512</tt>: AVX-512F, AVX2 and FMA instructions;
+ *  - <tt>avx2</tt>: AVX2 and FMA instructions;
+ *  - <tt>sse2</tt>: baseline of the x86-64 architecture;
+ *  - <tt>generic</tt>: baseline of the architecture, for compilers or architectures without multiversioning.
+ *
+ * The best path supported by the processor is selected by default. A different path supported by the processor can be
+ * selected by CpuDispatch::SetPath, for instance to compare the timings; if it is unknown or not supported, it throws
+ * an exception of type InitializationError with message <tt>Unsupported kernel path</tt>.
+ */
+class CpuDispatch {
+public:
+    /**
+     * @brief Instruction sets of the kernels.
+     */
+    enum Path {GENERIC, SSE2, AVX2, AVX512};
+
+    /**
+     * @brief Returns the path in use.
+     */
+    static Path GetPath() {return _path;};
+
+    /**
+     * @brief Returns the name of the path in use.
+     */
+    static std::string GetPathName();
+
+    /**
+     * @brief Returns the names of the paths supported by the processor, from the best one.
+     */
+    static std::vector<std::string> GetSupportedPaths();
+
+    /**
+     * @brief Selects the path used by the kernels.
+     * @param name Name of the path: <tt>avx512</tt>, <tt>avx2</tt>, <tt>sse2</tt> or <tt>generic</tt>.
+     */
+    static void SetPath(const std::string &name);
+
+private:
+    /**
+     * @brief Detects the best path supported by the processor.
+     */
+    static Path Detect();
+
+    /**
+     * @brief Path in use, detected when the program starts.
+     */
+    static Path _path;
+};
+
+#endif //CPUDISPATCH_H_
@@ -0,0 +1,103 @@
+#include "DenseFactorization.h"
+
+template <typename T>
+void DenseFactorization<T>::SetMethod(const std::string &method) {
+    CheckMethod(method);
+    _method = method;
+}
+
+template <typename T>
+void DenseFactorization<T>::CheckMethod(const std::string &method) {
+    if (method != "auto" && method != "partialpivlu" && method != "fullpivlu" && method != "llt" && method != "ldlt" &&
+        method != "qr" && method != "planarlu") {
+        throw(InitializationError("Unknown factorization"));
+    }
+}
+
+/**
+ * @details The matrix is assumed to be square, as the matrices of the methods derived from AbstractEigs.
+ */
+template <typename T>
+void DenseFactorization<T>::Compute(const Eigen::Matrix<T, -1, -1> &A) {
+    _computed = _method;
+    if (_method == "auto") {
+        // Cholesky factorization for positive definite self-adjoint matrices
+        if ((A - A.adjoint()).norm() <= 1e-12 * A.norm()) {
+            _llt.compute(A);
+            if (_llt.info() == Eigen::Success) {
+                _computed = "llt";
+                return;
+            }
+        }
+        // LU factorization with partial pivoting otherwise
+        _partial_lu.compute(A);
+        _computed = "partialpivlu";
+        return;
+    }
+
+    bool success = true;
+    if (_method == "partialpivlu") {
+        _partial_lu.compute(A);
+    }
+    else if (_method == "fullpivlu") {
+        _full_lu.compute(A);
+    }
+    else if (_method == "llt") {
+        _llt.compute(A);
+        success = (_llt.info() == Eigen::Success);
+    }
+    else if (_method == "ldlt") {
+        _ldlt.compute(A);
+        success = (_ldlt.info() == Eigen::Success);
+    }
+    else if (_method == "planarlu") {
+        _planar_lu.Compute(A);
+    }
+    else { // _method == "qr"
+        _qr.compute(A);
+    }
+    if (!success) {
+        throw(ConvergenceError("Unable to factorize the shifted matrix"));
+    }
+}
+
+template <typename T>
+Eigen::Vector<T, -1> DenseFactorization<T>::Solve(const Eigen::Vector<T, -1> &b) const {
+    Eigen::Vector<T, -1> x(b.size());
+    Solve(b, x);
+    return x;
+}
+
+/**
+ * @details The LU factorizations with partial pivoting, the Cholesky factorization and the \f$LDL^*\f$ factorization
+ * solve directly in the given vector, without allocating memory. The LU factorization with full pivoting and the QR
+ * factorization need a temporary vector.
+ */
+template <typename T>
+void DenseFactorization<T>::Solve(const Eigen::Vector<T, -1> &b, Eigen::Vector<T, -1> &x) const {
+    if (_computed == "partialpivlu") {
+        x = _partial_lu.solve(b);
+    }
+    else if (_computed == "fullpivlu") {
+        x = _full_lu.solve(b);
+    }
+    else if (_computed == "llt") {
+        x = _llt.solve(b);
+    }
+    else if (_computed == "ldlt") {
+        x = _ldlt.solve(b);
+    }
+    else if (_computed == "planarlu") {
+        _planar_lu.Solve(b, x);
+    }
+    else {
+        // Solving with the whole triangular factor, since the solver of Eigen discards the tiny pivots
+        Eigen::Vector<T, -1> c = _qr.householderQ().adjoint() * b;
+        _qr.matrixQR().template triangularView<Eigen::Upper>().solveInPlace(c);
+        x.noalias() = _qr.colsPermutation() * c;
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class DenseFactorization<double>;
+template class DenseFactorization<std::complex<double>>;
@@ -0,0 +1,136 @@
+#ifndef DENSEFACTORIZATION_H_
+#define DENSEFACTORIZATION_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include <string>
+#include "Exceptions.h"
+#include "PlanarLU.h"
+
+/** @class DenseFactorization
+ * @brief Class for factorizing dense matrices with a selectable strategy, to solve the linear systems of the inverse
+ * power methods.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The available strategies are identified by their names @cite GolubVanLoan :
+ *  - <tt>partialpivlu</tt>: LU factorization with partial pivoting \f$PA = LU\f$ (<tt>Eigen::PartialPivLU</tt>). It is
+ *  blocked, so that most of the operations are matrix-matrix products, which are executed in parallel when OpenMP is
+ *  available. It is several times faster than the LU factorization with full pivoting.
+ *  - <tt>fullpivlu</tt>: LU factorization with full pivoting \f$PAQ = LU\f$ (<tt>Eigen::FullPivLU</tt>). It is the
+ *  most stable LU factorization, but it is not blocked.
+ *  - <tt>llt</tt>: Cholesky factorization \f$A = LL^*\f$ (<tt>Eigen::LLT</tt>), for symmetric or Hermitian positive
+ *  definite matrices. It costs about half of the LU factorization.
+ *  - <tt>ldlt</tt>: factorization \f$P^TAP = LDL^*\f$ with diagonal pivoting (<tt>Eigen::LDLT</tt>), for symmetric or
+ *  Hermitian positive or negative semidefinite matrices.
+ *  - <tt>qr</tt>: QR factorization with column pivoting \f$AP = QR\f$ (<tt>Eigen::ColPivHouseholderQR</tt>). It costs
+ *  about twice the LU factorization, but its orthogonal transformations do not amplify the rounding errors, so it is
+ *  the most reliable for nearly singular matrices, as the shifted matrices with a shift very close to an eigenvalue.
+ *  No pivot is treated as zero when solving, since the tiny pivots carry the component along the eigenvector that the
+ *  inverse iteration amplifies.
+ *  - <tt>planarlu</tt>: LU factorization with partial pivoting whose factors are stored in planar layout, with the real
+ *  and the imaginary parts in separate arrays (PlanarLU). The systems of complex matrices are solved with real
+ *  arithmetic on unit stride arrays, which vectorizes better than the complex arithmetic. For real matrices it is the
+ *  same of <tt>partialpivlu</tt>.
+ *  - <tt>auto</tt> (default): the strategy is chosen looking at the matrix. If it is symmetric or Hermitian the Cholesky
+ *  factorization is tried first, and it succeeds if the matrix is positive definite. Otherwise the LU factorization
+ *  with partial pivoting is computed.
+ *
+ * If the name of the strategy is unknown, DenseFactorization::SetMethod throws an exception of type InitializationError
+ * with message <tt>Unknown factorization</tt>. If the Cholesky factorization or the \f$LDL^*\f$ factorization is
+ * requested and it fails, DenseFactorization::Compute throws an exception of type ConvergenceError with message
+ * <tt>Unable to factorize the shifted matrix</tt>.
+ */
+template <typename T> class DenseFactorization {
+public:
+    /**
+     * @brief Constructor; sets the strategy of the factorization.
+     * @param method Name of the strategy.
+     */
+    DenseFactorization(const std::string &method = "auto") {SetMethod(method);};
+
+    /**
+     * @brief Sets the strategy of the factorization.
+     * @param method Name of the strategy.
+     */
+    void SetMethod(const std::string &method);
+
+    /**
+     * @brief Returns the name of the strategy of the factorization.
+     */
+    const std::string &GetMethod() const {return _method;};
+
+    /**
+     * @brief Throws an exception of type InitializationError if the name of the strategy is unknown.
+     * @param method Name of the strategy.
+     */
+    static void CheckMethod(const std::string &method);
+
+    /**
+     * @brief Returns the name of the factorization computed by the last call of DenseFactorization::Compute, which is
+     * the one chosen if the strategy is <tt>auto</tt>.
+     */
+    const std::string &GetComputedMethod() const {return _computed;};
+
+    /**
+     * @brief Computes the factorization of the given matrix.
+     * @param A Square matrix.
+     */
+    void Compute(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Solves \f$Ax = b\f$ with the last computed factorization.
+     * @param b Right-hand side.
+     * @return Solution \f$x\f$.
+     */
+    Eigen::Vector<T, -1> Solve(const Eigen::Vector<T, -1> &b) const;
+
+    /**
+     * @brief Solves \f$Ax = b\f$ with the last computed factorization, writing the solution in the given vector.
+     * @param b Right-hand side.
+     * @param x Solution, resized only if its size is wrong.
+     */
+    void Solve(const Eigen::Vector<T, -1> &b, Eigen::Vector<T, -1> &x) const;
+
+private:
+
+    /**
+     * @brief Name of the strategy of the factorization.
+     */
+    std::string _method;
+
+    /**
+     * @brief Name of the factorization computed by the last call of DenseFactorization::Compute.
+     */
+    std::string _computed;
+
+    /**
+     * @brief LU factorization with partial pivoting.
+     */
+    Eigen::PartialPivLU<Eigen::Matrix<T, -1, -1>> _partial_lu;
+
+    /**
+     * @brief LU factorization with full pivoting.
+     */
+    Eigen::FullPivLU<Eigen::Matrix<T, -1, -1>> _full_lu;
+
+    /**
+     * @brief Cholesky factorization.
+     */
+    Eigen::LLT<Eigen::Matrix<T, -1, -1>> _llt;
+
+    /**
+     * @brief \f$LDL^*\f$ factorization with diagonal pivoting.
+     */
+    Eigen::LDLT<Eigen::Matrix<T, -1, -1>> _ldlt;
+
+    /**
+     * @brief QR factorization with column pivoting.
+     */
+    Eigen::ColPivHouseholderQR<Eigen::Matrix<T, -1, -1>> _qr;
+
+    /**
+     * @brief LU factorization with partial pivoting with factors in planar layout.
+     */
+    PlanarLU<T> _planar_lu;
+};
+
+#endif //DENSEFACTORIZATION_H_
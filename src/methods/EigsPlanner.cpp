@@ -0,0 +1,91 @@
+#include "EigsPlanner.h"
+#include "BisectionMethod.h"
+#include "QRMethod.h"
+#include "SymmetricQRMethod.h"
+#include "TriangularEigs.h"
+#include <algorithm>
+
+/**
+ * @details If the matrix is missing from the map or cannot be cast to the expected type, it throws an exception of type
+ * InitializationError as the map-based constructor of AbstractEigs.
+ */
+template <typename T>
+EigsPlanner<T>::EigsPlanner(std::map<std::string, std::any> &map) : _map(map) {
+    // Getting the matrix and detecting its structure
+    if (map.count("matrix") == 0) {
+        throw(InitializationError("Missing argument: matrix"));
+    }
+    try {
+        _structure = Inspect(std::any_cast<const Eigen::Matrix<T, -1, -1> &>(map["matrix"]));
+    }
+    catch (std::bad_any_cast &e){
+        throw(InitializationError("Unable to cast the matrix to the expected type"));
+    }
+
+    // Choosing the method
+    bool slice = (map.count("lower") > 0 && map.count("upper") > 0) ||
+                 (map.count("first") > 0 && map.count("last") > 0);
+    if (slice) {
+        if (_structure.self_adjoint) {
+            _method = "bisection";
+        }
+    }
+    else if (_structure.IsTriangular()) {
+        _method = "triangular";
+    }
+    else if (_structure.self_adjoint) {
+        _method = "symqr";
+    }
+    else {
+        _method = "qr";
+    }
+    if (_method.empty()) {
+        throw(InitializationError("No method available for the requested eigenvalues"));
+    }
+}
+
+template <typename T>
+std::unique_ptr<AbstractEigs<T>> EigsPlanner<T>::CreateSolver() {
+    if (_method == "bisection") {
+        return std::make_unique<BisectionMethod<T>>(_map);
+    }
+    if (_method == "triangular") {
+        return std::make_unique<TriangularEigs<T>>(_map);
+    }
+    if (_method == "symqr") {
+        return std::make_unique<SymmetricQRMethod<T>>(_map);
+    }
+    return std::make_unique<QRMethod<T>>(_map);
+}
+
+/**
+ * @details The bandwidths and the number of nonzero entries are computed in a single pass over the matrix.
+ * If the matrix is non square, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a non square matrix</tt>.
+ */
+template <typename T>
+MatrixStructure EigsPlanner<T>::Inspect(const Eigen::Matrix<T, -1, -1> &A) {
+    if (A.rows() != A.cols()){
+        throw(InitializationError("Attempting to set a non square matrix"));
+    }
+    MatrixStructure structure;
+    int n = A.rows();
+    structure.size = n;
+    long nnz = 0;
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i < n; i++) {
+            if (A(i, j) != T(0)) {
+                nnz++;
+                structure.lower_bandwidth = std::max(structure.lower_bandwidth, i - j);
+                structure.upper_bandwidth = std::max(structure.upper_bandwidth, j - i);
+            }
+        }
+    }
+    structure.fill_ratio = (n > 0) ? double(nnz) / (double(n) * n) : 0;
+    structure.self_adjoint = (A - A.adjoint()).norm() <= 1e-12 * A.norm();
+    return structure;
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class EigsPlanner<double>;
+template class EigsPlanner<std::complex<double>>;
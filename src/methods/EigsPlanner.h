@@ -0,0 +1,139 @@
+#ifndef EIGSPLANNER_H_
+#define EIGSPLANNER_H_
+
+#include <memory>
+#include "AbstractEigs.h"
+
+/**
+ * @brief Structure of a square matrix, as detected by EigsPlanner.
+ */
+struct MatrixStructure {
+    /**
+     * @brief Size of the matrix.
+     */
+    int size = 0;
+
+    /**
+     * @brief True if the matrix is symmetric or Hermitian, up to a relative error \f$10^{-12}\f$.
+     */
+    bool self_adjoint = false;
+
+    /**
+     * @brief Largest \f$i - j\f$ such that \f$a_{ij} \neq 0\f$ (zero if the matrix is upper triangular).
+     */
+    int lower_bandwidth = 0;
+
+    /**
+     * @brief Largest \f$j - i\f$ such that \f$a_{ij} \neq 0\f$ (zero if the matrix is lower triangular).
+     */
+    int upper_bandwidth = 0;
+
+    /**
+     * @brief Ratio between the number of nonzero entries and the number of entries of the matrix.
+     */
+    double fill_ratio = 0;
+
+    /**
+     * @brief Returns true if the matrix is diagonal.
+     */
+    bool IsDiagonal() const {return lower_bandwidth == 0 && upper_bandwidth == 0;};
+
+    /**
+     * @brief Returns true if the matrix is upper or lower triangular.
+     */
+    bool IsTriangular() const {return lower_bandwidth == 0 || upper_bandwidth == 0;};
+
+    /**
+     * @brief Returns true if the matrix is in upper Hessenberg form.
+     */
+    bool IsHessenberg() const {return lower_bandwidth <= 1;};
+};
+
+/** @class EigsPlanner
+ * @brief Class for choosing the cheapest method that computes the requested eigenvalues of a matrix.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The planner inspects the matrix once, detecting its MatrixStructure, and then chooses the method looking at
+ * the structure and at the parameters in the map:
+ *  1. If an interval (keys <tt>lower</tt> and <tt>upper</tt>) or indices (keys <tt>first</tt> and <tt>last</tt>) are
+ *  given, only the corresponding eigenvalues are requested. This is possible only for self-adjoint matrices, for which
+ *  the BisectionMethod is chosen.
+ *  2. Otherwise all the eigenvalues are requested. If the matrix is diagonal or triangular they are its diagonal
+ *  entries and TriangularEigs is chosen, which executes no iteration.
+ *  3. If the matrix is symmetric or Hermitian, the SymmetricQRMethod is chosen, whose iterations cost \f$O(n)\f$
+ *  operations.
+ *  4. Otherwise the QRMethod is chosen, which skips the reduction to Hessenberg form if the matrix is already in
+ *  Hessenberg form.
+ *
+ * The names of the methods are the ones used by the executable <tt>main</tt>: <tt>bisection</tt>,
+ * <tt>triangular</tt>, <tt>symqr</tt> and <tt>qr</tt>.
+ *
+ * If no method can compute the requested eigenvalues, the constructor throws an exception of type InitializationError
+ * with message <tt>No method available for the requested eigenvalues</tt>.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    std::map<std::string, std::any> map;
+    map["matrix"] = A;
+    std::unique_ptr<AbstractEigs<double>> p_eigsSolver = MakeEigsSolver<double>(map);
+    std::cout << "The eigenvalues of A are:\n" << p_eigsSolver->ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class EigsPlanner {
+public:
+    /**
+     * @brief Constructor; inspects the matrix and chooses the method.
+     * @param map Map containing the parameters of the method, as for the map-based constructors of the derived
+     * classes of AbstractEigs. The matrix has to be associated with the key <tt>matrix</tt>.
+     */
+    EigsPlanner(std::map<std::string, std::any> &map);
+
+    /**
+     * @brief Returns the structure of the matrix.
+     */
+    const MatrixStructure &GetStructure() const {return _structure;};
+
+    /**
+     * @brief Returns the name of the chosen method.
+     */
+    const std::string &GetMethod() const {return _method;};
+
+    /**
+     * @brief Returns the solver of the chosen method, constructed from the map.
+     */
+    std::unique_ptr<AbstractEigs<T>> CreateSolver();
+
+    /**
+     * @brief Detects the structure of a square matrix.
+     * @param A Square matrix.
+     */
+    static MatrixStructure Inspect(const Eigen::Matrix<T, -1, -1> &A);
+
+private:
+
+    /**
+     * @brief Map containing the parameters of the method.
+     */
+    std::map<std::string, std::any> &_map;
+
+    /**
+     * @brief Structure of the matrix.
+     */
+    MatrixStructure _structure;
+
+    /**
+     * @brief Name of the chosen method.
+     */
+    std::string _method;
+};
+
+/**
+ * @brief Returns the solver of the cheapest method that computes the requested eigenvalues, chosen by EigsPlanner.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @param map Map containing the parameters of the method.
+ */
+template <typename T>
+std::unique_ptr<AbstractEigs<T>> MakeEigsSolver(std::map<std::string, std::any> &map) {
+    return EigsPlanner<T>(map).CreateSolver();
+}
+
+#endif //EIGSPLANNER_H_
@@ -0,0 +1,98 @@
+#include "FactorizationCache.h"
+#include <cstring>
+
+/**
+ * @details If the given capacity is lower than or equal to zero, it throws an exception of type InitializationError
+ * with message: <tt>Attempting to set capacity <= 0</tt>.
+ */
+template <typename T>
+FactorizationCache<T>::FactorizationCache(const int &capacity) {
+    if (capacity <= 0) {
+        throw(InitializationError("Attempting to set capacity <= 0"));
+    }
+    _capacity = capacity;
+}
+
+/**
+ * @details The cache is not locked while the factorization is computed, so that solvers sharing the cache in
+ * different threads can factorize different matrices at the same time.
+ */
+template <typename T>
+std::shared_ptr<const DenseFactorization<T>> FactorizationCache<T>::Factorize(const Eigen::Matrix<T, -1, -1> &A,
+                                                                              const T &shift,
+                                                                              const std::string &method) {
+    std::uint64_t fingerprint = Fingerprint(A);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            if (it->fingerprint == fingerprint && it->shift == shift && it->method == method) {
+                // Moving the entry to the front, as the most recently used
+                _entries.splice(_entries.begin(), _entries, it);
+                _hits++;
+                return _entries.front().factorization;
+            }
+        }
+        _misses++;
+    }
+
+    auto factorization = std::make_shared<DenseFactorization<T>>(method);
+    if (shift == T(0)) {
+        factorization->Compute(A);
+    }
+    else {
+        factorization->Compute(A - shift * Eigen::Matrix<T, -1, -1>::Identity(A.rows(), A.cols()));
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.push_front({fingerprint, shift, method, factorization});
+    while (int(_entries.size()) > _capacity) {
+        _entries.pop_back();
+    }
+    return factorization;
+}
+
+template <typename T>
+void FactorizationCache<T>::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
+
+template <typename T>
+int FactorizationCache<T>::GetSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+template <typename T>
+int FactorizationCache<T>::GetHits() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
+
+template <typename T>
+int FactorizationCache<T>::GetMisses() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _misses;
+}
+
+/**
+ * @details The fingerprint is the 64-bit FNV-1a hash of the number of rows, of the number of columns and of the bytes
+ * of the entries of the matrix.
+ */
+template <typename T>
+std::uint64_t FactorizationCache<T>::Fingerprint(const Eigen::Matrix<T, -1, -1> &A) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto update = [&hash](const unsigned char *bytes, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    std::int64_t dimensions[2] = {A.rows(), A.cols()};
+    update(reinterpret_cast<const unsigned char *>(dimensions), sizeof(dimensions));
+    update(reinterpret_cast<const unsigned char *>(A.data()), A.size() * sizeof(T));
+    return hash;
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class FactorizationCache<double>;
+template class FactorizationCache<std::complex<double>>;
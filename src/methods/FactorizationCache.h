@@ -0,0 +1,128 @@
+#ifndef FACTORIZATIONCACHE_H_
+#define FACTORIZATIONCACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "DenseFactorization.h"
+
+/** @class FactorizationCache
+ * @brief Class for storing the factorizations of shifted matrices \f$A - \sigma I\f$, so that they are computed only
+ * once.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The factorization of a dense matrix costs \f$O(n^3)\f$ operations, while an iteration of the inverse power
+ * methods costs \f$O(n^2)\f$. The cache stores the factorizations computed by FactorizationCache::Factorize, keyed by
+ * a fingerprint of the matrix \f$A\f$, by the shift \f$\sigma\f$ and by the strategy of the factorization, and returns
+ * the stored factorization when the same key is requested again.
+ *
+ * The fingerprint is a 64-bit hash of the size and of the entries of the matrix: computing it costs \f$O(n^2)\f$
+ * operations, as an iteration, and two different matrices have the same fingerprint with negligible probability.
+ *
+ * At most FactorizationCache::GetCapacity factorizations are stored. When a new factorization is stored in a full
+ * cache, the least recently used one is discarded. The factorizations are shared and never modified, so that the same
+ * cache can be shared among many solvers, even running in different threads.
+ *
+ * Each InvPowerMethod and ShiftInvPowerMethod owns a cache of capacity one, so that calling ComputeEigs() again after
+ * changing only the initial vector, the tolerance or the maximum number of iterations does not factorize the matrix
+ * again. A larger cache can be shared among solvers with InvPowerMethod::SetFactorizationCache and
+ * ShiftInvPowerMethod::SetFactorizationCache.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    auto cache = std::make_shared<FactorizationCache<double>>(10);
+    for (double tol : {1e-6, 1e-8, 1e-10}) {
+        ShiftInvPowerMethod<double> eigs_solver(A, tol, maxit, x0, shift);
+        eigs_solver.SetFactorizationCache(cache); // A - shift * I is factorized only once
+        std::cout << eigs_solver.ComputeEigs() << std::endl;
+    }
+ *  @endcode
+ */
+template <typename T> class FactorizationCache {
+public:
+    /**
+     * @brief Constructor; sets the maximum number of factorizations stored.
+     * @param capacity Maximum number of factorizations stored.
+     */
+    FactorizationCache(const int &capacity = 1);
+
+    /**
+     * @brief Returns the factorization of \f$A - \sigma I\f$, computing it only if it is not stored.
+     * @param A Square matrix.
+     * @param shift Shift \f$\sigma\f$.
+     * @param method Name of the strategy of the factorization. @see DenseFactorization
+     */
+    std::shared_ptr<const DenseFactorization<T>> Factorize(const Eigen::Matrix<T, -1, -1> &A, const T &shift,
+                                                           const std::string &method);
+
+    /**
+     * @brief Discards all the stored factorizations.
+     */
+    void Clear();
+
+    /**
+     * @brief Returns the maximum number of factorizations stored.
+     */
+    int GetCapacity() const {return _capacity;};
+
+    /**
+     * @brief Returns the number of factorizations stored.
+     */
+    int GetSize() const;
+
+    /**
+     * @brief Returns the number of calls of FactorizationCache::Factorize that found the factorization stored.
+     */
+    int GetHits() const;
+
+    /**
+     * @brief Returns the number of calls of FactorizationCache::Factorize that computed the factorization.
+     */
+    int GetMisses() const;
+
+    /**
+     * @brief Returns the fingerprint of a matrix.
+     * @param A Matrix.
+     */
+    static std::uint64_t Fingerprint(const Eigen::Matrix<T, -1, -1> &A);
+
+private:
+
+    /**
+     * @brief Stored factorization, with its key.
+     */
+    struct Entry {
+        std::uint64_t fingerprint;
+        T shift;
+        std::string method;
+        std::shared_ptr<const DenseFactorization<T>> factorization;
+    };
+
+    /**
+     * @brief Stored factorizations, from the most recently used to the least recently used.
+     */
+    std::list<Entry> _entries;
+
+    /**
+     * @brief Maximum number of factorizations stored.
+     */
+    int _capacity;
+
+    /**
+     * @brief Number of calls of FactorizationCache::Factorize that found the factorization stored.
+     */
+    int _hits = 0;
+
+    /**
+     * @brief Number of calls of FactorizationCache::Factorize that computed the factorization.
+     */
+    int _misses = 0;
+
+    /**
+     * @brief Mutex protecting the stored factorizations and the counters when the cache is shared among threads.
+     */
+    mutable std::mutex _mutex;
+};
+
+#endif //FACTORIZATIONCACHE_H_
@@ -0,0 +1,201 @@
+#include "HessenbergReduction.h"
+#include <algorithm>
+
+/**
+ * @brief Computes the product between the trailing columns of a matrix and a vector, splitting the rows among threads.
+ * @param M Matrix.
+ * @param c0 Index of the first column of the trailing part.
+ * @param x Vector with as many entries as the trailing columns.
+ * @param y Vector in which the result is stored.
+ */
+template <typename T>
+static void TrailingGemv(const Eigen::Matrix<T, -1, -1> &M, const int &c0, const Eigen::Vector<T, -1> &x,
+                         Eigen::Vector<T, -1> &y) {
+    const int n = M.rows();
+    const int ncols = M.cols() - c0;
+    const int block_rows = 256;
+    const int nblocks = (n + block_rows - 1) / block_rows;
+    y.resize(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int ib = 0; ib < nblocks; ib++) {
+        int r0 = ib * block_rows;
+        int nr = std::min(block_rows, n - r0);
+        y.segment(r0, nr).noalias() = M.block(r0, c0, nr, ncols) * x;
+    }
+}
+
+/**
+ * @details If the given matrix is non square, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to reduce a non square matrix</tt>.
+ *
+ * For each panel of columns \f$k, \dots, k+nb-1\f$, let \f$Q_j = H_k \cdots H_{k+j-1} = I - V_j T_j V_j^*\f$ be the
+ * product of the reflectors computed so far in the panel and \f$Y_j = A V_j T_j\f$, where \f$A\f$ is the matrix at the
+ * beginning of the panel. The column \f$c = k+j\f$ of \f$Q_j^* A Q_j\f$ is computed as
+ * \f$(I - V_j T_j^* V_j^*)(a_c - Y_j V_j^* e_c)\f$ and the reflector \f$H_c\f$ that annihilates its entries below the
+ * subdiagonal is generated. Then \f$Y\f$ and \f$T\f$ are extended with
+ * \f$Y e_j = \tau_c (A v_c - Y_j V_j^* v_c)\f$ and \f$T e_j = (-\tau_c T_j V_j^* v_c, \tau_c)\f$.
+ * At the end of the panel the rest of the matrix is updated as \f$A \leftarrow A - Y V^*\f$ (from the right) and
+ * \f$A \leftarrow A - V T^* V^* A\f$ (from the left) with matrix-matrix products.
+ */
+template <typename T>
+void HessenbergReduction<T>::Compute(const Eigen::Matrix<T, -1, -1> &A) {
+    if (A.rows() != A.cols()) {
+        throw(InitializationError("Attempting to reduce a non square matrix"));
+    }
+    int n = A.rows();
+    _packed = A;
+    _coeffs = Eigen::Vector<T, -1>::Zero(std::max(n - 1, 0));
+
+    Eigen::Vector<T, -1> b, y, w, t;
+    for (int k = 0; k < n - 1; k += _nb) {
+        int nb = std::min(_nb, n - 1 - k);
+        int m = n - k - 1; // Number of rows on which the reflectors of the panel act, from k+1 to n-1
+        Eigen::Matrix<T, -1, -1> V = Eigen::Matrix<T, -1, -1>::Zero(m, nb);
+        Eigen::Matrix<T, -1, -1> Y(n, nb);
+        Eigen::Matrix<T, -1, -1> Tm = Eigen::Matrix<T, -1, -1>::Zero(nb, nb);
+
+        for (int j = 0; j < nb; j++) {
+            int c = k + j;
+            // Current column, updated with the reflectors already computed in the panel
+            b = _packed.col(c).tail(m);
+            if (j > 0) {
+                b.noalias() -= Y.block(k + 1, 0, m, j) * V.row(j - 1).head(j).adjoint();
+                w.noalias() = V.leftCols(j).adjoint() * b;
+                w = Tm.topLeftCorner(j, j).adjoint().template triangularView<Eigen::Lower>() * w;
+                b.noalias() -= V.leftCols(j) * w;
+            }
+
+            // Reflector annihilating the entries below the subdiagonal
+            Eigen::Vector<T, -1> x = b.tail(m - j);
+            Eigen::Vector<T, -1> essential(m - j - 1);
+            T h;
+            double beta;
+            x.makeHouseholder(essential, h, beta);
+            T tau = Eigen::numext::conj(h);
+            b(j) = beta;
+            b.tail(m - j - 1) = essential;
+            _packed.col(c).tail(m) = b;
+            _coeffs(c) = tau;
+            V(j, j) = T(1);
+            V.col(j).tail(m - j - 1) = essential;
+
+            // New columns of Y and T
+            Eigen::Vector<T, -1> v = V.col(j).tail(m - j);
+            TrailingGemv(_packed, c + 1, v, y);
+            t.noalias() = V.block(j, 0, m - j, j).adjoint() * v;
+            y.noalias() -= Y.leftCols(j) * t;
+            Y.col(j) = tau * y;
+            t = Tm.topLeftCorner(j, j).template triangularView<Eigen::Upper>() * t;
+            Tm.col(j).head(j) = -tau * t;
+            Tm(j, j) = tau;
+        }
+
+        // Update from the right of the rows above the panel, in the columns of the panel
+        if (nb > 1) {
+            _packed.block(0, k + 1, k + 1, nb - 1).noalias() -= Y.topRows(k + 1) * V.topRows(nb - 1).adjoint();
+        }
+        if (k + nb < n) {
+            // Update from the right of the trailing columns
+            _packed.rightCols(n - k - nb).noalias() -= Y * V.bottomRows(m - nb + 1).adjoint();
+            // Update from the left of the trailing columns
+            Eigen::Matrix<T, -1, -1> W = V.adjoint() * _packed.block(k + 1, k + nb, m, n - k - nb);
+            W = Tm.adjoint().template triangularView<Eigen::Lower>() * W;
+            _packed.block(k + 1, k + nb, m, n - k - nb).noalias() -= V * W;
+        }
+    }
+}
+
+/**
+ * @details The entries of the compact storage below the subdiagonal are set to zero.
+ */
+template <typename T>
+Eigen::Matrix<T, -1, -1> HessenbergReduction<T>::GetMatrixH() const {
+    int n = _packed.rows();
+    Eigen::Matrix<T, -1, -1> H = _packed;
+    if (n > 2) {
+        H.bottomLeftCorner(n - 2, n - 2).template triangularView<Eigen::Lower>().setZero();
+    }
+    return H;
+}
+
+/**
+ * @details The matrix is formed applying the reflectors to the identity matrix.
+ */
+template <typename T>
+Eigen::Matrix<T, -1, -1> HessenbergReduction<T>::GetMatrixQ() const {
+    Eigen::Matrix<T, -1, -1> Q = Eigen::Matrix<T, -1, -1>::Identity(_packed.rows(), _packed.rows());
+    ApplyQ(Q);
+    return Q;
+}
+
+/**
+ * @details The reflectors are applied panel by panel, from the last one to the first one, as block reflectors
+ * \f$I - V T V^*\f$.
+ *
+ * If the number of rows of the given matrix does not match the size of the reduced matrix, it throws an exception of
+ * type InitializationError with message: <tt>Attempting to apply the reflectors to a matrix with incorrect size</tt>.
+ */
+template <typename T>
+void HessenbergReduction<T>::ApplyQ(Eigen::Matrix<T, -1, -1> &X) const {
+    int n = _packed.rows();
+    if (X.rows() != n) {
+        throw(InitializationError("Attempting to apply the reflectors to a matrix with incorrect size"));
+    }
+    Eigen::Matrix<T, -1, -1> V, Tm;
+    for (int k = ((n - 2) / _nb) * _nb; k >= 0 && n > 1; k -= _nb) {
+        int nb = std::min(_nb, n - 1 - k);
+        BlockReflector(k, nb, V, Tm);
+        Eigen::Matrix<T, -1, -1> W = V.adjoint() * X.bottomRows(n - k - 1);
+        W = Tm.template triangularView<Eigen::Upper>() * W;
+        X.bottomRows(n - k - 1).noalias() -= V * W;
+    }
+}
+
+/**
+ * @details The reflectors are applied panel by panel, from the first one to the last one, as block reflectors
+ * \f$I - V T^* V^*\f$.
+ *
+ * If the number of rows of the given matrix does not match the size of the reduced matrix, it throws an exception of
+ * type InitializationError with message: <tt>Attempting to apply the reflectors to a matrix with incorrect size</tt>.
+ */
+template <typename T>
+void HessenbergReduction<T>::ApplyQAdjoint(Eigen::Matrix<T, -1, -1> &X) const {
+    int n = _packed.rows();
+    if (X.rows() != n) {
+        throw(InitializationError("Attempting to apply the reflectors to a matrix with incorrect size"));
+    }
+    Eigen::Matrix<T, -1, -1> V, Tm;
+    for (int k = 0; k < n - 1; k += _nb) {
+        int nb = std::min(_nb, n - 1 - k);
+        BlockReflector(k, nb, V, Tm);
+        Eigen::Matrix<T, -1, -1> W = V.adjoint() * X.bottomRows(n - k - 1);
+        W = Tm.adjoint().template triangularView<Eigen::Lower>() * W;
+        X.bottomRows(n - k - 1).noalias() -= V * W;
+    }
+}
+
+/**
+ * @details The triangular factor is computed as in the LAPACK routine <tt>dlarft</tt>:
+ * \f$T e_j = (-\tau_j T_j V_j^* v_j, \tau_j)\f$.
+ */
+template <typename T>
+void HessenbergReduction<T>::BlockReflector(const int &k, const int &nb, Eigen::Matrix<T, -1, -1> &V,
+                                            Eigen::Matrix<T, -1, -1> &Tm) const {
+    int m = _packed.rows() - k - 1;
+    V = Eigen::Matrix<T, -1, -1>::Zero(m, nb);
+    Tm = Eigen::Matrix<T, -1, -1>::Zero(nb, nb);
+    for (int j = 0; j < nb; j++) {
+        V(j, j) = T(1);
+        V.col(j).tail(m - j - 1) = _packed.col(k + j).tail(m - j - 1);
+        Eigen::Vector<T, -1> t = V.block(j, 0, m - j, j).adjoint() * V.col(j).tail(m - j);
+        t = Tm.topLeftCorner(j, j).template triangularView<Eigen::Upper>() * t;
+        Tm.col(j).head(j) = -_coeffs(k + j) * t;
+        Tm(j, j) = _coeffs(k + j);
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class HessenbergReduction<double>;
+template class HessenbergReduction<std::complex<double>>;
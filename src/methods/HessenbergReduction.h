@@ -0,0 +1,129 @@
+#ifndef HESSENBERGREDUCTION_H_
+#define HESSENBERGREDUCTION_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include "Exceptions.h"
+
+/** @class HessenbergReduction
+ * @brief Class for reducing a square matrix to upper Hessenberg form by a unitary similarity transformation.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details Every square matrix \f$A\f$ of size \f$n\f$ can be reduced to upper Hessenberg form \f$H = Q^* A Q\f$, where
+ * \f$Q\f$ is unitary and \f$h_{ij} = 0\f$ for \f$i > j+1\f$ @cite GolubVanLoan . Since \f$H\f$ and \f$A\f$ are similar
+ * they have the same eigenvalues, and many operations are cheaper on \f$H\f$: a QR iteration costs \f$O(n^2)\f$
+ * operations instead of \f$O(n^3)\f$, and so does the LU factorization of \f$H - \sigma I\f$ for any shift \f$\sigma\f$.
+ * The reduction costs \f$O(n^3)\f$ operations, therefore it is meant to be computed once and reused, for instance by
+ * QRMethod or by ShiftPowerMethod and ShiftInvPowerMethod for different shifts.
+ *
+ * The matrix \f$Q\f$ is the product \f$Q = H_0 H_1 \cdots H_{n-2}\f$ of Householder reflectors
+ * \f$H_k = I - \tau_k v_k v_k^*\f$, where \f$v_k\f$ has zeros in the first \f$k\f$ entries and one in the entry \f$k+1\f$.
+ * The reflectors are stored in compact form: the entries of \f$v_k\f$ below the entry \f$k+1\f$ are stored in the column
+ * \f$k\f$ of GetHouseholderVectors() below the subdiagonal, and the coefficients \f$\tau_k\f$ in GetHouseholderCoeffs().
+ *
+ * The reduction is blocked (compact WY representation, as in the LAPACK routines <tt>dgehrd</tt> and <tt>dlahr2</tt>):
+ * the columns are processed in panels of HessenbergReduction::_nb columns. Within a panel the reflectors are computed
+ * updating only the current column, and the reflectors of the panel are accumulated in the form
+ * \f$H_k \cdots H_{k+nb-1} = I - V T V^*\f$, with \f$T\f$ upper triangular. The rest of the matrix is then updated with
+ * matrix-matrix products, which are the most of the operations and are executed in parallel when OpenMP is
+ * available, as is the matrix-vector product with the trailing part of the matrix needed for each column of the panel.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::Matrix<double, -1, -1> A(5,5);
+    A <<    1, 28 , 48, -52, -8,
+            2, -17, -42, 24, 2,
+            0, 12, 25, -12 , 0,
+            2, 0, -4 , 11, 2,
+            -4, -4, 12, 16, 5;
+    HessenbergReduction<double> hessenberg(A);
+    std::cout << "The Hessenberg form of A is:\n" << hessenberg.GetMatrixH() << std::endl;
+    std::cout << "The residual ||QHQ^T - A|| is ";
+    std::cout << (hessenberg.GetMatrixQ() * hessenberg.GetMatrixH() * hessenberg.GetMatrixQ().adjoint() - A).norm();
+ *  @endcode
+ */
+template <typename T> class HessenbergReduction {
+public:
+    /**
+     * @brief Default constructor; the reduction has to be computed calling HessenbergReduction::Compute.
+     */
+    HessenbergReduction() {};
+
+    /**
+     * @brief Constructor; computes the Hessenberg reduction of the given matrix.
+     * @param A Square matrix to be reduced.
+     */
+    HessenbergReduction(const Eigen::Matrix<T, -1, -1> &A) {Compute(A);};
+
+    /**
+     * @brief Computes the Hessenberg reduction of the given matrix.
+     * @param A Square matrix to be reduced.
+     */
+    void Compute(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Returns the size of the reduced matrix.
+     */
+    int GetSize() const {return _packed.rows();};
+
+    /**
+     * @brief Returns the upper Hessenberg matrix \f$H\f$.
+     */
+    Eigen::Matrix<T, -1, -1> GetMatrixH() const;
+
+    /**
+     * @brief Returns the unitary matrix \f$Q\f$ such that \f$A = Q H Q^*\f$.
+     */
+    Eigen::Matrix<T, -1, -1> GetMatrixQ() const;
+
+    /**
+     * @brief Returns the compact storage of the reduction: \f$H\f$ on and above the subdiagonal, the essential parts of
+     * the Householder vectors below the subdiagonal.
+     */
+    const Eigen::Matrix<T, -1, -1> &GetHouseholderVectors() const {return _packed;};
+
+    /**
+     * @brief Returns the coefficients \f$\tau_k\f$ of the Householder reflectors.
+     */
+    const Eigen::Vector<T, -1> &GetHouseholderCoeffs() const {return _coeffs;};
+
+    /**
+     * @brief Overwrites the given matrix \f$X\f$ with \f$QX\f$.
+     * @param X Matrix with as many rows as the reduced matrix.
+     */
+    void ApplyQ(Eigen::Matrix<T, -1, -1> &X) const;
+
+    /**
+     * @brief Overwrites the given matrix \f$X\f$ with \f$Q^*X\f$.
+     * @param X Matrix with as many rows as the reduced matrix.
+     */
+    void ApplyQAdjoint(Eigen::Matrix<T, -1, -1> &X) const;
+
+private:
+
+    /**
+     * @brief Number of columns in each panel of the blocked reduction.
+     */
+    static constexpr int _nb = 32;
+
+    /**
+     * @brief Compact storage of the reduction.
+     * @details \f$H\f$ is stored on and above the subdiagonal, the essential parts of the Householder vectors below.
+     */
+    Eigen::Matrix<T, -1, -1> _packed;
+
+    /**
+     * @brief Coefficients \f$\tau_k\f$ of the Householder reflectors.
+     */
+    Eigen::Vector<T, -1> _coeffs;
+
+    /**
+     * @brief Builds the compact WY representation \f$I - V T V^*\f$ of the reflectors of a panel.
+     * @param k Index of the first reflector of the panel.
+     * @param nb Number of reflectors in the panel.
+     * @param V Matrix in which the Householder vectors of the panel are stored, restricted to the rows from \f$k+1\f$.
+     * @param Tm Upper triangular matrix of the compact WY representation.
+     */
+    void BlockReflector(const int &k, const int &nb, Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<T, -1, -1> &Tm) const;
+};
+
+#endif //HESSENBERGREDUCTION_H_
@@ -1,19 +1,77 @@
 #include "InvPowerMethod.h"
 
 /**
- * @details The method has been overridden to add an initial step that computes the LU factorization of the matrix.
+ * @details At least the matrix has to be provided. If the factorization is not provided, it is chosen looking at the
+ * matrix. If the initial vector, the tolerance or the maximum number of iterations are not provided, they are set to
+ * the default value and a warning is given to the user.
+ */
+template <typename T>
+InvPowerMethod<T>::InvPowerMethod(std::map<std::string, std::any> &map) : AbstractPowerMethod<T>(map) {
+    this->CheckStored();
+
+    // Getting and setting the factorization
+    if (map.count("factorization") > 0) {
+        std::string factorization;
+        try {
+            factorization = std::any_cast<std::string>(map["factorization"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the factorization to string"));
+        }
+        SetFactorization(factorization);
+    }
+}
+
+/**
+ * @details The method has been overridden to add an initial step that computes the factorization of the matrix, or
+ * its sparse factorization if the matrix is sparse. The factorization is taken from the cache if it has already been
+ * computed for the same matrix, so that the following calls only iterate. The symbolic analysis of the sparse
+ * factorization is executed only by the first call, and the numeric factorization is also kept by the following calls.
  */
 template <typename T>
 Eigen::Vector<std::complex<double>, -1> InvPowerMethod<T>::ComputeEigs() {
-    _LU = this->_A.fullPivLu();
+    if (this->_sparse) {
+        if (!_sparse_factorization.IsAnalyzed()) {
+            _sparse_factorization.Analyze(this->_A_sparse);
+        }
+        _sparse_factorization.Factorize(T(0));
+    }
+    else {
+        // The planar layout replaces the strategy of the factorization
+        std::string method = this->UsePlanarLayout() ? "planarlu" : _factorization_method;
+        _factorization = _cache->Factorize(this->WorkMatrix(), T(0), method);
+    }
     return AbstractPowerMethod<T>::ComputeEigs();
 }
 
 template <typename T>
-Eigen::Vector<T, -1> InvPowerMethod<T>::Multiply(const Eigen::Vector<T, -1> &x) {
-    // The multiplication is executed solving a system, given the already computed LU factorization of the matrix whose
+void InvPowerMethod<T>::Multiply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+    // The multiplication is executed solving a system, given the already computed factorization of the matrix whose
     // eigenvalues are to be computed.
-    return _LU.solve(x);
+    if (this->_sparse) {
+        _sparse_factorization.Solve(x, y);
+    }
+    else {
+        _factorization->Solve(x, y);
+    }
+}
+
+template <typename T>
+void InvPowerMethod<T>::SetFactorization(const std::string &factorization) {
+    DenseFactorization<T>::CheckMethod(factorization);
+    _factorization_method = factorization;
+}
+
+/**
+ * @details If the given cache is null, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a null factorization cache</tt>.
+ */
+template <typename T>
+void InvPowerMethod<T>::SetFactorizationCache(const std::shared_ptr<FactorizationCache<T>> &cache) {
+    if (!cache) {
+        throw(InitializationError("Attempting to set a null factorization cache"));
+    }
+    _cache = cache;
 }
 
 // Explicit instantiation for double and std::complex<double>
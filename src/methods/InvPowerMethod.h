@@ -2,6 +2,9 @@
 #define INVPOWERMETHOD_H_
 
 #include "AbstractPowerMethod.h"
+#include "DenseFactorization.h"
+#include "FactorizationCache.h"
+#include "SparseFactorization.h"
 
 /** @class InvPowerMethod
  * @brief Class for computing the smallest magnitude eigenvalue of general matrices using the Inverse Power Method.
@@ -10,7 +13,7 @@
  * matrix \f$A\f$.
  * The Inverse Power Method can be described in the following way:
  *  1. Starting from an initial nonzero vector \f$x^{(0)}\f$, divide it by its norm: \f$x^{(0)} = x^{(0)} / ||x^{(0)}||\f$
- *  2. Compute the LU factorization of \f$A\f$
+ *  2. Compute a factorization of \f$A\f$, for instance the LU factorization
  *  3. At each iteration \f$k\f$:
  *      1. Solve \f$Ax^{(k+1)} = x^{(k)}\f$
  *      2. \f$x^{(k+1)} = x^{(k+1)} / ||x^{(k+1)}||\f$
@@ -22,6 +25,20 @@
  *  where \f$\epsilon\f$ is a prescribed tolerance. In any case, the iterations are stopped when \f$k\f$ exceeds the
  *  maximum number of iterations and in this case the method is said to be non-convergent for the specific instance.
  *
+ *  The factorization of a dense matrix is chosen by InvPowerMethod::SetFactorization or by the key
+ *  <tt>factorization</tt> of the map-based constructor. By default it is chosen looking at the matrix: the Cholesky
+ *  factorization for symmetric or Hermitian positive definite matrices, the LU factorization with partial pivoting
+ *  otherwise. @see DenseFactorization
+ *
+ *  The factorization is stored in a cache, keyed by a fingerprint of the matrix, so that it is not computed again by
+ *  the following calls of ComputeEigs() after changing the initial vector, the tolerance or the maximum number of
+ *  iterations. By default the cache is owned by the solver and stores only the last factorization: a cache storing
+ *  more factorizations can be shared among solvers with InvPowerMethod::SetFactorizationCache.
+ *  @see FactorizationCache
+ *
+ *  If the matrix is sparse, the LU factorization is replaced by a sparse factorization with a fill-reducing ordering,
+ *  an \f$LDL^*\f$ factorization if the matrix is symmetric or Hermitian. @see SparseFactorization
+ *
  *  Usage:
  *  @code{.cpp}
     double tol = 1e-10;
@@ -70,13 +87,57 @@ public:
                    const Eigen::Vector<T,-1> &x0) : AbstractPowerMethod<T>(A, tol, maxit, x0) {};
 
     /**
-     * @copydoc  AbstractPowerMethod::AbstractPowerMethod(std::map<std::string, std::any> &map)
+     * @copydoc AbstractPowerMethod::AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
      */
-    InvPowerMethod(std::map<std::string, std::any> &map) : AbstractPowerMethod<T>(map) {};
+    InvPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractPowerMethod<T>(A) {};
+
+    /**
+     * @copydoc AbstractPowerMethod::AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int maxit, const Eigen::Matrix<T,-1,1> &x0)
+     */
+    InvPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit,
+                   const Eigen::Vector<T,-1> &x0) : AbstractPowerMethod<T>(A, tol, maxit, x0) {};
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the initial vector with <tt>x0</tt> and the name of the factorization, as
+     * <tt>std::string</tt>, with <tt>factorization</tt>.
+     */
+    InvPowerMethod(std::map<std::string, std::any> &map);
 
     // Destructor
     virtual ~InvPowerMethod() override {};
 
+    /**
+     * @brief Sets the strategy of the factorization of the matrix, if it is dense.
+     * @param factorization Name of the strategy: <tt>auto</tt> (default), <tt>partialpivlu</tt>, <tt>fullpivlu</tt>,
+     * <tt>llt</tt>, <tt>ldlt</tt>, <tt>qr</tt> or <tt>planarlu</tt>. @see DenseFactorization
+     */
+    void SetFactorization(const std::string &factorization);
+
+    /**
+     * @brief Returns the strategy of the factorization of the matrix.
+     */
+    std::string GetFactorization() {return _factorization_method;};
+
+    /**
+     * @brief Returns the factorization computed by the last call of ComputeEigs(), which is the one chosen by the
+     * strategy <tt>auto</tt>.
+     */
+    std::string GetComputedFactorization() {return _factorization ? _factorization->GetComputedMethod() : "";};
+
+    /**
+     * @brief Sets the cache storing the factorizations of the matrix, which can be shared with other solvers.
+     * @param cache Cache of the factorizations. @see FactorizationCache
+     */
+    void SetFactorizationCache(const std::shared_ptr<FactorizationCache<T>> &cache);
+
+    /**
+     * @brief Returns the cache storing the factorizations of the matrix.
+     */
+    std::shared_ptr<FactorizationCache<T>> GetFactorizationCache() {return _cache;};
+
     /**
      * @brief Returns the eigenvalues computed using the inverse power method.
      * @return Vector of complex numbers containing the eigenvalue of \f$A\f$ with the smallest absolute value.
@@ -85,9 +146,25 @@ public:
 
 private:
     /**
-     * @brief Member that stores the LU factorization of the matrix whose eigenvalues are to be computed.
+     * @brief Member that stores the factorization of the matrix whose eigenvalues are to be computed.
+     */
+    std::shared_ptr<const DenseFactorization<T>> _factorization;
+
+    /**
+     * @brief Member that stores the strategy of the factorization of the matrix.
+     */
+    std::string _factorization_method = "auto";
+
+    /**
+     * @brief Member that stores the cache of the factorizations of the matrix, by default owned by the solver and
+     * storing only the last factorization.
+     */
+    std::shared_ptr<FactorizationCache<T>> _cache = std::make_shared<FactorizationCache<T>>();
+
+    /**
+     * @brief Member that stores the sparse factorization of the matrix, if the matrix is sparse.
      */
-    Eigen::FullPivLU<Eigen::Matrix<T, -1, -1>> _LU;
+    SparseFactorization<T> _sparse_factorization;
 
 
     /**
@@ -101,9 +178,9 @@ private:
     /**
      * @brief Executes the multiplication step of the inverse power method.
      * @param x vector to be multiplied.
-     * @return Result of the multiplication step, i.e. \f$ A^{-1}\,x \f$.
+     * @param y result of the multiplication step, i.e. \f$ A^{-1}\,x \f$.
      */
-    Eigen::Vector<T,-1> Multiply(const Eigen::Vector<T,-1> &x) override;
+    void Multiply(const Eigen::Vector<T,-1> &x, Eigen::Vector<T,-1> &y) override;
 };
 
 #endif //INVPOWERMETHOD_H_
@@ -0,0 +1,171 @@
+#include "IterationKernels.h"
+#include "CpuDispatch.h"
+#include "KernelTargets.h"
+
+// SCALE, NORM AND INNER PRODUCT
+KERNEL_INLINE double ScaleNormDotBody(const double *x, double *y, const int &n, const double &scale, double &norm2) {
+    double norm2_sum = 0;
+    double dot = 0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:norm2_sum, dot)
+#endif
+    for (int i = 0; i < n; i++) {
+        double yi = scale * y[i];
+        y[i] = yi;
+        norm2_sum += yi * yi;
+        dot += x[i] * yi;
+    }
+    norm2 = norm2_sum;
+    return dot;
+}
+
+/*
+ * The complex arrays are read as arrays of doubles with interleaved real and imaginary parts, as guaranteed by the
+ * standard for std::complex<double>.
+ */
+KERNEL_INLINE std::complex<double> ScaleNormDotBody(const std::complex<double> *x, std::complex<double> *y,
+                                                    const int &n, const double &scale, double &norm2) {
+    const double *xd = reinterpret_cast<const double *>(x);
+    double *yd = reinterpret_cast<double *>(y);
+    double norm2_sum = 0;
+    double dot_real = 0;
+    double dot_imag = 0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:norm2_sum, dot_real, dot_imag)
+#endif
+    for (int i = 0; i < n; i++) {
+        double yr = scale * yd[2 * i];
+        double yi = scale * yd[2 * i + 1];
+        yd[2 * i] = yr;
+        yd[2 * i + 1] = yi;
+        norm2_sum += yr * yr + yi * yi;
+        // conj(x) * y
+        dot_real += xd[2 * i] * yr + xd[2 * i + 1] * yi;
+        dot_imag += xd[2 * i] * yi - xd[2 * i + 1] * yr;
+    }
+    norm2 = norm2_sum;
+    return {dot_real, dot_imag};
+}
+
+// MATRIX-VECTOR PRODUCT
+/*
+ * Four columns are accumulated at a time, so that y is read and written once every four columns of A.
+ */
+KERNEL_INLINE void GemvBody(const double *A, const double *x, double *y, const int &rows, const int &cols) {
+    for (int i = 0; i < rows; i++) {
+        y[i] = 0;
+    }
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+        const double *a0 = A + (long) j * rows, *a1 = a0 + rows, *a2 = a1 + rows, *a3 = a2 + rows;
+        double x0 = x[j], x1 = x[j + 1], x2 = x[j + 2], x3 = x[j + 3];
+        KERNEL_SIMD
+        for (int i = 0; i < rows; i++) {
+            y[i] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+        }
+    }
+    for (; j < cols; j++) {
+        const double *a0 = A + (long) j * rows;
+        double x0 = x[j];
+        KERNEL_SIMD
+        for (int i = 0; i < rows; i++) {
+            y[i] += a0[i] * x0;
+        }
+    }
+}
+
+/*
+ * Two columns are accumulated at a time; the complex products are expanded in real arithmetic on the interleaved real
+ * and imaginary parts.
+ */
+KERNEL_INLINE void GemvBody(const std::complex<double> *A, const std::complex<double> *x, std::complex<double> *y,
+                            const int &rows, const int &cols) {
+    const double *Ad = reinterpret_cast<const double *>(A);
+    double *yd = reinterpret_cast<double *>(y);
+    for (int i = 0; i < 2 * rows; i++) {
+        yd[i] = 0;
+    }
+    int j = 0;
+    for (; j + 2 <= cols; j += 2) {
+        const double *a0 = Ad + 2 * (long) j * rows, *a1 = a0 + 2 * rows;
+        double x0r = x[j].real(), x0i = x[j].imag(), x1r = x[j + 1].real(), x1i = x[j + 1].imag();
+        KERNEL_SIMD
+        for (int i = 0; i < rows; i++) {
+            double a0r = a0[2 * i], a0i = a0[2 * i + 1], a1r = a1[2 * i], a1i = a1[2 * i + 1];
+            yd[2 * i] += a0r * x0r - a0i * x0i + a1r * x1r - a1i * x1i;
+            yd[2 * i + 1] += a0r * x0i + a0i * x0r + a1r * x1i + a1i * x1r;
+        }
+    }
+    for (; j < cols; j++) {
+        const double *a0 = Ad + 2 * (long) j * rows;
+        double x0r = x[j].real(), x0i = x[j].imag();
+        KERNEL_SIMD
+        for (int i = 0; i < rows; i++) {
+            double a0r = a0[2 * i], a0i = a0[2 * i + 1];
+            yd[2 * i] += a0r * x0r - a0i * x0i;
+            yd[2 * i + 1] += a0r * x0i + a0i * x0r;
+        }
+    }
+}
+
+// VARIANTS FOR EACH INSTRUCTION SET
+template <typename T>
+T ScaleNormDotBaseline(const T *x, T *y, const int &n, const double &scale, double &norm2) {
+    return ScaleNormDotBody(x, y, n, scale, norm2);
+}
+
+template <typename T>
+void GemvBaseline(const T *A, const T *x, T *y, const int &rows, const int &cols) {
+    GemvBody(A, x, y, rows, cols);
+}
+
+#ifdef KERNEL_MULTIVERSIONING
+template <typename T> KERNEL_AVX2
+T ScaleNormDotAvx2(const T *x, T *y, const int &n, const double &scale, double &norm2) {
+    return ScaleNormDotBody(x, y, n, scale, norm2);
+}
+
+template <typename T> KERNEL_AVX512
+T ScaleNormDotAvx512(const T *x, T *y, const int &n, const double &scale, double &norm2) {
+    return ScaleNormDotBody(x, y, n, scale, norm2);
+}
+
+template <typename T> KERNEL_AVX2
+void GemvAvx2(const T *A, const T *x, T *y, const int &rows, const int &cols) {
+    GemvBody(A, x, y, rows, cols);
+}
+
+template <typename T> KERNEL_AVX512
+void GemvAvx512(const T *A, const T *x, T *y, const int &rows, const int &cols) {
+    GemvBody(A, x, y, rows, cols);
+}
+#endif
+
+// DISPATCH
+template <typename T>
+T IterationKernels<T>::ScaleNormDot(const T *x, T *y, const int &n, const double &scale, double &norm2) {
+#ifdef KERNEL_MULTIVERSIONING
+    switch (CpuDispatch::GetPath()) {
+        case CpuDispatch::AVX512: return ScaleNormDotAvx512(x, y, n, scale, norm2);
+        case CpuDispatch::AVX2: return ScaleNormDotAvx2(x, y, n, scale, norm2);
+        default: break;
+    }
+#endif
+    return ScaleNormDotBaseline(x, y, n, scale, norm2);
+}
+
+template <typename T>
+void IterationKernels<T>::Gemv(const T *A, const T *x, T *y, const int &rows, const int &cols) {
+#ifdef KERNEL_MULTIVERSIONING
+    switch (CpuDispatch::GetPath()) {
+        case CpuDispatch::AVX512: GemvAvx512(A, x, y, rows, cols); return;
+        case CpuDispatch::AVX2: GemvAvx2(A, x, y, rows, cols); return;
+        default: break;
+    }
+#endif
+    GemvBaseline(A, x, y, rows, cols);
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class IterationKernels<double>;
+template class IterationKernels<std::complex<double>>;
@@ -0,0 +1,48 @@
+#ifndef ITERATIONKERNELS_H_
+#define ITERATIONKERNELS_H_
+
+#include <complex>
+
+/** @class IterationKernels
+ * @brief Class collecting the vector kernels executed at each iteration of the power methods.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details For large matrices stored in sparse format or given as a LinearOperator, the cost of an iteration is
+ * dominated by the memory traffic, so that the vector operations that follow the multiplication step are not
+ * negligible. Computed separately, the norm of the new iterate, its normalization and the Rayleigh quotient read the
+ * vectors five times. The kernels of this class execute them in a single pass over the vectors, with SIMD instructions
+ * when OpenMP is available.
+ *
+ * The product of a dense matrix with a vector, which dominates the iterations of PowerMethod and ShiftPowerMethod on
+ * dense matrices, is also a kernel of this class.
+ *
+ * The kernels work on contiguous arrays. A complex vector is read as an array of pairs of doubles, real and imaginary
+ * part, so that the reductions are computed in double precision arithmetic and vectorize as the real ones.
+ *
+ * Each kernel is compiled for several instruction sets and the one used is selected at run time. @see CpuDispatch
+ */
+template <typename T> class IterationKernels {
+public:
+    /**
+     * @brief Scales \f$y\f$ and computes, in the same pass, its squared norm and the inner product with \f$x\f$.
+     * @param x Array of size \f$n\f$.
+     * @param y Array of size \f$n\f$, overwritten by \f$sy\f$.
+     * @param n Size of the arrays.
+     * @param scale Scaling factor \f$s\f$.
+     * @param norm2 Computed squared norm \f$||sy||^2\f$.
+     * @return Inner product \f$x^*(sy)\f$.
+     */
+    static T ScaleNormDot(const T *x, T *y, const int &n, const double &scale, double &norm2);
+
+    /**
+     * @brief Computes the product \f$y = Ax\f$.
+     * @param A Matrix stored by columns.
+     * @param x Array of size equal to the number of columns of \f$A\f$.
+     * @param y Array of size equal to the number of rows of \f$A\f$, overwritten by \f$Ax\f$. It cannot overlap
+     * with \f$x\f$.
+     * @param rows Number of rows of \f$A\f$.
+     * @param cols Number of columns of \f$A\f$.
+     */
+    static void Gemv(const T *A, const T *x, T *y, const int &rows, const int &cols);
+};
+
+#endif //ITERATIONKERNELS_H_
@@ -0,0 +1,29 @@
+#ifndef KERNELTARGETS_H_
+#define KERNELTARGETS_H_
+
+/*
+ * Macros for compiling the kernels of the library for several instruction sets, included only by the source files
+ * that define kernels. The body of a kernel is an inline function, which is inlined in one function for each instruction
+ * set, where the compiler vectorizes it with the instructions of that set. The function used is selected at run time
+ * by CpuDispatch.
+ */
+
+#if defined(__GNUC__)
+#define KERNEL_INLINE inline __attribute__((always_inline))
+#else
+#define KERNEL_INLINE inline
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define KERNEL_MULTIVERSIONING
+#define KERNEL_AVX2 __attribute__((target("avx2,fma")))
+#define KERNEL_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#endif
+
+#ifdef _OPENMP
+#define KERNEL_SIMD _Pragma("omp simd")
+#else
+#define KERNEL_SIMD
+#endif
+
+#endif //KERNELTARGETS_H_
@@ -0,0 +1,305 @@
+#include "LOBPCGMethod.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// CONSTRUCTORS
+template <typename T>
+LOBPCGMethod<T>::LOBPCGMethod(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {
+    this->CheckSelfAdjoint();
+}
+
+template <typename T>
+LOBPCGMethod<T>::LOBPCGMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+: AbstractEigs<T>(A, tol, maxit) {
+    this->CheckSelfAdjoint();
+}
+
+template <typename T>
+LOBPCGMethod<T>::LOBPCGMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractEigs<T>(A) {
+    this->CheckSelfAdjoint();
+}
+
+template <typename T>
+LOBPCGMethod<T>::LOBPCGMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+: AbstractEigs<T>(A, tol, maxit) {
+    this->CheckSelfAdjoint();
+}
+
+/**
+ * @details At least the matrix has to be provided. If the number of eigenvalues is not provided, only the smallest
+ * eigenvalue is computed and a warning is given to the user. If the block size or the preconditioner are not provided,
+ * they are set to the default value. If the tolerance or the maximum number of iterations are not provided, they are
+ * set to the default value and a warning is given to the user.
+ */
+template <typename T>
+LOBPCGMethod<T>::LOBPCGMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+    this->CheckSelfAdjoint();
+
+    // Getting and setting the number of eigenvalues
+    if (map.count("neigs") > 0) {
+        double neigs;
+        try {
+            neigs = std::any_cast<double>(map["neigs"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the number of eigenvalues to double"));
+        }
+        SetNumEigs(int(neigs));
+    }
+    else { // map.count("neigs") == 0
+        std::cerr << "WARNING: Unspecified number of eigenvalues (neigs). Set by default neigs = 1" << std::endl;
+    }
+
+    // Getting and setting the block size
+    if (map.count("block") > 0) {
+        double block_size;
+        try {
+            block_size = std::any_cast<double>(map["block"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the block size to double"));
+        }
+        SetBlockSize(int(block_size));
+    }
+
+    // Getting and setting the preconditioner
+    if (map.count("preconditioner") > 0) {
+        std::string preconditioner;
+        try {
+            preconditioner = std::any_cast<std::string>(map["preconditioner"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the preconditioner to string"));
+        }
+        SetPreconditioner(preconditioner);
+    }
+}
+
+// SETTING METHODS
+/**
+ * @details The projected problem has size three times the block size, therefore the number of eigenvalues cannot be
+ * larger than one third of the size of the matrix. If the number of eigenvalues is not between one and one third of the
+ * size of the matrix, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a number of eigenvalues out of range</tt>. If a block size smaller than the new number of
+ * eigenvalues was set, it is reset to the default one.
+ */
+template <typename T>
+void LOBPCGMethod<T>::SetNumEigs(const int &neigs) {
+    if (neigs <= 0 || 3 * neigs > this->GetSize()) {
+        throw(InitializationError("Attempting to set a number of eigenvalues out of range"));
+    }
+    _neigs = neigs;
+    if (_block_size < _neigs) {
+        _block_size = 0;
+    }
+}
+
+/**
+ * @details If the block size is smaller than the number of eigenvalues or larger than one third of the size of the
+ * matrix, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a block size out of range</tt>.
+ */
+template <typename T>
+void LOBPCGMethod<T>::SetBlockSize(const int &block_size) {
+    if (block_size < _neigs || 3 * block_size > this->GetSize()) {
+        throw(InitializationError("Attempting to set a block size out of range"));
+    }
+    _block_size = block_size;
+}
+
+/**
+ * @details If the name is not one of <tt>none</tt>, <tt>jacobi</tt> and <tt>ichol</tt>, it throws an exception of type
+ * InitializationError with message: <tt>Unknown preconditioner</tt>.
+ */
+template <typename T>
+void LOBPCGMethod<T>::SetPreconditioner(const std::string &preconditioner) {
+    if (preconditioner != "none" && preconditioner != "jacobi" && preconditioner != "ichol") {
+        throw(InitializationError("Unknown preconditioner"));
+    }
+    _preconditioner = preconditioner;
+    _preconditioner_operator.reset();
+}
+
+/**
+ * @details If the given operator is null or its size differs from the size of the matrix, it throws an exception of type
+ * InitializationError with message: <tt>Attempting to set an invalid preconditioner</tt>.
+ */
+template <typename T>
+void LOBPCGMethod<T>::SetPreconditioner(const std::shared_ptr<const LinearOperator<T>> &preconditioner) {
+    if (!preconditioner || preconditioner->GetSize() != this->GetSize()) {
+        throw(InitializationError("Attempting to set an invalid preconditioner"));
+    }
+    _preconditioner = "operator";
+    _preconditioner_operator = preconditioner;
+}
+
+// PRECONDITIONER
+/**
+ * @details The preconditioners are computed from the matrix on which the method is executed, so that they are
+ * computed from the balanced matrix if the balancing is enabled; a dense matrix is converted to a sparse one for the
+ * incomplete Cholesky factorization. If a diagonal entry is zero, it throws an exception of type InitializationError with
+ * message: <tt>Unable to build the Jacobi preconditioner</tt>. If the incomplete Cholesky factorization fails, the
+ * message is <tt>Unable to build the incomplete Cholesky preconditioner</tt>.
+ */
+template <typename T>
+void LOBPCGMethod<T>::BuildPreconditioner() {
+    if (_preconditioner == "jacobi") {
+        _inverse_diagonal = this->_sparse ? Eigen::Vector<T, -1>(this->_A_sparse.diagonal())
+                                          : Eigen::Vector<T, -1>(this->WorkMatrix().diagonal());
+        if ((_inverse_diagonal.array() == T(0)).any()) {
+            throw(InitializationError("Unable to build the Jacobi preconditioner"));
+        }
+        _inverse_diagonal = _inverse_diagonal.cwiseInverse();
+    }
+    else if (_preconditioner == "ichol") {
+        Eigen::SparseMatrix<T> A = this->_sparse ? Eigen::SparseMatrix<T>(this->_A_sparse)
+                                                 : Eigen::SparseMatrix<T>(this->WorkMatrix().sparseView());
+        _ichol.compute(A);
+        if (_ichol.info() != Eigen::Success) {
+            throw(InitializationError("Unable to build the incomplete Cholesky preconditioner"));
+        }
+    }
+}
+
+template <typename T>
+void LOBPCGMethod<T>::Precondition(const Eigen::Matrix<T, -1, -1> &R, Eigen::Matrix<T, -1, -1> &W) const {
+    if (_preconditioner == "jacobi") {
+        W = _inverse_diagonal.asDiagonal() * R;
+    }
+    else if (_preconditioner == "ichol") {
+        W = _ichol.solve(R);
+    }
+    else if (_preconditioner == "operator") {
+        _preconditioner_operator->ApplyBlock(R, W);
+    }
+    else {
+        W = R;
+    }
+}
+
+// Orthonormal basis of the columns of a matrix, computed with the Householder QR factorization.
+template <typename T>
+static Eigen::Matrix<T, -1, -1> Orthonormalize(const Eigen::Matrix<T, -1, -1> &X) {
+    return Eigen::HouseholderQR<Eigen::Matrix<T, -1, -1>>(X).householderQ() * Eigen::Matrix<T, -1, -1>::Identity(X.rows(), X.cols());
+}
+
+// COMPUTATION OF EIGENVALUES
+/**
+ * @details The preconditioned residuals \f$W\f$ of the active, i.e. not converged, Ritz pairs are orthogonalized twice
+ * against \f$X\f$ and \f$P\f$ with the classical Gram-Schmidt process and orthonormalized with a QR factorization, so
+ * that the basis \f$S = [X, W, P]\f$ is orthonormal and the Rayleigh-Ritz projection is the eigenvalue problem of the
+ * Hermitian matrix \f$S^*AS\f$, whose eigenvectors \f$Z\f$ are sorted in ascending order of the eigenvalues. The new
+ * block is \f$X = SZ_1\f$, where \f$Z_1\f$ are the first \f$p\f$ columns of \f$Z\f$. The coefficients of the new search
+ * directions are the rows of \f$Z_1\f$ of the active columns along \f$W\f$ and \f$P\f$, orthogonalized against
+ * \f$Z_1\f$ and orthonormalized with a QR factorization \f$\hat{Q}\f$ of size \f$q \times p_a\f$: since \f$S\f$ is
+ * orthonormal, \f$P = S\hat{Q}\f$ is orthonormal and orthogonal to \f$X\f$, and \f$AP = AS\hat{Q}\f$. To allow zero
+ * eigenvalues, the tolerance is relative to \f$\max(|\theta_i|, \epsilon_m^{2/3} \max_j |\theta_j|)\f$, where
+ * \f$\epsilon_m\f$ is the machine precision.
+ *
+ * If the preconditioner <tt>jacobi</tt> or <tt>ichol</tt> is set and the matrix is given as a linear operator, it throws
+ * an exception of type InitializationError with message: <tt>Linear operators are not supported by this method</tt>.
+ * If the maximum number of iteration is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> LOBPCGMethod<T>::ComputeEigs() {
+    typedef Eigen::Matrix<T, -1, -1> Matrix;
+    int n = this->GetSize();
+    int k = _neigs;
+    int p = GetBlockSize();
+    double eps = std::pow(std::numeric_limits<double>::epsilon(), 2.0 / 3);
+    if (_preconditioner == "jacobi" || _preconditioner == "ichol") {
+        this->CheckStored();
+        BuildPreconditioner();
+    }
+
+    // Orthonormal initial block and its Ritz vectors
+    Matrix X = Orthonormalize<T>(this->RandomBlock(n, p));
+    Matrix AX, W, AW, P(n, 0), AP(n, 0), R, S, AS, Z;
+    this->ApplyMatrix(X, AX);
+    _products = p;
+    Eigen::SelfAdjointEigenSolver<Matrix> solver(X.adjoint() * AX);
+    X = X * solver.eigenvectors();
+    AX = AX * solver.eigenvectors();
+    Eigen::Vector<double, -1> theta = solver.eigenvalues();
+    std::vector<int> active;
+    int converged = 0;
+    int it = 0;
+
+    while (true) {
+        // Residuals of the Ritz pairs
+        R = AX - X * theta.template cast<T>().asDiagonal();
+        double threshold = eps * theta.cwiseAbs().maxCoeff();
+        active.clear();
+        converged = 0;
+        for (int i = 0; i < p; i++) {
+            if (R.col(i).norm() <= this->_tol * std::max(std::abs(theta(i)), threshold)) {
+                converged += (i < k);
+            }
+            else {
+                active.push_back(i);
+            }
+        }
+        if (converged == k || it == this->_maxit) {
+            break;
+        }
+        it++;
+
+        // Preconditioned residuals of the active Ritz pairs, orthonormalized against X and P
+        int pa = active.size();
+        Matrix Ra(n, pa);
+        for (int i = 0; i < pa; i++) {
+            Ra.col(i) = R.col(active[i]);
+        }
+        Precondition(Ra, W);
+        for (int pass = 0; pass < 2; pass++) {
+            W -= X * (X.adjoint() * W);
+            W -= P * (P.adjoint() * W);
+        }
+        W = Orthonormalize<T>(W);
+        this->ApplyMatrix(W, AW);
+        _products += pa;
+
+        // Rayleigh-Ritz projection on S = [X, W, P]
+        int q = p + pa + P.cols();
+        S.resize(n, q);
+        S << X, W, P;
+        AS.resize(n, q);
+        AS << AX, AW, AP;
+        Matrix H = S.adjoint() * AS;
+        solver.compute((H + H.adjoint()) / 2);
+        Z = solver.eigenvectors();
+        theta = solver.eigenvalues().head(p);
+        X.noalias() = S * Z.leftCols(p);
+        AX.noalias() = AS * Z.leftCols(p);
+
+        // New search directions: components of the active Ritz vectors along W and P, orthogonal to the new X
+        Matrix C = Matrix::Zero(q, pa);
+        for (int i = 0; i < pa; i++) {
+            C.col(i).tail(q - p) = Z.col(active[i]).tail(q - p);
+        }
+        C -= Z.leftCols(p) * (Z.leftCols(p).adjoint() * C);
+        C = Orthonormalize<T>(C);
+        P.noalias() = S * C;
+        AP.noalias() = AS * C;
+    }
+
+    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    this->_it = it;
+    if (converged < k){
+        throw(ConvergenceError("Reached maximum number of iterations"));
+    }
+
+    // Storing the eigenvectors, mapped back to the basis of A
+    _eigenvectors = X.leftCols(k);
+    if (this->_balance) {
+        this->_balancing.BackTransform(_eigenvectors);
+    }
+    _eigenvectors.colwise().normalize();
+    return theta.head(k).template cast<std::complex<double>>();
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class LOBPCGMethod<double>;
+template class LOBPCGMethod<std::complex<double>>;
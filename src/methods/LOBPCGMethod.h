@@ -0,0 +1,224 @@
+#ifndef LOBPCGMETHOD_H_
+#define LOBPCGMETHOD_H_
+
+#include "AbstractEigs.h"
+
+/** @class LOBPCGMethod
+ * @brief Class for computing the smallest eigenvalues of large symmetric or Hermitian positive definite matrices using
+ * the Locally Optimal Block Preconditioned Conjugate Gradient method.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The smallest eigenvalues of a symmetric or Hermitian matrix are the minima of the Rayleigh quotient
+ * \f$\rho(x) = x^*Ax / x^*x\f$ on nested subspaces, whose gradient at \f$x\f$ is proportional to the residual
+ * \f$r = Ax - \rho(x)x\f$. The LOBPCG method @cite Knyazev2001 minimizes the Rayleigh quotient of a block of \f$p\f$
+ * vectors \f$X\f$ with a Rayleigh-Ritz projection on the subspace spanned by
+ * \f[ S = [X, W, P], \qquad W = M(AX - X\Lambda), \f]
+ * where \f$\Lambda\f$ is the diagonal matrix of the Ritz values, \f$M\f$ is a preconditioner approximating
+ * \f$A^{-1}\f$ and \f$P\f$ contains the previous search directions, so that each iteration is a locally optimal step of
+ * a block conjugate gradient method. The new block \f$X\f$ contains the Ritz vectors of the \f$p\f$ smallest Ritz values
+ * and the new search directions are the components of the same Ritz vectors along \f$W\f$ and \f$P\f$. Therefore
+ * each iteration costs only the products of \f$A\f$ with the block \f$W\f$ and no factorization of \f$A\f$ is
+ * needed.
+ *
+ * The basis \f$S\f$ is kept orthonormal, orthogonalizing \f$W\f$ against \f$X\f$ and \f$P\f$ and computing the new
+ * directions \f$P\f$ orthonormal and orthogonal to the new \f$X\f$ from the coefficients of the small projected problem,
+ * so that the Rayleigh-Ritz projection is a standard eigenvalue problem also when the residuals are very small. The
+ * products of \f$A\f$ with \f$X\f$ and \f$P\f$ are updated with the same coefficients. The Ritz pairs are converged if
+ * \f$||Ax_i - \theta_ix_i|| \leq \epsilon |\theta_i|\f$, where \f$\epsilon\f$ is a prescribed tolerance; the converged
+ * vectors stay in \f$X\f$ but are removed from \f$W\f$ and \f$P\f$ (soft locking), so that they are not multiplied any
+ * more.
+ *
+ * The preconditioner is set with LOBPCGMethod::SetPreconditioner:
+ *  - <tt>none</tt> (default): \f$M = I\f$;
+ *  - <tt>jacobi</tt>: \f$M = diag(A)^{-1}\f$;
+ *  - <tt>ichol</tt>: \f$M = (LL^*)^{-1}\f$, where \f$L\f$ is the incomplete Cholesky factor of \f$A\f$, computed once
+ *  with the same sparsity pattern as the lower triangular part of \f$A\f$ after a fill-reducing ordering;
+ *  - a LinearOperator, for instance a FunctionOperator, applying any approximation of \f$A^{-1}\f$.
+ *  The preconditioner has to be symmetric or Hermitian positive definite. The convergence rate depends on the spectrum
+ *  of \f$MA\f$ instead of the one of \f$A\f$.
+ *
+ * The matrix can be given as a dense matrix, as a sparse matrix in compressed sparse row format or as a LinearOperator,
+ * which is assumed to be symmetric or Hermitian; for linear operators only the preconditioners <tt>none</tt> and the
+ * ones given as a LinearOperator are supported. For stored matrices, if the matrix is not symmetric or Hermitian, the
+ * constructors throw an exception of type InitializationError with message
+ * <tt>Attempting to set a non self-adjoint matrix</tt>. The initial block is pseudo-random, generated with a fixed
+ * seed. If the maximum number of iterations is reached the method is said to be non-convergent for the specific
+ * instance. The eigenvalues are returned in ascending order.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::SparseMatrix<double, Eigen::RowMajor> A = ...; // Symmetric positive definite
+    LOBPCGMethod<double> eigs_solver(A, 1e-8, 1000);
+    eigs_solver.SetNumEigs(5);
+    eigs_solver.SetPreconditioner("ichol");
+    std::cout << "The five smallest eigenvalues of A are:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class LOBPCGMethod : public AbstractEigs<T>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     * @details By default the smallest eigenvalue is computed.
+     */
+    LOBPCGMethod(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     * @details By default the smallest eigenvalue is computed.
+     */
+    LOBPCGMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    LOBPCGMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+     */
+    LOBPCGMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    LOBPCGMethod(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+     */
+    LOBPCGMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the number of eigenvalues with <tt>neigs</tt>, the block size with <tt>block</tt> and the
+     * name of the preconditioner, as <tt>std::string</tt>, with <tt>preconditioner</tt>.
+     */
+    LOBPCGMethod(std::map<std::string, std::any> &map);
+
+    // Destructor
+    virtual ~LOBPCGMethod() override {};
+
+    /**
+     * @brief Sets the number of eigenvalues to be computed.
+     * @param neigs Number of eigenvalues to be computed, at most one third of the size of the matrix.
+     */
+    void SetNumEigs(const int &neigs);
+
+    /**
+     * @brief Sets the number of vectors of the block.
+     * @param block_size Number of vectors of the block, not smaller than the number of eigenvalues and at most one third
+     * of the size of the matrix.
+     */
+    void SetBlockSize(const int &block_size);
+
+    /**
+     * @brief Sets the preconditioner given its name.
+     * @param preconditioner Name of the preconditioner: <tt>none</tt> (default), <tt>jacobi</tt> or <tt>ichol</tt>.
+     */
+    void SetPreconditioner(const std::string &preconditioner);
+
+    /**
+     * @brief Sets the preconditioner given as a linear operator.
+     * @param preconditioner Linear operator applying a symmetric or Hermitian positive definite approximation of
+     * \f$A^{-1}\f$.
+     */
+    void SetPreconditioner(const std::shared_ptr<const LinearOperator<T>> &preconditioner);
+
+    /**
+     * @brief Returns the number of eigenvalues to be computed.
+     */
+    int GetNumEigs() {return _neigs;};
+
+    /**
+     * @brief Returns the number of vectors of the block.
+     */
+    int GetBlockSize() {
+        return _block_size > 0 ? _block_size : std::max(_neigs, std::min(this->GetSize() / 3, _neigs + 5));
+    };
+
+    /**
+     * @brief Returns the name of the preconditioner, <tt>operator</tt> if it is given as a linear operator.
+     */
+    std::string GetPreconditioner() {return _preconditioner;};
+
+    /**
+     * @brief Returns the number of products of the matrix with a vector executed by the last call of ComputeEigs().
+     */
+    int GetProducts() {return _products;};
+
+    /**
+     * @brief Returns the approximations of the eigenvectors computed by the last call of ComputeEigs().
+     * @details The columns are normalized and expressed in the basis of the matrix \f$A\f$, even if the iterations are
+     * executed on the balanced matrix.
+     */
+    Eigen::Matrix<T, -1, -1> GetEigenvectors() {return _eigenvectors;};
+
+    /**
+     * @brief Returns the smallest eigenvalues computed using the LOBPCG method.
+     * @return Vector of complex numbers, with zero imaginary part, containing the requested eigenvalues in ascending
+     * order.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Number of eigenvalues to be computed.
+     * Default value: <tt>1</tt>.
+     */
+    int _neigs = 1;
+
+    /**
+     * @brief Number of vectors of the block.
+     * @details If zero, the block size is \f$\max(k, \min(n/3, k + 5))\f$, where \f$k\f$ is the number of eigenvalues.
+     * Default value: <tt>0</tt>.
+     */
+    int _block_size = 0;
+
+    /**
+     * @brief Name of the preconditioner.
+     * Default value: <tt>none</tt>.
+     */
+    std::string _preconditioner = "none";
+
+    /**
+     * @brief Preconditioner given as a linear operator.
+     */
+    std::shared_ptr<const LinearOperator<T>> _preconditioner_operator;
+
+    /**
+     * @brief Inverse of the diagonal of the matrix, for the preconditioner <tt>jacobi</tt>.
+     */
+    Eigen::Vector<T, -1> _inverse_diagonal;
+
+    /**
+     * @brief Incomplete Cholesky factorization of the matrix, for the preconditioner <tt>ichol</tt>.
+     */
+    Eigen::IncompleteCholesky<T, Eigen::Lower, Eigen::AMDOrdering<int>> _ichol;
+
+    /**
+     * @brief Number of products executed by the last call of ComputeEigs().
+     */
+    int _products = 0;
+
+    /**
+     * @brief Approximations of the eigenvectors computed by the last call of ComputeEigs().
+     */
+    Eigen::Matrix<T, -1, -1> _eigenvectors;
+
+    /**
+     * @brief Computes the preconditioner <tt>jacobi</tt> or <tt>ichol</tt> from the matrix.
+     */
+    void BuildPreconditioner();
+
+    /**
+     * @brief Applies the preconditioner to a block of vectors.
+     * @param R Block of residuals.
+     * @param W Block in which the result is written. It cannot be R.
+     */
+    void Precondition(const Eigen::Matrix<T, -1, -1> &R, Eigen::Matrix<T, -1, -1> &W) const;
+};
+
+#endif //LOBPCGMETHOD_H_
@@ -0,0 +1,356 @@
+#include "LanczosMethod.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// CONSTRUCTORS
+template <typename T>
+LanczosMethod<T>::LanczosMethod(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {
+    this->CheckSelfAdjoint();
+}
+
+template <typename T>
+LanczosMethod<T>::LanczosMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+: AbstractEigs<T>(A, tol, maxit) {
+    this->CheckSelfAdjoint();
+}
+
+template <typename T>
+LanczosMethod<T>::LanczosMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractEigs<T>(A) {
+    this->CheckSelfAdjoint();
+}
+
+template <typename T>
+LanczosMethod<T>::LanczosMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+: AbstractEigs<T>(A, tol, maxit) {
+    this->CheckSelfAdjoint();
+}
+
+/**
+ * @details At least the matrix has to be provided. If the number of eigenvalues is not provided, only the largest
+ * magnitude eigenvalue is computed and a warning is given to the user. If the subspace size, the selection rule or the
+ * reorthogonalization are not provided, they are set to the default value. If the tolerance or the maximum number of
+ * iterations are not provided, they are set to the default value and a warning is given to the user.
+ */
+template <typename T>
+LanczosMethod<T>::LanczosMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+    this->CheckSelfAdjoint();
+
+    // Getting and setting the number of eigenvalues
+    if (map.count("neigs") > 0) {
+        double neigs;
+        try {
+            neigs = std::any_cast<double>(map["neigs"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the number of eigenvalues to double"));
+        }
+        SetNumEigs(int(neigs));
+    }
+    else { // map.count("neigs") == 0
+        std::cerr << "WARNING: Unspecified number of eigenvalues (neigs). Set by default neigs = 1" << std::endl;
+    }
+
+    // Getting and setting the subspace size
+    if (map.count("subspace") > 0) {
+        double subspace_size;
+        try {
+            subspace_size = std::any_cast<double>(map["subspace"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the subspace size to double"));
+        }
+        SetSubspaceSize(int(subspace_size));
+    }
+
+    // Getting and setting the selection rule
+    if (map.count("selection") > 0) {
+        std::string selection;
+        try {
+            selection = std::any_cast<std::string>(map["selection"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the selection to string"));
+        }
+        SetSelection(selection);
+    }
+
+    // Getting and setting the reorthogonalization
+    if (map.count("reorthogonalization") > 0) {
+        std::string reorthogonalization;
+        try {
+            reorthogonalization = std::any_cast<std::string>(map["reorthogonalization"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the reorthogonalization to string"));
+        }
+        SetReorthogonalization(reorthogonalization);
+    }
+}
+
+// SETTING METHODS
+/**
+ * @details If the number of eigenvalues is not between one and the size of the matrix, it throws an exception of type
+ * InitializationError with message: <tt>Attempting to set a number of eigenvalues out of range</tt>. If a subspace size
+ * too small for the new number of eigenvalues was set, it is reset to the default one.
+ */
+template <typename T>
+void LanczosMethod<T>::SetNumEigs(const int &neigs) {
+    if (neigs <= 0 || neigs > this->GetSize()) {
+        throw(InitializationError("Attempting to set a number of eigenvalues out of range"));
+    }
+    _neigs = neigs;
+    if (_subspace_size < std::min(_neigs + 1, this->GetSize())) {
+        _subspace_size = 0;
+    }
+}
+
+/**
+ * @details If the subspace size is not larger than the number of eigenvalues, unless it is the size of the matrix, or
+ * if it is larger than the size of the matrix, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a subspace size out of range</tt>.
+ */
+template <typename T>
+void LanczosMethod<T>::SetSubspaceSize(const int &subspace_size) {
+    if (subspace_size < std::min(_neigs + 1, this->GetSize()) || subspace_size > this->GetSize()) {
+        throw(InitializationError("Attempting to set a subspace size out of range"));
+    }
+    _subspace_size = subspace_size;
+}
+
+/**
+ * @details If the rule is not one of <tt>magnitude</tt>, <tt>largest</tt> and <tt>smallest</tt>, it throws an
+ * exception of type InitializationError with message: <tt>Unknown selection rule</tt>.
+ */
+template <typename T>
+void LanczosMethod<T>::SetSelection(const std::string &selection) {
+    if (selection != "magnitude" && selection != "largest" && selection != "smallest") {
+        throw(InitializationError("Unknown selection rule"));
+    }
+    _selection = selection;
+}
+
+/**
+ * @details If the reorthogonalization is not one of <tt>partial</tt> and <tt>full</tt>, it throws an exception of
+ * type InitializationError with message: <tt>Unknown reorthogonalization</tt>.
+ */
+template <typename T>
+void LanczosMethod<T>::SetReorthogonalization(const std::string &reorthogonalization) {
+    if (reorthogonalization != "partial" && reorthogonalization != "full") {
+        throw(InitializationError("Unknown reorthogonalization"));
+    }
+    _reorthogonalization = reorthogonalization;
+}
+
+// LANCZOS FACTORIZATION
+/**
+ * @details Since \f$AV_{i+1} = V_{i+1}T_{i+1} + \beta_iv_{i+1}e_{i+1}^T\f$ up to rounding errors and \f$A\f$ and
+ * \f$T\f$ are self-adjoint, the estimates \f$\omega_{i+1,l} \approx v_{i+1}^*v_l\f$ for \f$l < i\f$ satisfy
+ * \f[ \beta_i\omega_{i+1,l} = \sum_p t_{lp}\omega_{i,p} - \sum_p \omega_{l,p}t_{pi} + \psi, \f]
+ * where the rounding errors are modelled by \f$\psi = \pm\epsilon_m ||T||\f$, with the sign of the other terms, and
+ * \f$\omega_{i+1,i} = \epsilon_m\f$. For the tridiagonal part of \f$T\f$ this is Simon's \f$\omega\f$-recurrence; it
+ * also holds for the row of the coupling coefficients left by the thick restart. The coefficients of the
+ * reorthogonalizations are \f$O(\sqrt{\epsilon_m})\f$ and are not added to \f$T\f$, so that the kept Ritz vectors
+ * satisfy \f$Ax_l = \theta_lx_l + \beta_mz_{m,l}v_{k'}\f$ only up to \f$O(\sqrt{\epsilon_m})\f$ and the recurrence
+ * cannot estimate the orthogonality against them: after a restart, every new vector is explicitly orthogonalized
+ * against the \f$k'\f$ kept Ritz vectors (selective orthogonalization), at the cost of \f$O(nk')\f$ operations, and
+ * the estimates are computed only for the vectors generated after the restart. When the largest estimate exceeds
+ * \f$\sqrt{\epsilon_m}\f$, the vector is orthogonalized against the whole basis with the classical Gram-Schmidt process,
+ * repeated once if the norm of the vector is reduced by more than a factor \f$1/\sqrt{2}\f$, and so is the following
+ * one, since its estimates are computed from the ones of the current vector. The estimates are then reset to
+ * \f$\epsilon_m\f$.
+ */
+template <typename T>
+void LanczosMethod<T>::Extend(Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<double, -1, -1> &Tm,
+                              Eigen::Matrix<double, -1, -1> &omega, const int &j, double &beta) {
+    int n = V.rows();
+    int m = Tm.cols();
+    double eps = std::numeric_limits<double>::epsilon();
+    bool full = (_reorthogonalization == "full");
+    bool reorthogonalize_next = (j > 0);
+    Eigen::Vector<T, -1> v(n), w(n), c;
+    Eigen::Vector<double, -1> a, b;
+
+    for (int i = j; i < m; i++) {
+        v = V.col(i);
+        this->ApplyMatrix(v, w);
+        _products++;
+
+        // Three-term recurrence, or orthogonalization against the kept Ritz vectors after a restart
+        if (i == j && j > 0) {
+            w.noalias() -= V.leftCols(i) * Tm.col(i).head(i).template cast<T>();
+        }
+        else if (i > 0) {
+            w -= Tm(i - 1, i) * V.col(i - 1);
+        }
+        double alpha = std::real(v.dot(w));
+        w -= alpha * v;
+        Tm(i, i) = alpha;
+        if (i > j && j > 0 && !full) {
+            // Selective orthogonalization against the kept Ritz vectors
+            c.noalias() = V.leftCols(j).adjoint() * w;
+            w.noalias() -= V.leftCols(j) * c;
+        }
+        beta = w.norm();
+
+        // Estimates of the loss of orthogonality
+        bool reorthogonalize = full || reorthogonalize_next;
+        reorthogonalize_next = false;
+        omega(i + 1, i + 1) = 1;
+        if (i > 0 && !reorthogonalize) {
+            a.noalias() = Tm.topLeftCorner(i + 1, i + 1) * omega.row(i).head(i + 1).transpose();
+            b.noalias() = omega.topLeftCorner(i + 1, i + 1) * Tm.col(i).head(i + 1);
+            double psi = eps * Tm.topLeftCorner(i + 1, i + 1).norm();
+            omega.row(i + 1).head(j).setConstant(eps);
+            for (int l = j; l < i; l++) {
+                double estimate = a(l) - b(l);
+                omega(i + 1, l) = (estimate + (estimate >= 0 ? psi : -psi)) / beta;
+            }
+            reorthogonalize = omega.row(i + 1).segment(j, i - j).cwiseAbs().maxCoeff() > std::sqrt(eps);
+            reorthogonalize_next = reorthogonalize;
+        }
+
+        // Orthogonalization against the whole basis
+        if (reorthogonalize) {
+            for (int pass = 0; pass < 2; pass++) {
+                c.noalias() = V.leftCols(i + 1).adjoint() * w;
+                w.noalias() -= V.leftCols(i + 1) * c;
+                double norm = w.norm();
+                if (norm >= M_SQRT1_2 * beta) {
+                    beta = norm;
+                    break;
+                }
+                beta = norm;
+            }
+            omega.row(i + 1).head(i + 1).setConstant(eps);
+            _reorthogonalizations++;
+        }
+        omega(i + 1, i) = eps;
+        omega.col(i + 1).head(i + 1) = omega.row(i + 1).head(i + 1).transpose();
+
+        // Invariant subspace: the new vector is pseudo-random, orthogonalized twice
+        if (beta <= eps * std::max(std::abs(alpha), Tm.col(i).norm())) {
+            beta = 0;
+            w = this->RandomBlock(n, i + 2).col(i + 1);
+            for (int pass = 0; pass < 2; pass++) {
+                w -= V.leftCols(i + 1) * (V.leftCols(i + 1).adjoint() * w);
+            }
+            V.col(i + 1) = w.normalized();
+        }
+        else {
+            V.col(i + 1) = w / beta;
+        }
+        if (i + 1 < m) {
+            Tm(i + 1, i) = Tm(i, i + 1) = beta;
+        }
+    }
+}
+
+// COMPUTATION OF EIGENVALUES
+/**
+ * @details The method starts from the normalized pseudo-random vector given by AbstractEigs::RandomBlock. After each
+ * extension of the factorization to size \f$m\f$, the eigenpairs of the real symmetric matrix \f$T_m\f$ are computed
+ * and sorted according to the selection rule, and the first \f$k\f$ are tested for convergence with the residual
+ * estimate \f$\beta_m |z_{m,i}|\f$. To allow zero eigenvalues, the tolerance is relative to
+ * \f$\max(|\theta_i|, \epsilon_m^{2/3} ||T_m||_2)\f$.
+ *
+ * At each restart \f$k' \geq k\f$ Ritz vectors are kept, where \f$k'\f$ is increased by half of the number of
+ * converged Ritz pairs, as in ARPACK, to avoid the stagnation of the method when the wanted Ritz values are close to the
+ * unwanted ones.
+ *
+ * If the maximum number of iteration is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> LanczosMethod<T>::ComputeEigs() {
+    int n = this->GetSize();
+    int k = _neigs;
+    int m = GetSubspaceSize();
+    double eps = std::pow(std::numeric_limits<double>::epsilon(), 2.0 / 3);
+    _products = 0;
+    _reorthogonalizations = 0;
+
+    // Lanczos factorization of size m, with the basis in the first m columns of V and residual beta * V(:, m)
+    Eigen::Matrix<T, -1, -1> V(n, m + 1), X;
+    Eigen::Matrix<double, -1, -1> Tm = Eigen::Matrix<double, -1, -1>::Zero(m, m);
+    Eigen::Matrix<double, -1, -1> omega = Eigen::Matrix<double, -1, -1>::Identity(m + 1, m + 1);
+    V.col(0) = this->RandomBlock(n, 1).normalized();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, -1, -1>> solver;
+    std::vector<int> sorted(m);
+    double beta;
+    int j = 0; // Current size of the factorization
+    int converged = 0; // Number of converged Ritz pairs
+    int it = 0;
+
+    while (true) {
+        Extend(V, Tm, omega, j, beta);
+        it++;
+
+        // Ritz pairs sorted according to the selection rule, and their residual estimates
+        solver.compute(Tm);
+        const Eigen::Vector<double, -1> &theta = solver.eigenvalues();
+        const Eigen::Matrix<double, -1, -1> &Z = solver.eigenvectors();
+        std::iota(sorted.begin(), sorted.end(), 0);
+        if (_selection == "magnitude") {
+            std::stable_sort(sorted.begin(), sorted.end(),
+                             [&theta](int a, int b) {return std::abs(theta(a)) > std::abs(theta(b));});
+        }
+        else if (_selection == "largest") {
+            std::reverse(sorted.begin(), sorted.end());
+        }
+        double threshold = eps * theta.cwiseAbs().maxCoeff();
+        converged = 0;
+        for (int i = 0; i < k; i++) {
+            double res = beta * std::abs(Z(m - 1, sorted[i]));
+            if (res <= this->_tol * std::max(std::abs(theta(sorted[i])), threshold)) {
+                converged++;
+            }
+        }
+        if (converged >= k || it == this->_maxit) {
+            break;
+        }
+
+        // Thick restart with the first kept Ritz vectors and the residual as the next vector of the basis
+        int kept = k + std::min(converged, (m - k) / 2);
+        Eigen::Matrix<double, -1, -1> Y(m, kept);
+        for (int i = 0; i < kept; i++) {
+            Y.col(i) = Z.col(sorted[i]);
+        }
+        X.noalias() = V.leftCols(m) * Y.template cast<T>();
+        V.leftCols(kept) = X;
+        V.col(kept) = V.col(m);
+        Tm.setZero();
+        for (int i = 0; i < kept; i++) {
+            Tm(i, i) = theta(sorted[i]);
+            Tm(i, kept) = Tm(kept, i) = beta * Y(m - 1, i);
+        }
+        omega.setConstant(std::numeric_limits<double>::epsilon());
+        omega.diagonal().setOnes();
+        j = kept;
+    }
+
+    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    this->_it = it;
+    if (converged < k){
+        throw(ConvergenceError("Reached maximum number of iterations"));
+    }
+
+    // Storing the eigenvectors, mapped back to the basis of A
+    Eigen::Vector<std::complex<double>, -1> eigenvalues(k);
+    Eigen::Matrix<double, -1, -1> Y(m, k);
+    for (int i = 0; i < k; i++) {
+        eigenvalues(i) = solver.eigenvalues()(sorted[i]);
+        Y.col(i) = solver.eigenvectors().col(sorted[i]);
+    }
+    _eigenvectors.noalias() = V.leftCols(m) * Y.template cast<T>();
+    if (this->_balance) {
+        this->_balancing.BackTransform(_eigenvectors);
+    }
+    _eigenvectors.colwise().normalize();
+    return eigenvalues;
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class LanczosMethod<double>;
+template class LanczosMethod<std::complex<double>>;
@@ -0,0 +1,230 @@
+#ifndef LANCZOSMETHOD_H_
+#define LANCZOSMETHOD_H_
+
+#include "AbstractEigs.h"
+
+/** @class LanczosMethod
+ * @brief Class for computing a few eigenvalues of large symmetric or Hermitian matrices using the thick-restart Lanczos
+ * method with partial reorthogonalization.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details For a symmetric or Hermitian matrix the Hessenberg matrix of the Arnoldi factorization (see ArnoldiMethod) is
+ * real, symmetric and tridiagonal, so that the new vector of the basis is obtained with the three-term recurrence
+ * @cite GolubVanLoan
+ * \f[ \beta_jv_{j+1} = Av_j - \alpha_jv_j - \beta_{j-1}v_{j-1}, \qquad \alpha_j = v_j^*Av_j, \f]
+ * at the cost of one product with \f$A\f$ and \f$O(n)\f$ operations, instead of an orthogonalization against the whole
+ * basis. In floating point arithmetic the vectors lose their orthogonality as soon as a Ritz pair converges, and copies
+ * of the converged eigenvalues appear among the Ritz values. The loss of orthogonality is not measured but estimated:
+ * the levels \f$\omega_{j,i} \approx v_j^*v_i\f$ satisfy a recurrence with the same coefficients \f$\alpha_j, \beta_j\f$
+ * (Simon's \f$\omega\f$-recurrence), which costs \f$O(m^2)\f$ operations per step, independently of \f$n\f$. Only when
+ * the estimate exceeds \f$\sqrt{\epsilon_m}\f$, where \f$\epsilon_m\f$ is the machine precision, the new vector and the
+ * following one are orthogonalized against the whole basis (partial reorthogonalization), which keeps the orthogonality
+ * at the level \f$\sqrt{\epsilon_m}\f$, enough for the Ritz values to be accurate to the machine precision. The
+ * reorthogonalization can also be executed at every step, calling LanczosMethod::SetReorthogonalization with
+ * <tt>full</tt>.
+ *
+ * When the basis reaches \f$m\f$ vectors, the method is restarted keeping the \f$k' \geq k\f$ wanted Ritz vectors
+ * (thick restart): the next vector of the basis is the residual of the factorization, which is orthogonal to all of
+ * them, and the projected matrix becomes the diagonal matrix of the kept Ritz values bordered by the row of the
+ * coupling coefficients \f$\beta_mz_{m,i}\f$, followed by a new tridiagonal part. The first step after the restart
+ * orthogonalizes against the kept Ritz vectors, the following ones use the three-term recurrence again, and every new
+ * vector is also orthogonalized against the kept Ritz vectors only, which are the directions in which the orthogonality
+ * is lost first (selective orthogonalization). Therefore the memory cost is \f$O(nm)\f$ for the basis, no Hessenberg QR
+ * steps are needed to restart and each restart costs \f$m - k'\f$ products with \f$A\f$. The Ritz pair is converged if \f$\beta_m |z_{m,i}| \leq \epsilon |\theta_i|\f$,
+ * where \f$\epsilon\f$ is a prescribed tolerance.
+ *
+ * The wanted eigenvalues are chosen with LanczosMethod::SetSelection: <tt>magnitude</tt> (default) for the largest
+ * magnitude ones, <tt>largest</tt> for the largest and <tt>smallest</tt> for the smallest. The matrix can be given as a
+ * dense matrix, as a sparse matrix in compressed sparse row format or as a LinearOperator, which is assumed to be
+ * symmetric or Hermitian. For stored matrices, if the matrix is not symmetric or Hermitian, the constructors throw an
+ * exception of type InitializationError with message <tt>Attempting to set a non self-adjoint matrix</tt>. The
+ * starting vector is pseudo-random, generated with a fixed seed. The maximum number of iterations bounds the number of
+ * restarts. If it is reached the method is said to be non-convergent for the specific instance.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::SparseMatrix<double, Eigen::RowMajor> L = ...; // Laplacian
+    LanczosMethod<double> eigs_solver(L, 1e-10, 1000);
+    eigs_solver.SetNumEigs(10);
+    eigs_solver.SetSelection("smallest");
+    std::cout << "The ten smallest eigenvalues of L are:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class LanczosMethod : public AbstractEigs<T>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     * @details By default the largest magnitude eigenvalue is computed.
+     */
+    LanczosMethod(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     * @details By default the largest magnitude eigenvalue is computed.
+     */
+    LanczosMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    LanczosMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+     */
+    LanczosMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit);
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    LanczosMethod(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+     */
+    LanczosMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the number of eigenvalues with <tt>neigs</tt>, the size of the subspace with
+     * <tt>subspace</tt>, the selection rule, as <tt>std::string</tt>, with <tt>selection</tt> and the
+     * reorthogonalization, as <tt>std::string</tt>, with <tt>reorthogonalization</tt>.
+     */
+    LanczosMethod(std::map<std::string, std::any> &map);
+
+    // Destructor
+    virtual ~LanczosMethod() override {};
+
+    /**
+     * @brief Sets the number of eigenvalues to be computed.
+     * @param neigs Number of eigenvalues to be computed.
+     */
+    void SetNumEigs(const int &neigs);
+
+    /**
+     * @brief Sets the maximum size of the Krylov subspace.
+     * @param subspace_size Number \f$m\f$ of vectors of the basis before each restart, larger than the number of
+     * eigenvalues or equal to the size of the matrix.
+     */
+    void SetSubspaceSize(const int &subspace_size);
+
+    /**
+     * @brief Sets the rule selecting the wanted eigenvalues.
+     * @param selection Name of the rule: <tt>magnitude</tt> (default), <tt>largest</tt> or <tt>smallest</tt>.
+     */
+    void SetSelection(const std::string &selection);
+
+    /**
+     * @brief Sets when the new vectors are orthogonalized against the whole basis.
+     * @param reorthogonalization <tt>partial</tt> (default) when the estimated loss of orthogonality exceeds
+     * \f$\sqrt{\epsilon_m}\f$, <tt>full</tt> at every step.
+     */
+    void SetReorthogonalization(const std::string &reorthogonalization);
+
+    /**
+     * @brief Returns the number of eigenvalues to be computed.
+     */
+    int GetNumEigs() {return _neigs;};
+
+    /**
+     * @brief Returns the maximum size of the Krylov subspace.
+     */
+    int GetSubspaceSize() {
+        return _subspace_size > 0 ? _subspace_size : std::min(this->GetSize(), std::max(2 * _neigs + 1, 20));
+    };
+
+    /**
+     * @brief Returns the rule selecting the wanted eigenvalues.
+     */
+    std::string GetSelection() {return _selection;};
+
+    /**
+     * @brief Returns when the new vectors are orthogonalized against the whole basis.
+     */
+    std::string GetReorthogonalization() {return _reorthogonalization;};
+
+    /**
+     * @brief Returns the number of products with the matrix executed by the last call of ComputeEigs().
+     */
+    int GetProducts() {return _products;};
+
+    /**
+     * @brief Returns the number of orthogonalizations against the whole basis executed by the last call of
+     * ComputeEigs().
+     */
+    int GetReorthogonalizations() {return _reorthogonalizations;};
+
+    /**
+     * @brief Returns the approximations of the eigenvectors computed by the last call of ComputeEigs().
+     * @details The columns are normalized and expressed in the basis of the matrix \f$A\f$, even if the iterations are
+     * executed on the balanced matrix.
+     */
+    Eigen::Matrix<T, -1, -1> GetEigenvectors() {return _eigenvectors;};
+
+    /**
+     * @brief Returns the eigenvalues computed using the thick-restart Lanczos method.
+     * @return Vector of complex numbers, with zero imaginary part, containing the requested eigenvalues in the order
+     * of the selection rule: descending magnitude, descending or ascending order.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Number of eigenvalues to be computed.
+     * Default value: <tt>1</tt>.
+     */
+    int _neigs = 1;
+
+    /**
+     * @brief Maximum size of the Krylov subspace.
+     * @details If zero, the size is \f$\min(n, \max(2k + 1, 20))\f$, where \f$k\f$ is the number of eigenvalues.
+     * Default value: <tt>0</tt>.
+     */
+    int _subspace_size = 0;
+
+    /**
+     * @brief Rule selecting the wanted eigenvalues.
+     * Default value: <tt>magnitude</tt>.
+     */
+    std::string _selection = "magnitude";
+
+    /**
+     * @brief When the new vectors are orthogonalized against the whole basis.
+     * Default value: <tt>partial</tt>.
+     */
+    std::string _reorthogonalization = "partial";
+
+    /**
+     * @brief Number of products executed by the last call of ComputeEigs().
+     */
+    int _products = 0;
+
+    /**
+     * @brief Number of orthogonalizations against the whole basis executed by the last call of ComputeEigs().
+     */
+    int _reorthogonalizations = 0;
+
+    /**
+     * @brief Approximations of the eigenvectors computed by the last call of ComputeEigs().
+     */
+    Eigen::Matrix<T, -1, -1> _eigenvectors;
+
+    /**
+     * @brief Extends the Lanczos factorization from size \f$j\f$ to size \f$m\f$.
+     * @param V Matrix whose first \f$j+1\f$ columns are the orthonormal basis; on exit its \f$m+1\f$ columns.
+     * @param Tm Projected matrix of size \f$m\f$, whose leading block of size \f$j+1\f$ is set, except its last
+     * diagonal entry; on exit all its entries.
+     * @param omega Estimates of the inner products of the vectors of the basis, of size \f$m+1\f$; its leading block of
+     * size \f$j+1\f$ is set.
+     * @param j Current size of the factorization. If positive, the factorization has just been restarted and the
+     * first step orthogonalizes against all the previous vectors.
+     * @param beta Norm of the residual of the factorization of size \f$m\f$, computed on exit.
+     */
+    void Extend(Eigen::Matrix<T, -1, -1> &V, Eigen::Matrix<double, -1, -1> &Tm, Eigen::Matrix<double, -1, -1> &omega,
+                const int &j, double &beta);
+};
+
+#endif //LANCZOSMETHOD_H_
@@ -0,0 +1,25 @@
+#include "LinearOperator.h"
+
+template <typename T>
+void LinearOperator<T>::ApplyBlock(const Eigen::Matrix<T, -1, -1> &X, Eigen::Matrix<T, -1, -1> &Y) const {
+    Y.resize(X.rows(), X.cols());
+    Eigen::Vector<T, -1> x(X.rows()), y(X.rows());
+    for (int j = 0; j < X.cols(); j++) {
+        x = X.col(j);
+        Apply(x, y);
+        Y.col(j) = y;
+    }
+}
+
+template <typename T>
+FunctionOperator<T>::FunctionOperator(const int &n, const Function &apply) : _n(n), _apply(apply) {
+    if (n < 0) {
+        throw(InitializationError("Attempting to set an operator with negative size"));
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class LinearOperator<double>;
+template class LinearOperator<std::complex<double>>;
+template class FunctionOperator<double>;
+template class FunctionOperator<std::complex<double>>;
@@ -0,0 +1,114 @@
+#ifndef LINEAROPERATOR_H_
+#define LINEAROPERATOR_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include <functional>
+#include "Exceptions.h"
+
+/** @class LinearOperator
+ * @brief Abstract class for square linear operators that are known only through their action on vectors.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>. It is the scalar type of the operator.
+ * @details Many matrices are never stored explicitly: stencils, products of factors or convolutions are applied to a
+ * vector by a procedure whose cost and memory are much lower than the ones of a product with the stored matrix. The
+ * methods that only need products with the matrix, i.e. PowerMethod and ShiftPowerMethod, can iterate on a
+ * LinearOperator instead of a matrix, with memory cost \f$O(n)\f$.
+ *
+ * A derived class has to define the size of the operator and its action on a vector, LinearOperator::Apply. The action
+ * on a block of vectors, LinearOperator::ApplyBlock, applies the operator column by column by default and can be
+ * overridden by operators that have a faster block kernel.
+ *
+ * For operators given by a function, FunctionOperator can be used without defining a derived class.
+ */
+template <typename T> class LinearOperator {
+public:
+    /**
+     * @brief Scalar type of the operator.
+     */
+    typedef T Scalar;
+
+    // Destructor
+    virtual ~LinearOperator() {};
+
+    /**
+     * @brief Returns the size \f$n\f$ of the operator, which maps vectors of size \f$n\f$ to vectors of size \f$n\f$.
+     */
+    virtual int GetSize() const = 0;
+
+    /**
+     * @brief Applies the operator to a vector.
+     * @param x Vector of size \f$n\f$.
+     * @param y Vector of size \f$n\f$ in which the result \f$y = Ax\f$ is written. It is already of size \f$n\f$ and
+     * different from x.
+     */
+    virtual void Apply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) const = 0;
+
+    /**
+     * @brief Applies the operator to a block of vectors.
+     * @param X Matrix with \f$n\f$ rows, whose columns are the vectors to which the operator is applied.
+     * @param Y Matrix of the same size of X in which the result \f$Y = AX\f$ is written.
+     */
+    virtual void ApplyBlock(const Eigen::Matrix<T, -1, -1> &X, Eigen::Matrix<T, -1, -1> &Y) const;
+};
+
+/** @class FunctionOperator
+ * @brief Class for linear operators whose action on a vector is given by a function.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details If the given size is negative, the constructor throws an exception of type InitializationError with
+ * message <tt>Attempting to set an operator with negative size</tt>.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    // Discrete 1D Laplacian of size n, never stored
+    int n = 1000000;
+    auto laplacian = std::make_shared<FunctionOperator<double>>(n,
+        [n](const Eigen::Vector<double, -1> &x, Eigen::Vector<double, -1> &y) {
+            y = 2 * x;
+            y.head(n - 1) -= x.tail(n - 1);
+            y.tail(n - 1) -= x.head(n - 1);
+        });
+    PowerMethod<double> eigs_solver(laplacian);
+    std::cout << "The largest eigenvalue of the Laplacian is:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class FunctionOperator : public LinearOperator<T> {
+public:
+    /**
+     * @brief Type of the function applying the operator, writing \f$Ax\f$ in its second argument.
+     */
+    typedef std::function<void(const Eigen::Vector<T, -1> &, Eigen::Vector<T, -1> &)> Function;
+
+    /**
+     * @brief Constructor; sets the size of the operator and the function applying it.
+     * @param n Size of the operator.
+     * @param apply Function applying the operator to a vector.
+     */
+    FunctionOperator(const int &n, const Function &apply);
+
+    // Destructor
+    virtual ~FunctionOperator() override {};
+
+    /**
+     * @copydoc LinearOperator::GetSize
+     */
+    int GetSize() const override {return _n;};
+
+    /**
+     * @copydoc LinearOperator::Apply
+     */
+    void Apply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) const override {_apply(x, y);};
+
+private:
+
+    /**
+     * @brief Size of the operator.
+     */
+    int _n;
+
+    /**
+     * @brief Function applying the operator to a vector.
+     */
+    Function _apply;
+};
+
+#endif //LINEAROPERATOR_H_
@@ -0,0 +1,105 @@
+#include "PlanarLU.h"
+#include "CpuDispatch.h"
+#include "KernelTargets.h"
+
+// FORWARD AND BACKWARD SUBSTITUTIONS
+/*
+ * The solution overwrites the right-hand side xd, interleaved. At step j the known entry j is eliminated from the
+ * following (forward) or previous (backward) entries with column j of the factor, read with unit stride from the two
+ * planes.
+ */
+KERNEL_INLINE void PlanarSubstitutionsBody(const double *LUr, const double *LUi, const double *inverse_diagonal,
+                                           double *xd, const int &n) {
+    // Forward substitution with the unit lower triangular factor L
+    for (int j = 0; j < n - 1; j++) {
+        const double *lr = LUr + (long) j * n, *li = LUi + (long) j * n;
+        double xr = xd[2 * j], xi = xd[2 * j + 1];
+        KERNEL_SIMD
+        for (int i = j + 1; i < n; i++) {
+            xd[2 * i] -= lr[i] * xr - li[i] * xi;
+            xd[2 * i + 1] -= lr[i] * xi + li[i] * xr;
+        }
+    }
+    // Backward substitution with the upper triangular factor U
+    for (int j = n - 1; j >= 0; j--) {
+        const double *ur = LUr + (long) j * n, *ui = LUi + (long) j * n;
+        double dr = inverse_diagonal[2 * j], di = inverse_diagonal[2 * j + 1];
+        double xr = xd[2 * j] * dr - xd[2 * j + 1] * di;
+        double xi = xd[2 * j] * di + xd[2 * j + 1] * dr;
+        xd[2 * j] = xr;
+        xd[2 * j + 1] = xi;
+        KERNEL_SIMD
+        for (int i = 0; i < j; i++) {
+            xd[2 * i] -= ur[i] * xr - ui[i] * xi;
+            xd[2 * i + 1] -= ur[i] * xi + ui[i] * xr;
+        }
+    }
+}
+
+static void PlanarSubstitutionsBaseline(const double *LUr, const double *LUi, const double *inverse_diagonal,
+                                        double *xd, const int &n) {
+    PlanarSubstitutionsBody(LUr, LUi, inverse_diagonal, xd, n);
+}
+
+#ifdef KERNEL_MULTIVERSIONING
+KERNEL_AVX2
+static void PlanarSubstitutionsAvx2(const double *LUr, const double *LUi, const double *inverse_diagonal,
+                                    double *xd, const int &n) {
+    PlanarSubstitutionsBody(LUr, LUi, inverse_diagonal, xd, n);
+}
+
+KERNEL_AVX512
+static void PlanarSubstitutionsAvx512(const double *LUr, const double *LUi, const double *inverse_diagonal,
+                                      double *xd, const int &n) {
+    PlanarSubstitutionsBody(LUr, LUi, inverse_diagonal, xd, n);
+}
+#endif
+
+static void PlanarSubstitutions(const double *LUr, const double *LUi, const double *inverse_diagonal, double *xd,
+                                const int &n) {
+#ifdef KERNEL_MULTIVERSIONING
+    switch (CpuDispatch::GetPath()) {
+        case CpuDispatch::AVX512: PlanarSubstitutionsAvx512(LUr, LUi, inverse_diagonal, xd, n); return;
+        case CpuDispatch::AVX2: PlanarSubstitutionsAvx2(LUr, LUi, inverse_diagonal, xd, n); return;
+        default: break;
+    }
+#endif
+    PlanarSubstitutionsBaseline(LUr, LUi, inverse_diagonal, xd, n);
+}
+
+// REAL MATRICES
+template <>
+void PlanarLU<double>::Compute(const Eigen::Matrix<double, -1, -1> &A) {
+    _lu.compute(A);
+}
+
+template <>
+void PlanarLU<double>::Solve(const Eigen::Vector<double, -1> &b, Eigen::Vector<double, -1> &x) const {
+    x = _lu.solve(b);
+}
+
+// COMPLEX MATRICES
+/**
+ * @details The factorization computed by Eigen is discarded once its factors are copied in planar layout, so that the
+ * memory used is the same of the interleaved factors.
+ */
+template <>
+void PlanarLU<std::complex<double>>::Compute(const Eigen::Matrix<std::complex<double>, -1, -1> &A) {
+    Eigen::PartialPivLU<Eigen::Matrix<std::complex<double>, -1, -1>> lu(A);
+    _real = lu.matrixLU().real();
+    _imag = lu.matrixLU().imag();
+    _inverse_diagonal = lu.matrixLU().diagonal().cwiseInverse();
+    _permutation = lu.permutationP();
+}
+
+template <>
+void PlanarLU<std::complex<double>>::Solve(const Eigen::Vector<std::complex<double>, -1> &b,
+                                           Eigen::Vector<std::complex<double>, -1> &x) const {
+    x.noalias() = _permutation * b;
+    PlanarSubstitutions(_real.data(), _imag.data(), reinterpret_cast<const double *>(_inverse_diagonal.data()),
+                        reinterpret_cast<double *>(x.data()), x.size());
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class PlanarLU<double>;
+template class PlanarLU<std::complex<double>>;
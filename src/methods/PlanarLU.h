@@ -0,0 +1,65 @@
+#ifndef PLANARLU_H_
+#define PLANARLU_H_
+
+#include <Eigen/Dense>
+#include <complex>
+
+/** @class PlanarLU
+ * @brief Class computing the LU factorization with partial pivoting of a dense matrix and storing its factors in planar
+ * layout, for fast solutions of linear systems.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The factorization \f$PA = LU\f$ is computed once by <tt>Eigen::PartialPivLU</tt>, which is blocked. The
+ * solutions of the systems, repeated at each iteration of the inverse power methods, are then executed on the factors
+ * stored in planar layout, with the real and the imaginary parts in separate arrays (see PlanarMatrix): the forward
+ * and backward substitutions run column by column, reading the factors with unit stride and using only real
+ * multiply-adds. The diagonal of \f$U\f$ is inverted once, so that the substitutions do not divide complex numbers.
+ *
+ * For real matrices the planar layout coincides with the usual one and the systems are solved by
+ * <tt>Eigen::PartialPivLU</tt>.
+ *
+ * The substitutions are compiled for several instruction sets and the one used is selected at run time.
+ * @see CpuDispatch
+ */
+template <typename T> class PlanarLU {
+public:
+    /**
+     * @brief Computes the factorization of the given matrix.
+     * @param A Square matrix.
+     */
+    void Compute(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Solves \f$Ax = b\f$ with the computed factorization, writing the solution in the given vector.
+     * @param b Right-hand side.
+     * @param x Solution, resized only if its size is wrong. It cannot be \f$b\f$.
+     */
+    void Solve(const Eigen::Vector<T, -1> &b, Eigen::Vector<T, -1> &x) const;
+
+private:
+    /**
+     * @brief LU factorization with partial pivoting, stored only for real matrices.
+     */
+    Eigen::PartialPivLU<Eigen::Matrix<T, -1, -1>> _lu;
+
+    /**
+     * @brief Permutation \f$P\f$ of the rows.
+     */
+    Eigen::PermutationMatrix<-1, -1> _permutation;
+
+    /**
+     * @brief Real part of the factors \f$L\f$ and \f$U\f$, packed in one matrix.
+     */
+    Eigen::Matrix<double, -1, -1> _real;
+
+    /**
+     * @brief Imaginary part of the factors \f$L\f$ and \f$U\f$, packed in one matrix.
+     */
+    Eigen::Matrix<double, -1, -1> _imag;
+
+    /**
+     * @brief Inverses of the diagonal entries of \f$U\f$.
+     */
+    Eigen::Vector<T, -1> _inverse_diagonal;
+};
+
+#endif //PLANARLU_H_
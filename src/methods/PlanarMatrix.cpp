@@ -0,0 +1,102 @@
+#include "PlanarMatrix.h"
+#include "CpuDispatch.h"
+#include "IterationKernels.h"
+#include "KernelTargets.h"
+
+// MATRIX-VECTOR PRODUCT
+/*
+ * Four columns are accumulated at a time, so that y is read and written once every four columns of A. The matrix is
+ * read with unit stride from the two planes, the vectors are interleaved.
+ */
+KERNEL_INLINE void PlanarGemvBody(const double *Ar, const double *Ai, const double *xd, double *yd, const int &rows,
+                                  const int &cols) {
+    for (int i = 0; i < 2 * rows; i++) {
+        yd[i] = 0;
+    }
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+        const double *ar0 = Ar + (long) j * rows, *ar1 = ar0 + rows, *ar2 = ar1 + rows, *ar3 = ar2 + rows;
+        const double *ai0 = Ai + (long) j * rows, *ai1 = ai0 + rows, *ai2 = ai1 + rows, *ai3 = ai2 + rows;
+        double x0r = xd[2 * j], x0i = xd[2 * j + 1], x1r = xd[2 * j + 2], x1i = xd[2 * j + 3];
+        double x2r = xd[2 * j + 4], x2i = xd[2 * j + 5], x3r = xd[2 * j + 6], x3i = xd[2 * j + 7];
+        KERNEL_SIMD
+        for (int i = 0; i < rows; i++) {
+            yd[2 * i] += ar0[i] * x0r - ai0[i] * x0i + ar1[i] * x1r - ai1[i] * x1i
+                         + ar2[i] * x2r - ai2[i] * x2i + ar3[i] * x3r - ai3[i] * x3i;
+            yd[2 * i + 1] += ar0[i] * x0i + ai0[i] * x0r + ar1[i] * x1i + ai1[i] * x1r
+                             + ar2[i] * x2i + ai2[i] * x2r + ar3[i] * x3i + ai3[i] * x3r;
+        }
+    }
+    for (; j < cols; j++) {
+        const double *ar0 = Ar + (long) j * rows, *ai0 = Ai + (long) j * rows;
+        double x0r = xd[2 * j], x0i = xd[2 * j + 1];
+        KERNEL_SIMD
+        for (int i = 0; i < rows; i++) {
+            yd[2 * i] += ar0[i] * x0r - ai0[i] * x0i;
+            yd[2 * i + 1] += ar0[i] * x0i + ai0[i] * x0r;
+        }
+    }
+}
+
+static void PlanarGemvBaseline(const double *Ar, const double *Ai, const double *xd, double *yd, const int &rows,
+                               const int &cols) {
+    PlanarGemvBody(Ar, Ai, xd, yd, rows, cols);
+}
+
+#ifdef KERNEL_MULTIVERSIONING
+KERNEL_AVX2
+static void PlanarGemvAvx2(const double *Ar, const double *Ai, const double *xd, double *yd, const int &rows,
+                           const int &cols) {
+    PlanarGemvBody(Ar, Ai, xd, yd, rows, cols);
+}
+
+KERNEL_AVX512
+static void PlanarGemvAvx512(const double *Ar, const double *Ai, const double *xd, double *yd, const int &rows,
+                             const int &cols) {
+    PlanarGemvBody(Ar, Ai, xd, yd, rows, cols);
+}
+#endif
+
+static void PlanarGemv(const double *Ar, const double *Ai, const double *xd, double *yd, const int &rows,
+                       const int &cols) {
+#ifdef KERNEL_MULTIVERSIONING
+    switch (CpuDispatch::GetPath()) {
+        case CpuDispatch::AVX512: PlanarGemvAvx512(Ar, Ai, xd, yd, rows, cols); return;
+        case CpuDispatch::AVX2: PlanarGemvAvx2(Ar, Ai, xd, yd, rows, cols); return;
+        default: break;
+    }
+#endif
+    PlanarGemvBaseline(Ar, Ai, xd, yd, rows, cols);
+}
+
+// REAL MATRICES
+template <>
+void PlanarMatrix<double>::Set(const Eigen::Matrix<double, -1, -1> &A) {
+    _real = A;
+    _imag.resize(0, 0);
+}
+
+template <>
+void PlanarMatrix<double>::Multiply(const Eigen::Vector<double, -1> &x, Eigen::Vector<double, -1> &y) const {
+    y.resize(_real.rows());
+    IterationKernels<double>::Gemv(_real.data(), x.data(), y.data(), _real.rows(), _real.cols());
+}
+
+// COMPLEX MATRICES
+template <>
+void PlanarMatrix<std::complex<double>>::Set(const Eigen::Matrix<std::complex<double>, -1, -1> &A) {
+    _real = A.real();
+    _imag = A.imag();
+}
+
+template <>
+void PlanarMatrix<std::complex<double>>::Multiply(const Eigen::Vector<std::complex<double>, -1> &x,
+                                                  Eigen::Vector<std::complex<double>, -1> &y) const {
+    y.resize(_real.rows());
+    PlanarGemv(_real.data(), _imag.data(), reinterpret_cast<const double *>(x.data()),
+               reinterpret_cast<double *>(y.data()), _real.rows(), _real.cols());
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class PlanarMatrix<double>;
+template class PlanarMatrix<std::complex<double>>;
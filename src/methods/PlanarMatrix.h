@@ -0,0 +1,59 @@
+#ifndef PLANARMATRIX_H_
+#define PLANARMATRIX_H_
+
+#include <Eigen/Dense>
+#include <complex>
+
+/** @class PlanarMatrix
+ * @brief Class storing a dense matrix in planar layout, with the real and the imaginary parts in separate arrays, for
+ * fast products with vectors.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details A complex matrix <tt>Eigen::Matrix<std::complex<double>, -1, -1></tt> is stored in interleaved layout: the
+ * real and the imaginary part of each entry are adjacent in memory. The products of complex numbers then need to
+ * shuffle the two parts inside the SIMD registers, and the complex kernels vectorize much worse than the real ones.
+ * In planar layout the real part \f$A_r\f$ and the imaginary part \f$A_i\f$ are two real matrices, and the product
+ * \f$Ax = (A_r x_r - A_i x_i) + i(A_r x_i + A_i x_r)\f$ reads them with unit stride, using only real multiply-adds. The
+ * vectors stay in interleaved layout, since they are much smaller than the matrix.
+ *
+ * For real matrices the planar layout coincides with the usual one and only \f$A_r\f$ is stored.
+ *
+ * The product is compiled for several instruction sets and the one used is selected at run time. @see CpuDispatch
+ */
+template <typename T> class PlanarMatrix {
+public:
+    /**
+     * @brief Stores the given matrix in planar layout.
+     * @param A Matrix.
+     */
+    void Set(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Computes the product \f$y = Ax\f$.
+     * @param x Vector of size equal to the number of columns.
+     * @param y Vector overwritten by \f$Ax\f$, resized only if its size is wrong. It cannot be \f$x\f$.
+     */
+    void Multiply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) const;
+
+    /**
+     * @brief Returns the real part of the matrix.
+     */
+    const Eigen::Matrix<double, -1, -1> &GetReal() const {return _real;};
+
+    /**
+     * @brief Returns the imaginary part of the matrix, empty for real matrices.
+     */
+    const Eigen::Matrix<double, -1, -1> &GetImag() const {return _imag;};
+
+private:
+    /**
+     * @brief Real part of the matrix.
+     */
+    Eigen::Matrix<double, -1, -1> _real;
+
+    /**
+     * @brief Imaginary part of the matrix.
+     */
+    Eigen::Matrix<double, -1, -1> _imag;
+};
+
+#endif //PLANARMATRIX_H_
@@ -1,4 +1,39 @@
 #include "PowerMethod.h"
+#include "IterationKernels.h"
+
+/**
+ * @details The product with a sparse matrix in compressed sparse row format is executed by Eigen row by row, in
+ * parallel if OpenMP is available and the matrix has enough nonzero entries. The product with a dense matrix is executed
+ * by IterationKernels::Gemv, with the instruction set selected at run time.
+ */
+/**
+ * @details The method has been overridden to add an initial step that copies the matrix in planar layout, if the planar
+ * layout is selected and the matrix is dense and complex.
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> PowerMethod<T>::ComputeEigs() {
+    if (this->UsePlanarLayout()) {
+        _planar_matrix.Set(this->WorkMatrix());
+    }
+    return AbstractPowerMethod<T>::ComputeEigs();
+}
+
+template <typename T>
+void PowerMethod<T>::Multiply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+    if (this->_operator) {
+        this->_operator->Apply(x, y);
+    }
+    else if (this->_sparse) {
+        y.noalias() = this->_A_sparse * x;
+    }
+    else if (this->UsePlanarLayout()) {
+        _planar_matrix.Multiply(x, y);
+    }
+    else {
+        const Eigen::Matrix<T, -1, -1> &A = this->WorkMatrix();
+        IterationKernels<T>::Gemv(A.data(), x.data(), y.data(), A.rows(), A.cols());
+    }
+}
 
 // Explicit instantiation for double and std::complex<double>
 template class PowerMethod<double>;
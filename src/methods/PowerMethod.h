@@ -2,6 +2,7 @@
 #define POWERMETHOD_H_
 
 #include "AbstractPowerMethod.h"
+#include "PlanarMatrix.h"
 
 /** @class PowerMethod
  * @brief Class for computing the largest magnitude eigenvalue of general matrices using the Power Method.
@@ -19,6 +20,10 @@
  *  where \f$\epsilon\f$ is a prescribed tolerance. In any case, the iterations are stopped when \f$k\f$ exceeds the
  *  maximum number of iterations and in this case the method is said to be non-convergent for the specific instance.
  *
+ *  The matrix can also be given in compressed sparse row format, as <tt>Eigen::SparseMatrix<T, Eigen::RowMajor></tt>,
+ *  so that the memory cost and the cost of each iteration are \f$O(nnz)\f$ instead of \f$O(n^2)\f$, or as a
+ *  LinearOperator, which is only applied to vectors and never stored.
+ *
  *  Usage:
  *  @code{.cpp}
     double tol = 1e-10;
@@ -66,6 +71,28 @@ public:
     PowerMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit, const Eigen::Vector<T,-1> &x0)
     : AbstractPowerMethod<T>(A, tol, maxit, x0) {};
 
+    /**
+     * @copydoc AbstractPowerMethod::AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    PowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractPowerMethod<T>(A) {};
+
+    /**
+     * @copydoc AbstractPowerMethod::AbstractPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int maxit, const Eigen::Matrix<T,-1,1> &x0)
+     */
+    PowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit,
+                const Eigen::Vector<T,-1> &x0) : AbstractPowerMethod<T>(A, tol, maxit, x0) {};
+
+    /**
+     * @copydoc AbstractPowerMethod::AbstractPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    PowerMethod(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractPowerMethod<T>(A) {};
+
+    /**
+     * @copydoc AbstractPowerMethod::AbstractPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int maxit, const Eigen::Matrix<T,-1,1> &x0)
+     */
+    PowerMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit,
+                const Eigen::Vector<T,-1> &x0) : AbstractPowerMethod<T>(A, tol, maxit, x0) {};
+
     /**
      * @copydoc AbstractPowerMethod::AbstractPowerMethod(std::map<std::string, std::any> &map)
      */
@@ -74,8 +101,19 @@ public:
     // Destructor
     virtual ~PowerMethod() override {};
 
+    /**
+     * @brief Returns the eigenvalues computed using the power method.
+     * @return Vector of complex numbers containing the eigenvalue of \f$A\f$ with the largest absolute value.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
 private:
 
+    /**
+     * @brief Matrix in planar layout, if the planar layout is selected.
+     */
+    PlanarMatrix<T> _planar_matrix;
+
     /**
      * Method to return the eigenvalue of the matrix _A.
      * @param lambda approximation obtained at the end of the iterations of the power method applied to _A.
@@ -86,9 +124,9 @@ private:
     /**
      * @brief Executes the multiplication step of the power method.
      * @param x vector to be multiplied.
-     * @return Result of the multiplication step, i.e. \f$ A\,x \f$.
+     * @param y result of the multiplication step, i.e. \f$ A\,x \f$.
      */
-    Eigen::Vector<T,-1> Multiply(const Eigen::Vector<T,-1> &x) override {return this->_A * x;};
+    void Multiply(const Eigen::Vector<T,-1> &x, Eigen::Vector<T,-1> &y) override;
 };
 
 #endif //POWERMETHOD_H_
@@ -1,52 +1,728 @@
 #include "QRMethod.h"
+#include <algorithm>
+#include <limits>
+#include <Eigen/Jacobi>
 
 /**
- * @details Computes the eigenvalues following the QR algorithm.
+ * @details Computes the eigenvalues following the practical QR algorithm: reduction to upper Hessenberg form followed
+ * by implicit double-shift Francis steps, or multishift iterations with aggressive early deflation for large active
+ * windows. The reduction is skipped if the matrix is already in upper Hessenberg form.
  *
  * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
  * <tt>Reached maximum number of iterations</tt>
  *
- * @todo Handle the case of real matrices with pairs of complex conjugate eigenvalues.
  * @todo Handle the case of complex matrices.
  */
 template <typename T>
 Eigen::Vector<std::complex<double>, -1> QRMethod<T>::ComputeEigs() {
     // Initializing the necessary variables
-    int rows, cols;
-    rows = (this->_A).rows();
-    cols = (this->_A).cols();
-    int it; // Number of iterations
-    Eigen::HouseholderQR<Eigen::Matrix<T, -1, -1>> QR(rows, cols); // To store the QR decomposition at each iteration
-    Eigen::Matrix<T, -1, -1> A_k(rows, cols);
-    Eigen::Matrix<T, -1, -1> A_next(rows, cols);
-
-    // Setting the initial matrix
-    A_next = this->_A;
-    // Setting the iterations to zero and the residual such that the algorithm is not stopped at the first iteration
-    it = 0;
-    double res = (this->_tol + 1) * A_next.norm();
-
-    // Loop
-    while ((it < this->_maxit) && (res > this->_tol * A_next.diagonal().norm())){
-        A_k = A_next;
-        // Computing the QR factorization and A_next as R*Q
-        QR = A_k.householderQr();
-        A_next =  Eigen::Matrix<T, -1, -1>(QR.matrixQR().template triangularView<Eigen::Upper>()) * QR.householderQ();
-        // Computing the residual and updating the iteration
-        res = (A_k.diagonal() - A_next.diagonal()).norm();
-        it++;
-    }
-
-    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
-    if (it == this->_maxit){
-        throw(ConvergenceError("Reached maximum number of iterations"));
-    }
-
-    // Returning the eigenvalues
-    Eigen::Vector<std::complex<double>, -1> eigs;
-    eigs = A_next.diagonal();
+    int n = (this->_A).rows();
+    int it = 0; // Total number of iterations
+    Eigen::Vector<std::complex<double>, -1> eigs(n);
+
+    // Reduction to upper Hessenberg form, skipped if the matrix is already in Hessenberg form
+    const Eigen::Matrix<T, -1, -1> &W = this->WorkMatrix();
+    bool hessenberg = n < 3 || W.bottomLeftCorner(n - 1, n - 1).template triangularView<Eigen::StrictlyLower>()
+                                .toDenseMatrix().isZero(0);
+    Eigen::Matrix<T, -1, -1> H = hessenberg ? W : HessenbergReduction<T>(W).GetMatrixH();
+
+    // QR iterations on the Hessenberg matrix, computing only the eigenvalues
+    QRAlgorithm(H, nullptr, eigs, it);
+    this->_it = it;
+
+    // Returning the eigenvalues in descending order of absolute value
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (std::abs(i) != std::abs(j)) {
+            return std::abs(i) > std::abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(eigs.data(), eigs.data() + eigs.size(), abs_complex);
+    return eigs;
+}
+
+/**
+ * @details The negligible subdiagonal entries are set to zero, splitting the Hessenberg matrix into independent
+ * unreduced diagonal blocks. The iterations are executed only on the trailing unreduced block \f$H(lo:hi, lo:hi)\f$
+ * (active window). When the trailing \f$1\times1\f$ or \f$2\times2\f$ block of the active window deflates, the window
+ * shrinks; when the whole active window has deflated the next block above it becomes the active one. The method stops
+ * when every block has deflated.
+ *
+ * If only the eigenvalues are computed, the transformations are applied only to the active window and not to the blocks
+ * that have already converged or are still to be processed. If instead the transformations are accumulated in \f$Z\f$,
+ * they are applied to the whole matrix, which is overwritten with its real Schur form.
+ *
+ * If the active window is larger than QRMethod::_nmin, a multishift iteration with aggressive early deflation is
+ * executed, otherwise a double-shift Francis step. If the same eigenvalue does not converge after 10 or 20 steps, an
+ * exceptional shift is used for one step to break possible cycles.
+ *
+ * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+void QRMethod<T>::QRAlgorithm(Eigen::Matrix<T, -1, -1> &H, Eigen::Matrix<T, -1, -1> *Z,
+                              Eigen::Vector<std::complex<double>, -1> &eigs, int &it) {
+    int its = 0; // Number of iterations since the last deflation
+
+    // Loop: hi is the last row of the block that has not converged yet
+    int hi = H.rows() - 1;
+    while (hi >= 0) {
+        // Looking for a negligible subdiagonal entry: lo is the first row of the active window
+        int lo = hi;
+        while (lo > 0 && !Negligible(H, lo)) {
+            lo--;
+        }
+        if (lo > 0) {
+            H(lo, lo - 1) = 0;
+        }
+
+        if (lo == hi) {
+            // Deflation of a real eigenvalue
+            eigs[hi] = H(hi, hi);
+            hi -= 1;
+            its = 0;
+        }
+        else if (lo == hi - 1) {
+            // Deflation of a 2x2 block of the real Schur form
+            Eigs2x2(H, lo, eigs);
+            hi -= 2;
+            its = 0;
+        }
+        else {
+            // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+            if (it == this->_maxit) {
+                throw(ConvergenceError("Reached maximum number of iterations"));
+            }
+            if (hi - lo + 1 > _nmin) {
+                int nd = MultishiftIteration(H, lo, hi, its, Z, eigs);
+                hi -= nd;
+                its = (nd > 0) ? 0 : its + 1;
+            }
+            else {
+                FrancisStep(H, lo, hi, its == 10 || its == 20, Z);
+                its++;
+            }
+            it++;
+        }
+    }
+}
+
+/**
+ * @details The subdiagonal entry is considered negligible if \f$|h_{k,k-1}| < \epsilon (|h_{k-1,k-1}| + |h_{k,k}|)\f$,
+ * where \f$\epsilon\f$ is the tolerance of the method. If both the diagonal entries are zero, the norm of the matrix
+ * is used in place of their sum.
+ */
+template <typename T>
+bool QRMethod<T>::Negligible(const Eigen::Matrix<T, -1, -1> &H, const int &k) {
+    double scale = std::abs(H(k - 1, k - 1)) + std::abs(H(k, k));
+    if (scale == 0) {
+        scale = H.norm();
+    }
+    return std::abs(H(k, k - 1)) <= this->_tol * scale;
+}
+
+/**
+ * @details Let \f$s_1, s_2\f$ be the eigenvalues of the trailing \f$2\times2\f$ block of \f$H\f$. The first column of
+ * \f$M = (H - s_1 I)(H - s_2 I) = H^2 - sH + tI\f$ has only three nonzero entries, which are real since
+ * \f$s = s_1 + s_2\f$ and \f$t = s_1 s_2\f$ are real. A Householder reflector that maps this column to a multiple of
+ * \f$e_1\f$ is applied to \f$H\f$ by similarity, creating a bulge below the subdiagonal, and the Hessenberg form is
+ * restored by chasing the bulge down the diagonal with \f$3\times3\f$ Householder reflectors.
+ *
+ * The exceptional shifts are the ones used by the LAPACK routine <tt>dlahqr</tt>.
+ */
+template <typename T>
+void QRMethod<T>::FrancisStep(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi, const bool &exceptional,
+                              Eigen::Matrix<T, -1, -1> *Z) {
+    // Range of the columns and rows to be updated
+    int i1 = (Z == nullptr) ? lo : 0;
+    int i2 = (Z == nullptr) ? hi : int(H.cols()) - 1;
+
+    // Sum and product of the shifts
+    double s, t;
+    if (exceptional) {
+        double w = std::abs(H(hi, hi - 1)) + std::abs(H(hi - 1, hi - 2));
+        double h = 0.75 * w + H(hi, hi);
+        s = 2 * h;
+        t = h * h + 0.4375 * w * w;
+    }
+    else {
+        s = H(hi - 1, hi - 1) + H(hi, hi);
+        t = H(hi - 1, hi - 1) * H(hi, hi) - H(hi - 1, hi) * H(hi, hi - 1);
+    }
+
+    // First column of (H - s_1 I)(H - s_2 I)
+    Eigen::Vector<T, 3> v;
+    v[0] = H(lo, lo) * H(lo, lo) + H(lo, lo + 1) * H(lo + 1, lo) - s * H(lo, lo) + t;
+    v[1] = H(lo + 1, lo) * (H(lo, lo) + H(lo + 1, lo + 1) - s);
+    v[2] = H(lo + 1, lo) * H(lo + 2, lo + 1);
+
+    Eigen::Vector<T, 2> essential;
+    T tau;
+    double beta;
+    Eigen::Vector<T, -1> workspace(H.cols());
+    for (int k = lo; k < hi - 1; k++) {
+        // Reflector acting on rows and columns k, k+1, k+2
+        v.makeHouseholder(essential, tau, beta);
+        if (tau != T(0)) {
+            int col = std::max(k - 1, lo);
+            int row = std::min(k + 3, hi);
+            H.block(k, col, 3, i2 + 1 - col).applyHouseholderOnTheLeft(essential, tau, workspace.data());
+            H.block(i1, k, row + 1 - i1, 3).applyHouseholderOnTheRight(essential, tau, workspace.data());
+            if (Z != nullptr) {
+                Z->block(0, k, Z->rows(), 3).applyHouseholderOnTheRight(essential, tau, workspace.data());
+            }
+            if (k > lo) {
+                H(k, k - 1) = beta;
+                H(k + 1, k - 1) = 0;
+                H(k + 2, k - 1) = 0;
+            }
+        }
+        // Bulge to be annihilated at the next step
+        v[0] = H(k + 1, k);
+        v[1] = H(k + 2, k);
+        if (k < hi - 2) {
+            v[2] = H(k + 3, k);
+        }
+    }
+
+    // Last reflector acting on rows and columns hi-1, hi
+    Eigen::Vector<T, 2> v_last = v.template head<2>();
+    Eigen::Vector<T, 1> essential_last;
+    v_last.makeHouseholder(essential_last, tau, beta);
+    if (tau != T(0)) {
+        H.block(hi - 1, hi - 2, 2, i2 + 3 - hi).applyHouseholderOnTheLeft(essential_last, tau, workspace.data());
+        H.block(i1, hi - 1, hi + 1 - i1, 2).applyHouseholderOnTheRight(essential_last, tau, workspace.data());
+        if (Z != nullptr) {
+            Z->block(0, hi - 1, Z->rows(), 2).applyHouseholderOnTheRight(essential_last, tau, workspace.data());
+        }
+        H(hi - 1, hi - 2) = beta;
+        H(hi, hi - 2) = 0;
+    }
+}
+
+/**
+ * @details The number of shifts and the size of the deflation window grow with the size of the active window, as in
+ * the LAPACK routine <tt>dlaqr0</tt>. First the aggressive early deflation is executed on the trailing window. If it
+ * did not deflate a significant part of the window (at least QRMethod::_nibble percent), a multishift sweep is executed
+ * on what remains of the active window, using as shifts the eigenvalues of the deflation window that did not deflate.
+ * The complex shifts come in conjugate pairs, while the real ones are paired in order, so that every bulge is defined
+ * by the real sum and product of its pair of shifts.
+ *
+ * After 6 iterations without deflations an exceptional double-shift Francis step is executed instead of the sweep.
+ */
+template <typename T>
+int QRMethod<T>::MultishiftIteration(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi, const int &its,
+                                     Eigen::Matrix<T, -1, -1> *Z, Eigen::Vector<std::complex<double>, -1> &eigs) {
+    // Number of shifts and size of the deflation window
+    int n = hi - lo + 1;
+    int ns;
+    if (n < 150) {
+        ns = 10;
+    }
+    else if (n < 590) {
+        ns = std::max(10, int(n / std::round(std::log2(double(n)))));
+    }
+    else if (n < 3000) {
+        ns = 64;
+    }
+    else if (n < 6000) {
+        ns = 128;
+    }
+    else {
+        ns = 256;
+    }
+    ns -= ns % 2;
+    int nw = (n <= 500) ? ns : 3 * ns / 2;
+    nw = std::min(nw, (n - 1) / 3);
+
+    // Aggressive early deflation
+    Eigen::Vector<std::complex<double>, -1> shifts;
+    int nd = AggressiveEarlyDeflation(H, lo, hi, nw, Z, eigs, shifts);
+    int hi_sweep = hi - nd;
+    if ((nd > 0 && 100 * nd > _nibble * nw) || hi_sweep - lo < 2) {
+        return nd;
+    }
+
+    // Pairing the shifts, starting from the ones at the bottom of the deflation window
+    std::vector<std::pair<double, double>> pairs;
+    bool pending = false; // True if a real shift is waiting to be paired
+    double pending_shift = 0;
+    for (int k = int(shifts.size()) - 1; k >= 0 && int(pairs.size()) < ns / 2; k--) {
+        if (shifts[k].imag() == 0) {
+            if (pending) {
+                pairs.emplace_back(pending_shift + shifts[k].real(), pending_shift * shifts[k].real());
+            }
+            else {
+                pending_shift = shifts[k].real();
+            }
+            pending = !pending;
+        }
+        else if (k > 0 && shifts[k - 1] == std::conj(shifts[k])) {
+            pairs.emplace_back(2 * shifts[k].real(), std::norm(shifts[k]));
+            k--;
+        }
+    }
+
+    // Multishift sweep, or Francis step if too few shifts are available or after too many iterations without deflation
+    if (pairs.empty() || (its > 0 && its % 6 == 0)) {
+        FrancisStep(H, lo, hi_sweep, its > 0 && its % 6 == 0, Z);
+    }
+    else {
+        MultishiftSweep(H, lo, hi_sweep, pairs, Z);
+    }
+    return nd;
+}
+
+/**
+ * @details The aggressive early deflation follows the LAPACK routine <tt>dlaqr3</tt>. Let \f$W = H(k:hi, k:hi)\f$ be
+ * the trailing window of size \f$n_w\f$ and \f$s = h_{k,k-1}\f$ the spike that couples it with the rest of the active
+ * window. The real Schur form \f$S = V^T W V\f$ is computed recursively with the QR algorithm, so that after the
+ * similarity the window is coupled to the rest of the matrix by the spike vector \f$s V^T e_1\f$. Starting from the
+ * bottom of \f$S\f$, each \f$1\times1\f$ or \f$2\times2\f$ block whose components of the spike vector are negligible
+ * with respect to the tolerance deflates; the blocks that do not deflate are moved to the top of \f$S\f$ by swapping
+ * adjacent blocks, so that the search can continue with the block above. If a swap is too ill-conditioned, the search
+ * is stopped.
+ *
+ * The eigenvalues of the deflated blocks are stored, the spike components of the deflated blocks are set to zero and the
+ * part of the window that did not deflate, together with its spike, is reduced back to Hessenberg form with a Householder
+ * reflector followed by a Hessenberg reduction. The orthogonal transformation is then applied to the rows and columns of
+ * \f$H\f$ outside the window with matrix-matrix products.
+ */
+template <typename T>
+int QRMethod<T>::AggressiveEarlyDeflation(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi, const int &nw,
+                                          Eigen::Matrix<T, -1, -1> *Z, Eigen::Vector<std::complex<double>, -1> &eigs,
+                                          Eigen::Vector<std::complex<double>, -1> &shifts) {
+    // Range of the columns and rows to be updated
+    int i1 = (Z == nullptr) ? lo : 0;
+    int i2 = (Z == nullptr) ? hi : int(H.cols()) - 1;
+
+    // Deflation window and spike
+    int kwtop = hi - nw + 1;
+    T s = (kwtop > lo) ? H(kwtop, kwtop - 1) : T(0);
+
+    // Schur form of the deflation window
+    Eigen::Matrix<T, -1, -1> S = H.block(kwtop, kwtop, nw, nw);
+    Eigen::Matrix<T, -1, -1> V = Eigen::Matrix<T, -1, -1>::Identity(nw, nw);
+    Eigen::Vector<std::complex<double>, -1> window_eigs(nw);
+    int it = 0;
+    QRAlgorithm(S, &V, window_eigs, it);
+
+    // Deflation checks: nu is the size of the part of the window not yet deflated, ilst the number of blocks that have
+    // been moved to the top of the window since they do not deflate.
+    int nu = nw;
+    int ilst = 0;
+    while (nu > ilst) {
+        int kend = nu - 1;
+        int bs = (kend > ilst && S(kend, kend - 1) != T(0)) ? 2 : 1;
+        double scale = std::abs(S(kend, kend));
+        double spike = std::abs(s * V(0, kend));
+        if (bs == 2) {
+            scale += std::sqrt(std::abs(S(kend, kend - 1))) * std::sqrt(std::abs(S(kend - 1, kend)));
+            spike = std::max(spike, std::abs(s * V(0, kend - 1)));
+        }
+        if (scale == 0) {
+            scale = std::abs(s);
+        }
+
+        if (spike <= this->_tol * scale) {
+            // Deflatable block
+            nu -= bs;
+        }
+        else {
+            // Undeflatable block: it is moved to the top of the window by swapping it with the blocks above
+            int here = kend - bs + 1;
+            bool swapped = true;
+            while (swapped && here > ilst) {
+                int bs_above = (here - 2 >= ilst && S(here - 1, here - 2) != T(0)) ? 2 : 1;
+                swapped = SwapBlocks(S, V, here - bs_above, bs_above, bs);
+                here -= bs_above;
+            }
+            if (!swapped) {
+                break;
+            }
+            ilst += bs;
+        }
+    }
+    int nd = nw - nu;
+
+    // Storing the deflated eigenvalues and the shifts
+    BlockEigs(S, 0, nw - 1, window_eigs);
+    eigs.segment(kwtop + nu, nd) = window_eigs.tail(nd);
+    shifts = window_eigs.head(nu);
+
+    // Reduction to Hessenberg form of the part of the window that did not deflate, together with its spike
+    if (kwtop > lo) {
+        Eigen::Vector<T, -1> workspace(nw);
+        if (nu > 1) {
+            Eigen::Vector<T, -1> spike = s * V.row(0).head(nu).adjoint();
+            Eigen::Vector<T, -1> essential(nu - 1);
+            T tau;
+            double beta;
+            spike.makeHouseholder(essential, tau, beta);
+            S.block(0, 0, nu, nw).applyHouseholderOnTheLeft(essential, tau, workspace.data());
+            S.block(0, 0, nu, nu).applyHouseholderOnTheRight(essential, tau, workspace.data());
+            V.block(0, 0, nw, nu).applyHouseholderOnTheRight(essential, tau, workspace.data());
+
+            HessenbergReduction<T> hessenberg(S.topLeftCorner(nu, nu));
+            S.topLeftCorner(nu, nu) = hessenberg.GetMatrixH();
+            Eigen::Matrix<T, -1, -1> S12 = S.topRightCorner(nu, nw - nu);
+            hessenberg.ApplyQAdjoint(S12);
+            S.topRightCorner(nu, nw - nu) = S12;
+            V.leftCols(nu) = V.leftCols(nu) * hessenberg.GetMatrixQ();
+            H(kwtop, kwtop - 1) = beta;
+        }
+        else if (nu == 1) {
+            H(kwtop, kwtop - 1) = s * Eigen::numext::conj(V(0, 0));
+        }
+        else {
+            H(kwtop, kwtop - 1) = 0;
+        }
+    }
+
+    // Copying back the window and applying the transformation to the rest of the matrix
+    H.block(kwtop, kwtop, nw, nw) = S;
+    if (kwtop > i1) {
+        H.block(i1, kwtop, kwtop - i1, nw) = H.block(i1, kwtop, kwtop - i1, nw) * V;
+    }
+    if (i2 > hi) {
+        H.block(kwtop, hi + 1, nw, i2 - hi) = V.adjoint() * H.block(kwtop, hi + 1, nw, i2 - hi);
+    }
+    if (Z != nullptr) {
+        Z->middleCols(kwtop, nw) = Z->middleCols(kwtop, nw) * V;
+    }
+    return nd;
+}
+
+/**
+ * @details The blocks are swapped with the direct method of the LAPACK routine <tt>dlaexc</tt>. Let
+ * \f$\begin{bmatrix} A_{11} & A_{12} \\ 0 & A_{22}\end{bmatrix}\f$ be the two blocks. The Sylvester equation
+ * \f$A_{11} X - X A_{22} = A_{12}\f$ is solved, so that the columns of \f$\begin{bmatrix} -X \\ I\end{bmatrix}\f$ span
+ * the invariant subspace associated with \f$A_{22}\f$. If \f$Q\f$ is the orthogonal factor of its QR factorization,
+ * \f$Q^T \begin{bmatrix} A_{11} & A_{12} \\ 0 & A_{22}\end{bmatrix} Q\f$ has the blocks swapped.
+ *
+ * The swap is rejected if the Sylvester equation is singular (the two blocks have a common eigenvalue) or if the
+ * block below the diagonal after the swap is not negligible with respect to the machine precision.
+ */
+template <typename T>
+bool QRMethod<T>::SwapBlocks(Eigen::Matrix<T, -1, -1> &S, Eigen::Matrix<T, -1, -1> &V, const int &j, const int &p,
+                             const int &q) {
+    int n = S.rows();
+    int m = p + q;
+    Eigen::Matrix<T, -1, -1> A = S.block(j, j, m, m);
+
+    // Solving the Sylvester equation A11 X - X A22 = A12 in Kronecker form
+    Eigen::Matrix<T, -1, -1> K = Eigen::Matrix<T, -1, -1>::Zero(p * q, p * q);
+    Eigen::Vector<T, -1> rhs(p * q);
+    for (int c = 0; c < q; c++) {
+        for (int r = 0; r < p; r++) {
+            for (int r2 = 0; r2 < p; r2++) {
+                K(r + c * p, r2 + c * p) += A(r, r2);
+            }
+            for (int c2 = 0; c2 < q; c2++) {
+                K(r + c * p, r + c2 * p) -= A(p + c2, p + c);
+            }
+            rhs[r + c * p] = A(r, p + c);
+        }
+    }
+    Eigen::FullPivLU<Eigen::Matrix<T, -1, -1>> LU(K);
+    if (!LU.isInvertible()) {
+        return false;
+    }
+    Eigen::Vector<T, -1> x = LU.solve(rhs);
+
+    // Orthogonal basis of the invariant subspace associated with A22
+    Eigen::Matrix<T, -1, -1> M(m, q);
+    M.topRows(p) = -Eigen::Map<Eigen::Matrix<T, -1, -1>>(x.data(), p, q);
+    M.bottomRows(q) = Eigen::Matrix<T, -1, -1>::Identity(q, q);
+    Eigen::Matrix<T, -1, -1> Q = M.householderQr().householderQ();
+
+    // Swapping the blocks and checking the stability of the swap
+    Eigen::Matrix<T, -1, -1> A_swap = Q.adjoint() * A * Q;
+    double threshold = 20 * std::numeric_limits<double>::epsilon() * A.norm();
+    if (A_swap.block(q, 0, p, q).norm() > threshold) {
+        return false;
+    }
+    A_swap.block(q, 0, p, q).setZero();
+
+    // Applying the transformation
+    S.block(j, j, m, m) = A_swap;
+    if (j + m < n) {
+        S.block(j, j + m, m, n - j - m) = Q.adjoint() * S.block(j, j + m, m, n - j - m);
+    }
+    if (j > 0) {
+        S.block(0, j, j, m) = S.block(0, j, j, m) * Q;
+    }
+    V.middleCols(j, m) = V.middleCols(j, m) * Q;
+    return true;
+}
+
+/**
+ * @details The sweep follows the small-bulge multishift QR algorithm of the LAPACK routine <tt>dlaqr5</tt>. Each pair
+ * of shifts defines a bulge, which is introduced at the top of the active window and chased down to the bottom with
+ * \f$3\times3\f$ Householder reflectors, as in the double-shift Francis step. The bulges are chased as a tightly packed
+ * chain: at each step every bulge is moved down by one position and the bulges are kept three positions apart, which
+ * makes the result equivalent to executing the Francis steps one after the other.
+ *
+ * The steps are grouped so that, within a group, all the reflectors act on a diagonal slab \f$H(k_0:k_1, k_0:k_1)\f$.
+ * The reflectors are applied only to the slab and accumulated in an orthogonal matrix \f$U\f$; at the end of the group the
+ * rows \f$H(k_0:k_1, k_1+1:)\f$ and the columns \f$H(:k_0-1, k_0:k_1)\f$ are updated with matrix-matrix products by
+ * \f$U\f$.
+ */
+template <typename T>
+void QRMethod<T>::MultishiftSweep(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi,
+                                  const std::vector<std::pair<double, double>> &shifts, Eigen::Matrix<T, -1, -1> *Z) {
+    // Range of the columns and rows to be updated
+    int i1 = (Z == nullptr) ? lo : 0;
+    int i2 = (Z == nullptr) ? hi : int(H.cols()) - 1;
+
+    // Number of bulges, total number of steps and number of steps in each group.
+    // The bulge b executes at step s the reflector acting on rows r, r+1, r+2 with r = lo + s - 3b.
+    int nb = shifts.size();
+    int nsteps = 3 * (nb - 1) + (hi - lo);
+    int group = std::max(3 * nb, 12);
+
+    Eigen::Vector<T, 3> v;
+    Eigen::Vector<T, 2> essential;
+    Eigen::Vector<T, 1> essential_last;
+    T tau;
+    double beta;
+    Eigen::Vector<T, -1> workspace(H.cols());
+
+    for (int s0 = 0; s0 < nsteps; s0 += group) {
+        int s1 = std::min(s0 + group, nsteps);
+        // Diagonal slab touched by the reflectors of the group
+        int r_min = std::max(lo, lo + s0 - 3 * (nb - 1));
+        int r_max = std::min(hi - 1, lo + s1 - 1);
+        int k0 = std::max(lo, r_min - 1);
+        int k1 = std::min(hi, r_max + 3);
+        int kd = k1 - k0 + 1;
+        Eigen::Matrix<T, -1, -1> U = Eigen::Matrix<T, -1, -1>::Identity(kd, kd);
+
+        for (int s = s0; s < s1; s++) {
+            for (int b = 0; b < nb; b++) {
+                int r = lo + s - 3 * b;
+                if (r < lo || r > hi - 1) {
+                    continue;
+                }
+                int row = std::min(r + 3, hi);
+                int col = std::max(r - 1, lo);
+                if (r <= hi - 2) {
+                    if (r == lo) {
+                        // Introduction of the bulge: first column of (H - s_1 I)(H - s_2 I)
+                        double sum = shifts[b].first, prod = shifts[b].second;
+                        v[0] = H(lo, lo) * H(lo, lo) + H(lo, lo + 1) * H(lo + 1, lo) - sum * H(lo, lo) + prod;
+                        v[1] = H(lo + 1, lo) * (H(lo, lo) + H(lo + 1, lo + 1) - sum);
+                        v[2] = H(lo + 1, lo) * H(lo + 2, lo + 1);
+                    }
+                    else {
+                        v = H.block(r, r - 1, 3, 1);
+                    }
+                    v.makeHouseholder(essential, tau, beta);
+                    if (tau != T(0)) {
+                        H.block(r, col, 3, k1 + 1 - col).applyHouseholderOnTheLeft(essential, tau, workspace.data());
+                        H.block(k0, r, row + 1 - k0, 3).applyHouseholderOnTheRight(essential, tau, workspace.data());
+                        U.block(0, r - k0, kd, 3).applyHouseholderOnTheRight(essential, tau, workspace.data());
+                        if (r > lo) {
+                            H(r, r - 1) = beta;
+                            H(r + 1, r - 1) = 0;
+                            H(r + 2, r - 1) = 0;
+                        }
+                    }
+                }
+                else {
+                    // Last reflector of the bulge, acting on rows hi-1, hi
+                    Eigen::Vector<T, 2> v_last = H.block(r, r - 1, 2, 1);
+                    v_last.makeHouseholder(essential_last, tau, beta);
+                    if (tau != T(0)) {
+                        H.block(r, col, 2, k1 + 1 - col).applyHouseholderOnTheLeft(essential_last, tau,
+                                                                                   workspace.data());
+                        H.block(k0, r, row + 1 - k0, 2).applyHouseholderOnTheRight(essential_last, tau,
+                                                                                   workspace.data());
+                        U.block(0, r - k0, kd, 2).applyHouseholderOnTheRight(essential_last, tau, workspace.data());
+                        H(r, r - 1) = beta;
+                        H(r + 1, r - 1) = 0;
+                    }
+                }
+            }
+        }
+
+        // Level-3 update of the rows and columns outside the slab
+        if (k1 < i2) {
+            H.block(k0, k1 + 1, kd, i2 - k1) = U.adjoint() * H.block(k0, k1 + 1, kd, i2 - k1);
+        }
+        if (k0 > i1) {
+            H.block(i1, k0, k0 - i1, kd) = H.block(i1, k0, k0 - i1, kd) * U;
+        }
+        if (Z != nullptr) {
+            Z->middleCols(k0, kd) = Z->middleCols(k0, kd) * U;
+        }
+    }
+}
+
+/**
+ * @details A \f$2\times2\f$ block is recognised by a nonzero subdiagonal entry.
+ */
+template <typename T>
+void QRMethod<T>::BlockEigs(const Eigen::Matrix<T, -1, -1> &S, const int &lo, const int &hi,
+                            Eigen::Vector<std::complex<double>, -1> &eigs) {
+    int k = lo;
+    while (k <= hi) {
+        if (k < hi && S(k + 1, k) != T(0)) {
+            Eigs2x2(S, k, eigs);
+            k += 2;
+        }
+        else {
+            eigs[k] = S(k, k);
+            k += 1;
+        }
+    }
+}
+
+/**
+ * @details The eigenvalues of the block \f$\begin{bmatrix} a & b \\ c & d\end{bmatrix}\f$ are
+ * \f$\mu \pm \sqrt{\delta}\f$, with \f$\mu = (a+d)/2\f$ and \f$\delta = (a-d)^2/4 + bc\f$. If \f$\delta < 0\f$ they
+ * are a complex conjugate pair, otherwise the smallest in magnitude is computed as the ratio between the determinant
+ * and the largest in magnitude, to avoid cancellation.
+ */
+template <typename T>
+void QRMethod<T>::Eigs2x2(const Eigen::Matrix<T, -1, -1> &H, const int &k,
+                          Eigen::Vector<std::complex<double>, -1> &eigs) {
+    double a = H(k, k), b = H(k, k + 1), c = H(k + 1, k), d = H(k + 1, k + 1);
+    double mu = 0.5 * (a + d);
+    double p = 0.5 * (a - d);
+    double delta = p * p + b * c;
+    if (delta < 0) {
+        eigs[k] = std::complex<double>(mu, std::sqrt(-delta));
+        eigs[k + 1] = std::complex<double>(mu, -std::sqrt(-delta));
+    }
+    else {
+        double lambda = mu + std::copysign(std::sqrt(delta), mu);
+        eigs[k] = lambda;
+        eigs[k + 1] = (lambda != 0) ? (a * d - b * c) / lambda : 0.0;
+    }
+}
+
+/**
+ * @details Computes the eigenvalues reducing the matrix to upper Hessenberg form and executing implicit single-shift
+ * QR steps on the trailing unreduced block (active window). The transformations are applied only to the active window.
+ *
+ * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+Eigen::Vector<std::complex<double>, -1> QRMethod<std::complex<double>>::ComputeEigs() {
+    // Initializing the necessary variables
+    int n = (this->_A).rows();
+    int it = 0; // Total number of iterations
+    int its = 0; // Number of iterations since the last deflation
+    Eigen::Vector<std::complex<double>, -1> eigs(n);
+
+    // Reduction to upper Hessenberg form, skipped if the matrix is already in Hessenberg form
+    const Eigen::Matrix<std::complex<double>, -1, -1> &W = this->WorkMatrix();
+    bool hessenberg = n < 3 || W.bottomLeftCorner(n - 1, n - 1).triangularView<Eigen::StrictlyLower>()
+                                .toDenseMatrix().isZero(0);
+    Eigen::Matrix<std::complex<double>, -1, -1> H = hessenberg ? W : HessenbergReduction<std::complex<double>>(W).GetMatrixH();
+
+    // Loop: hi is the last row of the block that has not converged yet
+    int hi = n - 1;
+    while (hi >= 0) {
+        // Looking for a negligible subdiagonal entry: lo is the first row of the active window
+        int lo = hi;
+        while (lo > 0 && !Negligible(H, lo)) {
+            lo--;
+        }
+        if (lo > 0) {
+            H(lo, lo - 1) = 0;
+        }
+
+        if (lo == hi) {
+            // Deflation of an eigenvalue
+            eigs[hi] = H(hi, hi);
+            hi -= 1;
+            its = 0;
+        }
+        else {
+            // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+            if (it == this->_maxit) {
+                this->_it = it;
+                throw(ConvergenceError("Reached maximum number of iterations"));
+            }
+            WilkinsonStep(H, lo, hi, its == 10 || its == 20);
+            its++;
+            it++;
+        }
+    }
+    this->_it = it;
+
+    // Returning the eigenvalues in descending order of absolute value
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (std::abs(i) != std::abs(j)) {
+            return std::abs(i) > std::abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(eigs.data(), eigs.data() + eigs.size(), abs_complex);
     return eigs;
 }
 
+/**
+ * @details The subdiagonal entry is considered negligible if \f$|h_{k,k-1}| < \epsilon (|h_{k-1,k-1}| + |h_{k,k}|)\f$,
+ * as for real matrices.
+ */
+bool QRMethod<std::complex<double>>::Negligible(const Eigen::Matrix<std::complex<double>, -1, -1> &H, const int &k) {
+    double scale = std::abs(H(k - 1, k - 1)) + std::abs(H(k, k));
+    if (scale == 0) {
+        scale = H.norm();
+    }
+    return std::abs(H(k, k - 1)) <= this->_tol * scale;
+}
+
+/**
+ * @details The Wilkinson shift is the eigenvalue \f$\mu\f$ of the trailing block
+ * \f$\begin{bmatrix} a & b \\ c & d\end{bmatrix}\f$ closest to \f$d\f$, i.e.
+ * \f$\mu = d - bc / (p + \sqrt{p^2 + bc})\f$ with \f$p = (a - d)/2\f$ and the sign of the square root chosen to
+ * maximize the modulus of the denominator. The exceptional shift is \f$d + \frac{3}{4}|c|\f$, as in the LAPACK routine
+ * <tt>zlahqr</tt>.
+ *
+ * The first Givens rotation annihilates the second entry of the first column of \f$H - \mu I\f$; applied by
+ * similarity it creates a bulge in the position \f$(lo+2, lo)\f$, which each following rotation moves one position
+ * down the diagonal until it falls off the active window.
+ */
+void QRMethod<std::complex<double>>::WilkinsonStep(Eigen::Matrix<std::complex<double>, -1, -1> &H, const int &lo,
+                                                   const int &hi, const bool &exceptional) {
+    using c = std::complex<double>;
+    int m = hi - lo + 1;
+    auto Hw = H.block(lo, lo, m, m); // Active window
+
+    // Shift
+    c mu;
+    c a = Hw(m - 2, m - 2), b = Hw(m - 2, m - 1), cc = Hw(m - 1, m - 2), d = Hw(m - 1, m - 1);
+    if (exceptional) {
+        mu = d + 0.75 * std::abs(cc);
+    }
+    else {
+        c p = 0.5 * (a - d);
+        c r = std::sqrt(p * p + b * cc);
+        c den = (std::abs(p + r) >= std::abs(p - r)) ? p + r : p - r;
+        mu = (den == c(0)) ? d : d - b * cc / den;
+    }
+
+    // Chasing the bulge
+    Eigen::JacobiRotation<c> G;
+    for (int k = 0; k < m - 1; k++) {
+        if (k == 0) {
+            G.makeGivens(Hw(0, 0) - mu, Hw(1, 0));
+        }
+        else {
+            G.makeGivens(Hw(k, k - 1), Hw(k + 1, k - 1));
+        }
+        int c0 = std::max(k - 1, 0);
+        Hw.rightCols(m - c0).applyOnTheLeft(k, k + 1, G.adjoint());
+        Hw.topRows(std::min(k + 3, m)).applyOnTheRight(k, k + 1, G);
+        if (k > 0) {
+            Hw(k + 1, k - 1) = 0;
+        }
+    }
+}
+
 // Explicit instantiation for double
 template class QRMethod<double>;
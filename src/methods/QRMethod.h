@@ -2,13 +2,15 @@
 #define QRMETHOD_H
 
 #include "AbstractEigs.h"
+#include "HessenbergReduction.h"
+#include <utility>
 
 /** @class QRMethod
  * @brief Class for computing eigenvalues of general matrices using the QR Method.
- * @tparam T Can be only <tt>double</tt>.
- * @todo Extend also to <tt>std::complex<double></tt>
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>. The class is specialized for
+ * <tt>std::complex<double></tt>, see QRMethod<std::complex<double>>.
  * @details The QR method @cite GolubVanLoan computes all the eigenvalues of matrix.
- * The QR Method can be described in the following way:
+ * The basic QR Method can be described in the following way:
  *  1. Set \f$A^{(0)} = A\f$
  *  2. At each iteration \f$k\f$:
  *      1. Compute the QR factorization of \f$A^{(k)} = QR\f$
@@ -16,17 +18,41 @@
  *      3. If not converged, return to step 2.a
  *  3. If converged, return the diagonal of \f$A^{(k+1)}\f$
  *
- *  The stopping criterion that determines if the method converged is \f$||diag(A^{(k+1)}) - diag(A^{(k)})|| < \epsilon ||diag(A^{(k+1)})||\f$,
- *  where \f$\epsilon\f$ is a prescribed tolerance. In any case, the iterations are stopped when \f$k\f$ exceeds the
- *  maximum number of iterations and in this case the method is said to be non-convergent for the specific instance.
+ * Each iteration of the basic scheme costs \f$O(n^3)\f$ operations and the convergence is only linear. Our
+ * implementation follows instead the practical QR algorithm @cite GolubVanLoan :
+ *  1. The matrix is first reduced to upper Hessenberg form \f$H = Q^T A Q\f$ with the blocked HessenbergReduction,
+ *  and the form is preserved by the QR iterations.
+ *  2. At each iteration an implicit double-shift Francis step is executed on \f$H\f$: the shifts are the two
+ *  eigenvalues of the trailing \f$2\times2\f$ block of \f$H\f$ and the step is carried out by introducing a small
+ *  bulge in the top-left corner and chasing it down the diagonal with \f$3\times3\f$ Householder reflectors. Each
+ *  step costs \f$O(n^2)\f$ operations, only real arithmetic is used even when the shifts are complex conjugate and
+ *  the convergence is locally quadratic.
+ *  3. The subdiagonal entries \f$h_{k,k-1}\f$ such that \f$|h_{k,k-1}| < \epsilon (|h_{k-1,k-1}| + |h_{k,k}|)\f$, where
+ *  \f$\epsilon\f$ is a prescribed tolerance, are considered negligible and set to zero. This splits \f$H\f$ into
+ *  independent unreduced diagonal blocks, and the Francis steps are executed only on the trailing unreduced block (the
+ *  active window), without updating the rest of the matrix. When a \f$1\times1\f$ block deflates at the bottom of the
+ *  active window its entry is an eigenvalue; when a \f$2\times2\f$ block deflates it is a block of the real Schur form
+ *  and its two eigenvalues, possibly a complex conjugate pair, are computed directly. The converged eigenvalues do not
+ *  cost any further operation and the method stops when every block has deflated.
  *
- * If the matrix \f$A\f$ is real and has real eigenvalues, under some technical conditions the method is proved to
- * be convergent. In particular, the sequence of matrices \f$A^{(k)}\f$ converges an upper triangular matrix if the and
- * the diagonal elements of \f$A^{(k)}\f$ converge to the eigenvalues.
- * If the matrix is real but with complex conjugate eigenvalues, the sequence converges to an almost upper triangular
- * matrix, where the main subdiagonal has nonzero entries only when there is a complex conjugate pair of eigenvalues.
- * This second case is not handled by our implementation, that only works if the matrix is real with real eigenvalues.
- * @todo Handle the case of complex conjugate eigenvalues for real matrices.
+ * For large matrices even the double-shift steps are limited by the memory bandwidth, since each step sweeps the
+ * whole active window with level-2 operations. When the active window is larger than 75, one iteration consists of
+ * @cite GolubVanLoan :
+ *  1. An aggressive early deflation: the Schur form \f$S = V^T W V\f$ of a trailing window \f$W\f$ of the active window
+ *  is computed. Since the window is coupled to the rest of the matrix only by the subdiagonal entry \f$s\f$ above it,
+ *  after the similarity the coupling becomes the spike vector \f$s V^T e_1\f$ and every eigenvalue of \f$S\f$ whose
+ *  spike component is negligible deflates, even when no subdiagonal entry of \f$H\f$ is small. The blocks that do not
+ *  deflate are moved to the top of the window by swapping adjacent blocks of \f$S\f$, and the Hessenberg form is then
+ *  restored.
+ *  2. A multishift sweep: the eigenvalues of the window that did not deflate are used as shifts. Many bulges, one
+ *  for each pair of shifts, are introduced and chased down the diagonal as a tightly packed chain. The reflectors are
+ *  applied only to a small diagonal slab around the chain and accumulated in an orthogonal matrix \f$U\f$; the rest of
+ *  the rows and columns is updated with matrix-matrix products by \f$U\f$ (level-3 operations). The sweep is skipped if
+ *  the aggressive early deflation alone deflated a large part of the window.
+ *
+ * The maximum number of iterations bounds the total number of Francis steps and multishift iterations. If it is reached
+ * the method is said to be non-convergent for the specific instance. The eigenvalues are returned in descending order
+ * of absolute value.
  *
  *  Usage:
  *  @code{.cpp}
@@ -78,7 +104,7 @@ public:
     /**
      * @copydoc  AbstractEigs::AbstractEigs(std::map<std::string, std::any> &map)
      */
-    QRMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {};
+    QRMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {this->CheckDense();};
 
     // Destructor
     virtual ~QRMethod() override {};
@@ -88,6 +114,183 @@ public:
      * @return Vector of complex numbers containing the eigenvalues computed using the QR method.
      */
     virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Size of the active window above which the multishift iteration with aggressive early deflation is used.
+     * @details Below this size the double-shift Francis steps are used. The value is the one used by LAPACK.
+     */
+    static constexpr int _nmin = 75;
+
+    /**
+     * @brief Percentage of the deflation window that has to deflate to skip the multishift sweep.
+     */
+    static constexpr int _nibble = 14;
+
+    /**
+     * @brief Computes the eigenvalues of an upper Hessenberg matrix.
+     * @param H Upper Hessenberg matrix. It is overwritten with a quasi upper triangular matrix if Z is given.
+     * @param Z Pointer to the matrix in which the orthogonal transformations are accumulated. If it is
+     * <tt>nullptr</tt>, only the eigenvalues are computed and the transformations are applied only to the active window.
+     * @param eigs Vector in which the eigenvalues are stored.
+     * @param it Number of iterations, incremented at each Francis step or multishift iteration.
+     */
+    void QRAlgorithm(Eigen::Matrix<T, -1, -1> &H, Eigen::Matrix<T, -1, -1> *Z,
+                     Eigen::Vector<std::complex<double>, -1> &eigs, int &it);
+
+    /**
+     * @brief Returns true if the subdiagonal entry \f$h_{k,k-1}\f$ of the Hessenberg matrix is negligible.
+     * @param H Upper Hessenberg matrix.
+     * @param k Row index of the subdiagonal entry, with \f$k \geq 1\f$.
+     */
+    bool Negligible(const Eigen::Matrix<T, -1, -1> &H, const int &k);
+
+    /**
+     * @brief Executes one implicit double-shift Francis step on the active window of a Hessenberg matrix.
+     * @param H Upper Hessenberg matrix, overwritten with the result of the step.
+     * @param lo Index of the first row and column of the active window.
+     * @param hi Index of the last row and column of the active window.
+     * @param exceptional If true, an exceptional shift is used in place of the eigenvalues of the trailing block.
+     * @param Z Pointer to the matrix in which the transformations are accumulated, or <tt>nullptr</tt>.
+     */
+    void FrancisStep(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi, const bool &exceptional,
+                     Eigen::Matrix<T, -1, -1> *Z);
+
+    /**
+     * @brief Executes one iteration of the multishift QR algorithm with aggressive early deflation.
+     * @param H Upper Hessenberg matrix, overwritten with the result of the iteration.
+     * @param lo Index of the first row and column of the active window.
+     * @param hi Index of the last row and column of the active window.
+     * @param its Number of iterations since the last deflation.
+     * @param Z Pointer to the matrix in which the transformations are accumulated, or <tt>nullptr</tt>.
+     * @param eigs Vector in which the deflated eigenvalues are stored.
+     * @return Number of eigenvalues deflated at the bottom of the active window.
+     */
+    int MultishiftIteration(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi, const int &its,
+                            Eigen::Matrix<T, -1, -1> *Z, Eigen::Vector<std::complex<double>, -1> &eigs);
+
+    /**
+     * @brief Executes the aggressive early deflation on the trailing window of the active window.
+     * @param H Upper Hessenberg matrix, overwritten with the result of the deflation.
+     * @param lo Index of the first row and column of the active window.
+     * @param hi Index of the last row and column of the active window.
+     * @param nw Size of the deflation window.
+     * @param Z Pointer to the matrix in which the transformations are accumulated, or <tt>nullptr</tt>.
+     * @param eigs Vector in which the deflated eigenvalues are stored.
+     * @param shifts Vector in which the eigenvalues of the deflation window that did not deflate are stored.
+     * @return Number of eigenvalues deflated.
+     */
+    int AggressiveEarlyDeflation(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi, const int &nw,
+                                 Eigen::Matrix<T, -1, -1> *Z, Eigen::Vector<std::complex<double>, -1> &eigs,
+                                 Eigen::Vector<std::complex<double>, -1> &shifts);
+
+    /**
+     * @brief Swaps two adjacent diagonal blocks of a quasi upper triangular matrix.
+     * @param S Quasi upper triangular matrix.
+     * @param V Matrix in which the orthogonal transformation is accumulated.
+     * @param j Index of the first row and column of the upper block.
+     * @param p Size of the upper block (1 or 2).
+     * @param q Size of the lower block (1 or 2).
+     * @return False if the swap is too ill-conditioned to be executed, true otherwise.
+     */
+    static bool SwapBlocks(Eigen::Matrix<T, -1, -1> &S, Eigen::Matrix<T, -1, -1> &V, const int &j, const int &p,
+                           const int &q);
+
+    /**
+     * @brief Chases a chain of tightly packed bulges down the active window of a Hessenberg matrix.
+     * @param H Upper Hessenberg matrix, overwritten with the result of the sweep.
+     * @param lo Index of the first row and column of the active window.
+     * @param hi Index of the last row and column of the active window.
+     * @param shifts Sum and product of the pair of shifts of each bulge.
+     * @param Z Pointer to the matrix in which the transformations are accumulated, or <tt>nullptr</tt>.
+     */
+    void MultishiftSweep(Eigen::Matrix<T, -1, -1> &H, const int &lo, const int &hi,
+                         const std::vector<std::pair<double, double>> &shifts, Eigen::Matrix<T, -1, -1> *Z);
+
+    /**
+     * @brief Computes the eigenvalues of the diagonal blocks of a quasi upper triangular matrix.
+     * @param S Quasi upper triangular matrix.
+     * @param lo Index of the first row and column of the diagonal blocks.
+     * @param hi Index of the last row and column of the diagonal blocks.
+     * @param eigs Vector in which the eigenvalues are stored, in the positions from \f$lo\f$ to \f$hi\f$.
+     */
+    static void BlockEigs(const Eigen::Matrix<T, -1, -1> &S, const int &lo, const int &hi,
+                          Eigen::Vector<std::complex<double>, -1> &eigs);
+
+    /**
+     * @brief Computes the two eigenvalues of a \f$2\times2\f$ block of the real Schur form.
+     * @param H Quasi upper triangular matrix.
+     * @param k Index of the first row and column of the block.
+     * @param eigs Vector in which the two eigenvalues are stored, in the positions \f$k\f$ and \f$k+1\f$.
+     */
+    static void Eigs2x2(const Eigen::Matrix<T, -1, -1> &H, const int &k, Eigen::Vector<std::complex<double>, -1> &eigs);
+};
+
+/** @class QRMethod<std::complex<double>>
+ * @brief Class for computing eigenvalues of general complex matrices using the QR Method.
+ * @details The eigenvalues of a complex matrix do not occur in conjugate pairs, therefore the double-shift steps of
+ * QRMethod are not needed and the practical QR algorithm is executed in complex arithmetic, converging to the complex
+ * Schur form @cite GolubVanLoan :
+ *  1. The matrix is first reduced to upper Hessenberg form \f$H = Q^* A Q\f$ with the blocked HessenbergReduction,
+ *  skipped if the matrix is already in Hessenberg form.
+ *  2. At each iteration an implicit single-shift QR step is executed on \f$H\f$, with the Wilkinson shift, i.e. the
+ *  eigenvalue of the trailing \f$2\times2\f$ block of \f$H\f$ closest to its last diagonal entry. The step is
+ *  carried out by a Givens rotation in the top-left corner that creates a bulge below the subdiagonal, chased down the
+ *  diagonal with further Givens rotations, and costs \f$O(n^2)\f$ operations.
+ *  3. The negligible subdiagonal entries are set to zero and the steps are executed only on the trailing unreduced
+ *  block, as for real matrices. When a \f$1\times1\f$ block deflates at the bottom of the active window its entry is
+ *  an eigenvalue.
+ *
+ * All the eigenvalues are computed in one pass costing \f$O(n^3)\f$ operations. If the same eigenvalue does not converge
+ * after 10 or 20 steps, an exceptional shift is used for one step. The eigenvalues are returned in descending order of
+ * absolute value.
+ */
+template <> class QRMethod<std::complex<double>> : public AbstractEigs<std::complex<double>>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     */
+    QRMethod(const Eigen::Matrix<std::complex<double>, -1, -1> &A) : AbstractEigs<std::complex<double>>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     */
+    QRMethod(const Eigen::Matrix<std::complex<double>, -1, -1> &A, const double &tol, const double &maxit)
+    : AbstractEigs<std::complex<double>>(A, tol, maxit) {};
+
+    /**
+     * @copydoc  AbstractEigs::AbstractEigs(std::map<std::string, std::any> &map)
+     */
+    QRMethod(std::map<std::string, std::any> &map) : AbstractEigs<std::complex<double>>(map) {CheckDense();};
+
+    // Destructor
+    virtual ~QRMethod() override {};
+
+    /**
+     * @brief Returns the eigenvalues computed using the QR method.
+     * @return Vector of complex numbers containing the eigenvalues computed using the QR method.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Returns true if the subdiagonal entry \f$h_{k,k-1}\f$ of the Hessenberg matrix is negligible.
+     * @param H Upper Hessenberg matrix.
+     * @param k Row index of the subdiagonal entry, with \f$k \geq 1\f$.
+     */
+    bool Negligible(const Eigen::Matrix<std::complex<double>, -1, -1> &H, const int &k);
+
+    /**
+     * @brief Executes one implicit single-shift QR step on the active window of a Hessenberg matrix.
+     * @param H Upper Hessenberg matrix, overwritten with the result of the step.
+     * @param lo Index of the first row and column of the active window.
+     * @param hi Index of the last row and column of the active window.
+     * @param exceptional If true, an exceptional shift is used in place of the Wilkinson shift.
+     */
+    static void WilkinsonStep(Eigen::Matrix<std::complex<double>, -1, -1> &H, const int &lo, const int &hi,
+                              const bool &exceptional);
 };
 
 #endif //QRMETHOD_H_
@@ -0,0 +1,107 @@
+#include "RitzPairs.h"
+#include <algorithm>
+#include <numeric>
+
+// SORTING
+/*
+ * Returns true if the Ritz value a comes before the Ritz value b in the given order.
+ */
+template <typename T>
+static bool Before(const std::complex<double> &a, const std::complex<double> &b,
+                   const typename RitzPairs<T>::Order &order) {
+    if (order == RitzPairs<T>::LARGEST_REAL) {
+        return a.real() > b.real();
+    }
+    return std::abs(a) > std::abs(b);
+}
+
+// COMPUTATION OF THE RITZ PAIRS
+/**
+ * @details The eigenvalues of the real projected matrix are computed by Eigen::EigenSolver, whose pseudo-eigenvectors
+ * store the eigenvector \f$u + iv\f$ of a pair of complex conjugate eigenvalues as the two real columns \f$u\f$ and
+ * \f$v\f$. The two eigenvalues of a pair are exactly conjugate, so that the pairs are moved together when sorting.
+ */
+template <>
+void RitzPairs<double>::Compute(const Eigen::Matrix<double, -1, -1> &H, const Order &order) {
+    int p = H.rows();
+    Eigen::EigenSolver<Eigen::Matrix<double, -1, -1>> solver(H);
+    const Eigen::Vector<std::complex<double>, -1> &eigenvalues = solver.eigenvalues();
+    Eigen::Matrix<double, -1, -1> V = solver.pseudoEigenvectors();
+
+    // First column of each single eigenvalue or pair, sorted
+    std::vector<int> first;
+    for (int i = 0; i < p; i++) {
+        first.push_back(i);
+        if (eigenvalues[i].imag() != 0 && i + 1 < p) {
+            i++;
+        }
+    }
+    std::stable_sort(first.begin(), first.end(),
+                     [&eigenvalues, &order](int i, int j) {return Before<double>(eigenvalues[i], eigenvalues[j], order);});
+
+    _values.resize(p);
+    _vectors.resize(p, p);
+    _units.assign(p, 1);
+    int col = 0;
+    for (int i : first) {
+        _values[col] = eigenvalues[i];
+        _vectors.col(col) = V.col(i);
+        if (eigenvalues[i].imag() != 0 && i + 1 < p) {
+            _values[col + 1] = eigenvalues[i + 1];
+            _vectors.col(col + 1) = V.col(i + 1);
+            _units[col] = 2;
+            _units[col + 1] = 0;
+            col++;
+        }
+        col++;
+    }
+}
+
+template <>
+void RitzPairs<std::complex<double>>::Compute(const Eigen::Matrix<std::complex<double>, -1, -1> &H,
+                                              const Order &order) {
+    int p = H.rows();
+    Eigen::ComplexEigenSolver<Eigen::Matrix<std::complex<double>, -1, -1>> solver(H);
+    const Eigen::Vector<std::complex<double>, -1> &eigenvalues = solver.eigenvalues();
+
+    std::vector<int> sorted(p);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(), [&eigenvalues, &order](int i, int j) {
+        return Before<std::complex<double>>(eigenvalues[i], eigenvalues[j], order);
+    });
+
+    _values.resize(p);
+    _vectors.resize(p, p);
+    _units.assign(p, 1);
+    for (int col = 0; col < p; col++) {
+        _values[col] = eigenvalues[sorted[col]];
+        _vectors.col(col) = solver.eigenvectors().col(sorted[col]);
+    }
+}
+
+// NORMS AND VECTORS
+template <typename T>
+double RitzPairs<T>::Norm(const Eigen::Matrix<T, -1, -1> &MZ, const int &i) const {
+    int first = (_units[i] == 0) ? i - 1 : i;
+    return MZ.middleCols(first, _units[first]).norm();
+}
+
+template <typename T>
+Eigen::Matrix<std::complex<double>, -1, -1> RitzPairs<T>::ComplexVectors(const Eigen::Matrix<T, -1, -1> &VZ,
+                                                                         const int &k) const {
+    Eigen::Matrix<std::complex<double>, -1, -1> X = VZ.leftCols(k).template cast<std::complex<double>>();
+    for (int i = 0; i < k; i++) {
+        if (_units[i] == 2) {
+            X.col(i) += std::complex<double>(0, 1) * VZ.col(i + 1).template cast<std::complex<double>>();
+            if (i + 1 < k) {
+                X.col(i + 1) = X.col(i).conjugate();
+            }
+        }
+        X.col(i).normalize();
+    }
+    return X;
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class RitzPairs<double>;
+template class RitzPairs<std::complex<double>>;
@@ -0,0 +1,98 @@
+#ifndef RITZPAIRS_H_
+#define RITZPAIRS_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include <vector>
+
+/** @class RitzPairs
+ * @brief Class computing the Ritz pairs of a small projected matrix, sorted according to the wanted part of the
+ * spectrum.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The projection methods (SubspaceIteration, ArnoldiMethod) approximate the eigenpairs of a large matrix
+ * \f$A\f$ with the eigenpairs \f$(\theta_i, z_i)\f$ of the small matrix \f$H = V^*AV\f$, where the columns of \f$V\f$
+ * are an orthonormal basis of the subspace: the Ritz values \f$\theta_i\f$ approximate the eigenvalues of \f$A\f$ and
+ * the Ritz vectors \f$Vz_i\f$ its eigenvectors.
+ *
+ * The eigenpairs of \f$H\f$ are sorted in descending order of absolute value or of real part. For a real matrix
+ * \f$H\f$ the eigenvectors of a pair of complex conjugate eigenvalues \f$\theta, \bar\theta\f$ are \f$u \pm iv\f$: they
+ * are stored as the two real columns \f$u\f$ and \f$v\f$, so that the projection methods use only real arithmetic, and
+ * the two columns are always kept adjacent and in this order. The pair forms a unit of size 2.
+ */
+template <typename T> class RitzPairs {
+public:
+    /**
+     * @brief Order in which the Ritz pairs are sorted.
+     */
+    enum Order {
+        LARGEST_MAGNITUDE, /**< Descending order of absolute value. */
+        LARGEST_REAL /**< Descending order of real part. */
+    };
+
+    /**
+     * @brief Computes the Ritz pairs of a projected matrix.
+     * @param H Square projected matrix.
+     * @param order Order in which the Ritz pairs are sorted.
+     */
+    void Compute(const Eigen::Matrix<T, -1, -1> &H, const Order &order = LARGEST_MAGNITUDE);
+
+    /**
+     * @brief Returns the sorted Ritz values.
+     */
+    const Eigen::Vector<std::complex<double>, -1> &GetValues() const {return _values;};
+
+    /**
+     * @brief Returns the matrix whose columns are the eigenvectors of the projected matrix, sorted as the Ritz values.
+     * @details For a real projected matrix, the columns of a pair of complex conjugate Ritz values are the real and the
+     * imaginary part of the eigenvector of the first one.
+     */
+    const Eigen::Matrix<T, -1, -1> &GetVectors() const {return _vectors;};
+
+    /**
+     * @brief Returns the size of the unit starting at a given column: 1 for a single column, 2 for the first column of
+     * a pair of complex conjugate Ritz values and 0 for the second one.
+     * @param i Index of the column.
+     */
+    int GetUnit(const int &i) const {return _units[i];};
+
+    /**
+     * @brief Returns the number of columns that contain the first \f$k\f$ Ritz pairs without splitting a pair of
+     * complex conjugate Ritz values, i.e. \f$k\f$ or \f$k+1\f$.
+     * @param k Number of Ritz pairs.
+     */
+    int Cover(const int &k) const {return (k > 0 && _units[k - 1] == 2) ? k + 1 : k;};
+
+    /**
+     * @brief Returns the norm of the vector \f$Mz_i\f$, given the matrix \f$MZ\f$, where \f$Z\f$ is the matrix of the
+     * eigenvectors: for a pair of complex conjugate Ritz values, \f$||M(u + iv)|| = (||Mu||^2 + ||Mv||^2)^{1/2}\f$.
+     * @param MZ Product of a matrix with the first columns of the matrix of the eigenvectors.
+     * @param i Index of the Ritz pair.
+     */
+    double Norm(const Eigen::Matrix<T, -1, -1> &MZ, const int &i) const;
+
+    /**
+     * @brief Returns the first \f$k\f$ Ritz vectors as complex normalized vectors.
+     * @param VZ Product of the basis of the subspace with the first columns of the matrix of the eigenvectors, at least
+     * RitzPairs::Cover(k) columns.
+     * @param k Number of Ritz vectors.
+     */
+    Eigen::Matrix<std::complex<double>, -1, -1> ComplexVectors(const Eigen::Matrix<T, -1, -1> &VZ, const int &k) const;
+
+private:
+    /**
+     * @brief Sorted Ritz values.
+     */
+    Eigen::Vector<std::complex<double>, -1> _values;
+
+    /**
+     * @brief Eigenvectors of the projected matrix, sorted as the Ritz values.
+     */
+    Eigen::Matrix<T, -1, -1> _vectors;
+
+    /**
+     * @brief Sizes of the units of columns, see RitzPairs::GetUnit.
+     */
+    std::vector<int> _units;
+};
+
+#endif //RITZPAIRS_H_
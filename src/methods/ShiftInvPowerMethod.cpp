@@ -1,21 +1,234 @@
 #include "ShiftInvPowerMethod.h"
+#include "IterationKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 /**
- * @details The method has been overridden to add an initial step that computes the LU factorization of the shifted
- * matrix.
+ * @details At least the matrix has to be provided. If the factorization is not provided, it is chosen looking at the
+ * shifted matrix. If the initial vector, the tolerance, the maximum number of iterations or the shift are not provided,
+ * they are set to the default value and a warning is given to the user.
+ */
+template <typename T>
+ShiftInvPowerMethod<T>::ShiftInvPowerMethod(std::map<std::string, std::any> &map) : ShiftPowerMethod<T>(map) {
+    this->CheckStored();
+
+    // Getting and setting the factorization
+    if (map.count("factorization") > 0) {
+        std::string factorization;
+        try {
+            factorization = std::any_cast<std::string>(map["factorization"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the factorization to string"));
+        }
+        SetFactorization(factorization);
+    }
+
+    // Getting and setting the refactorization period
+    if (map.count("refactorization") > 0) {
+        double period;
+        try {
+            period = std::any_cast<double>(map["refactorization"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the refactorization period to double"));
+        }
+        SetRefactorizationPeriod(int(period));
+    }
+}
+
+/**
+ * @details The method has been overridden to add an initial step that computes the factorization of the shifted
+ * matrix. If the refactorization period is positive, the Rayleigh quotient iteration is executed instead of the
+ * iterations of AbstractPowerMethod::ComputeEigs().
  */
 template <typename T>
 Eigen::Vector<std::complex<double>, -1> ShiftInvPowerMethod<T>::ComputeEigs() {
-    _LU = (this->_A - this->_shift * Eigen::Matrix<T, -1, -1>::Identity((this->_A).rows(),
-                                                                        (this->_A).cols())).fullPivLu();
-    return AbstractPowerMethod<T>::ComputeEigs();
+    _refactorizations = 0;
+    Factorize(this->_shift);
+    if (_refactorization_period == 0) {
+        return AbstractPowerMethod<T>::ComputeEigs();
+    }
+    Eigen::Vector<std::complex<double>, 1> eigs;
+    eigs[0] = RayleighQuotientIteration();
+    return eigs;
+}
+
+/**
+ * @details The factorization is computed on the shifted Hessenberg matrix if a Hessenberg reduction is provided. Dense
+ * factorizations are taken from the cache if they have already been computed for the same matrix and the same shift.
+ * If the matrix is sparse, its sparse factorization is computed instead, executing the symbolic analysis only in the
+ * first call and then only the numeric factorization.
+ */
+template <typename T>
+void ShiftInvPowerMethod<T>::Factorize(const T &shift) {
+    if (this->_hessenberg) {
+        HessenbergLU(shift);
+    }
+    else if (this->_sparse) {
+        if (!_sparse_factorization.IsAnalyzed()) {
+            _sparse_factorization.Analyze(this->_A_sparse);
+        }
+        _sparse_factorization.Factorize(shift);
+    }
+    else {
+        // The planar layout replaces the strategy of the factorization
+        std::string method = this->UsePlanarLayout() ? "planarlu" : _factorization_method;
+        _factorization = _cache->Factorize(this->WorkMatrix(), shift, method);
+    }
+}
+
+/**
+ * @details Each iteration solves \f$(A - \sigma I)y = x\f$, where \f$x\f$ is the normalized iterate, and computes the
+ * Rayleigh quotient of the new iterate \f$y / ||y||\f$ without any product with \f$A\f$, since
+ * \f[ \frac{y^*Ay}{y^*y} = \sigma + \frac{y^*(A - \sigma I)y}{y^*y} = \sigma + \frac{y^*x}{||y||^2}. \f]
+ * The quotient is computed in the same pass that computes the norm of \f$y\f$ (IterationKernels::ScaleNormDot). Every
+ * ShiftInvPowerMethod::_refactorization_period iterations the shift becomes the Rayleigh quotient and the shifted matrix
+ * is factorized again, keeping the symbolic analysis of sparse matrices. The iterations stop when
+ * \f$|\rho^{(k+1)} - \rho^{(k)}| < \epsilon |\rho^{(k+1)}|\f$, where \f$\rho^{(k)}\f$ is the Rayleigh quotient at
+ * iteration \f$k\f$ and \f$\rho^{(0)} = \sigma\f$. If the shift is an eigenvalue to the working precision, the
+ * factorization fails or the solution of the system is not finite: the shift is then returned, with the last iterate
+ * as eigenvector.
+ *
+ * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+T ShiftInvPowerMethod<T>::RayleighQuotientIteration() {
+    T shift = this->_shift;
+    T rho = shift; // Rayleigh quotient of the current iterate
+    double norm2; // Squared norm of the solution of the system
+    bool converged = false;
+    int it = 0;
+    this->_products = 0;
+
+    this->_x = this->StartingVector();
+    this->_x /= this->_x.norm();
+    this->_x_mul.resize(this->_x.size());
+    while (!converged && it < this->_maxit) {
+        Multiply(this->_x, this->_x_mul);
+        this->_products++;
+        it++;
+        if (!this->_x_mul.allFinite()) {
+            rho = shift;
+            break;
+        }
+        // Normalizing the new iterate and computing its Rayleigh quotient
+        T dot = IterationKernels<T>::ScaleNormDot(this->_x.data(), this->_x_mul.data(), this->_x.size(), 1, norm2);
+        T rho_prev = rho;
+        rho = shift + Eigen::numext::conj(dot) / norm2;
+        this->_x.swap(this->_x_mul);
+        this->_x /= std::sqrt(norm2);
+        converged = std::abs(rho - rho_prev) < this->_tol * std::abs(rho);
+
+        // Updating the shift and factorizing the shifted matrix again
+        if (!converged && it % _refactorization_period == 0 && rho != shift) {
+            shift = rho;
+            _refactorizations++;
+            try {
+                Factorize(shift);
+            }
+            catch (ConvergenceError &e) {
+                // The shifted matrix is singular: the Rayleigh quotient is an eigenvalue
+                converged = true;
+            }
+        }
+    }
+
+    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    this->_it = it;
+    if (it == this->_maxit && !converged) {
+        throw(ConvergenceError("Reached maximum number of iterations"));
+    }
+
+    // Storing the eigenvector and returning the eigenvalue
+    this->_v = this->BackTransform(this->_x);
+    this->_v = this->_v / this->_v.norm();
+    return rho;
+}
+
+/**
+ * @details At step \f$k\f$ the only nonzero entry below the diagonal in column \f$k\f$ is in row \f$k+1\f$, therefore
+ * the pivot is chosen between rows \f$k\f$ and \f$k+1\f$ and only row \f$k+1\f$ is updated. Exactly zero pivots,
+ * occurring when the shift is an eigenvalue, are replaced by \f$\epsilon ||H||\f$ as in the LAPACK routine
+ * <tt>dlaein</tt>, so that the solution is a very good approximation of the eigenvector.
+ */
+template <typename T>
+void ShiftInvPowerMethod<T>::HessenbergLU(const T &shift) {
+    int n = (this->_H).rows();
+    _hessenberg_LU = this->_H - shift * Eigen::Matrix<T, -1, -1>::Identity(n, n);
+    _swapped.assign(std::max(n - 1, 0), false);
+    double small_pivot = std::numeric_limits<double>::epsilon() * std::max((this->_H).norm(), 1.0);
+
+    for (int k = 0; k < n - 1; k++) {
+        if (std::abs(_hessenberg_LU(k + 1, k)) > std::abs(_hessenberg_LU(k, k))) {
+            _hessenberg_LU.row(k).tail(n - k).swap(_hessenberg_LU.row(k + 1).tail(n - k));
+            _swapped[k] = true;
+        }
+        if (_hessenberg_LU(k, k) == T(0)) {
+            _hessenberg_LU(k, k) = small_pivot;
+        }
+        T l = _hessenberg_LU(k + 1, k) / _hessenberg_LU(k, k);
+        _hessenberg_LU.row(k + 1).tail(n - k - 1) -= l * _hessenberg_LU.row(k).tail(n - k - 1);
+        _hessenberg_LU(k + 1, k) = l;
+    }
+    if (n > 0 && _hessenberg_LU(n - 1, n - 1) == T(0)) {
+        _hessenberg_LU(n - 1, n - 1) = small_pivot;
+    }
 }
 
 template <typename T>
-Eigen::Vector<T, -1> ShiftInvPowerMethod<T>::Multiply(const Eigen::Vector<T, -1> &x) {
-    // The multiplication is executed solving a system, given the already computed LU factorization of the shifted
+void ShiftInvPowerMethod<T>::Multiply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+    // The multiplication is executed solving a system, given the already computed factorization of the shifted
     // matrix.
-    return _LU.solve(x);
+    if (this->_sparse && !this->_hessenberg) {
+        _sparse_factorization.Solve(x, y);
+        return;
+    }
+    if (!this->_hessenberg) {
+        _factorization->Solve(x, y);
+        return;
+    }
+    // Forward substitution with the row swaps and the multipliers, then backward substitution with U
+    y = x;
+    for (int k = 0; k < y.size() - 1; k++) {
+        if (_swapped[k]) {
+            std::swap(y(k), y(k + 1));
+        }
+        y(k + 1) -= _hessenberg_LU(k + 1, k) * y(k);
+    }
+    _hessenberg_LU.template triangularView<Eigen::Upper>().solveInPlace(y);
+}
+
+template <typename T>
+void ShiftInvPowerMethod<T>::SetFactorization(const std::string &factorization) {
+    DenseFactorization<T>::CheckMethod(factorization);
+    _factorization_method = factorization;
+}
+
+/**
+ * @details If the period is negative, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a negative refactorization period</tt>.
+ */
+template <typename T>
+void ShiftInvPowerMethod<T>::SetRefactorizationPeriod(const int &period) {
+    if (period < 0) {
+        throw(InitializationError("Attempting to set a negative refactorization period"));
+    }
+    _refactorization_period = period;
+}
+
+/**
+ * @details If the given cache is null, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to set a null factorization cache</tt>.
+ */
+template <typename T>
+void ShiftInvPowerMethod<T>::SetFactorizationCache(const std::shared_ptr<FactorizationCache<T>> &cache) {
+    if (!cache) {
+        throw(InitializationError("Attempting to set a null factorization cache"));
+    }
+    _cache = cache;
 }
 
 // Explicit instantiation for double and std::complex<double>
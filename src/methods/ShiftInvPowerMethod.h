@@ -2,6 +2,10 @@
 #define SHIFTINVPOWERMETHOD_H_
 
 #include "ShiftPowerMethod.h"
+#include "DenseFactorization.h"
+#include "FactorizationCache.h"
+#include "SparseFactorization.h"
+#include <vector>
 
 /** @class ShiftInvPowerMethod
  * @brief Class for computing the the eigenvalue of a matrix \f$A\f$ closest to a particular value \f$\sigma\f$ using the Inverse
@@ -11,7 +15,7 @@
  * closest to a particular value \f$\sigma\f$.
  * The Inverse Power Method with shift can be described in the following way:
  *  1. Starting from an initial nonzero vector \f$x^{(0)}\f$, divide it by its norm: \f$x^{(0)} = x^{(0)} / ||x^{(0)}||\f$
- *  2. Compute the LU factorization of \f$A - \sigma I\f$
+ *  2. Compute a factorization of \f$A - \sigma I\f$, for instance the LU factorization
  *  3. At each iteration \f$k\f$:
  *      1. Solve \f$(A - \sigma I)x^{(k+1)} = x^{(k)}\f$
  *      2. \f$x^{(k+1)} = x^{(k+1)} / ||x^{(k+1)}||\f$
@@ -23,6 +27,38 @@
  *  where \f$\epsilon\f$ is a prescribed tolerance. In any case, the iterations are stopped when \f$k\f$ exceeds the
  *  maximum number of iterations and in this case the method is said to be non-convergent for the specific instance.
  *
+ *  The factorization of a dense matrix is chosen by ShiftInvPowerMethod::SetFactorization or by the key
+ *  <tt>factorization</tt> of the map-based constructor. By default it is chosen looking at the shifted matrix: the
+ *  Cholesky factorization for symmetric or Hermitian positive definite matrices, the LU factorization with partial
+ *  pivoting otherwise. For shifts very close to an eigenvalue the QR factorization with column pivoting can be
+ *  selected. @see DenseFactorization
+ *
+ *  The factorization is stored in a cache, keyed by a fingerprint of the matrix and by the shift, so that it is
+ *  computed again only after ShiftPowerMethod::SetShift, and not after changing the initial vector, the tolerance or
+ *  the maximum number of iterations. By default the cache is owned by the solver and stores only the last
+ *  factorization: a cache storing the factorizations of several shifts can be shared among solvers with
+ *  ShiftInvPowerMethod::SetFactorizationCache. @see FactorizationCache
+ *
+ *  If a Hessenberg reduction \f$A = Q H Q^*\f$ is provided with ShiftPowerMethod::SetHessenbergReduction, the LU
+ *  factorization is computed on \f$H - \sigma I\f$: since only one entry per column lies below the diagonal, the
+ *  partial pivoting only compares adjacent rows and the factorization costs \f$O(n^2)\f$ operations instead of
+ *  \f$O(n^3)\f$. This makes it cheap to run the method for many shifts with the same reduction.
+ *
+ *  If the matrix is sparse, the LU factorization is replaced by a sparse factorization with a fill-reducing ordering,
+ *  an \f$LDL^*\f$ factorization if the matrix is symmetric or Hermitian and the shift is real. The ordering and the
+ *  symbolic analysis depend only on the pattern of \f$A\f$: they are computed by the first call of ComputeEigs() and
+ *  reused by the following calls, so that after ShiftPowerMethod::SetShift only the numeric factorization is repeated.
+ *  @see SparseFactorization
+ *
+ *  With a fixed shift the convergence is linear, with ratio \f$|\lambda - \sigma| / |\lambda' - \sigma|\f$, where
+ *  \f$\lambda'\f$ is the second closest eigenvalue to \f$\sigma\f$. If a refactorization period \f$p > 0\f$ is set
+ *  with ShiftInvPowerMethod::SetRefactorizationPeriod, the method becomes the Rayleigh quotient iteration
+ *  @cite GolubVanLoan: every \f$p\f$ iterations the shift is replaced by the Rayleigh quotient of the current iterate
+ *  and the shifted matrix is factorized again. For \f$p = 1\f$ the convergence is quadratic, and cubic for symmetric or
+ *  Hermitian matrices, at the cost of one factorization per iteration; larger periods trade iterations for
+ *  factorizations. The shift set by the user is only the initial one, and the eigenvalue returned is the one to which
+ *  the iterations converge, which is not necessarily the closest to it.
+ *
  *  Usage:
  *  @code{.cpp}
     double tol = 1e-10;
@@ -71,13 +107,76 @@ public:
                         ShiftPowerMethod<T>(A, tol, maxit, x0, shift) {};
 
     /**
-     * @copydoc ShiftPowerMethod::ShiftPowerMethod(std::map<std::string, std::any> &map)
+     * @copydoc  ShiftPowerMethod::ShiftPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
      */
-    ShiftInvPowerMethod(std::map<std::string, std::any> &map) : ShiftPowerMethod<T>(map) {};
+    ShiftInvPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : ShiftPowerMethod<T>(A) {};
+
+    /**
+     * @copydoc  ShiftPowerMethod::ShiftPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit, const Eigen::Vector<T, -1> &x0, const T &shift)
+     */
+    ShiftInvPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit,
+                        const Eigen::Vector<T,-1> &x0, const T &shift) :
+                        ShiftPowerMethod<T>(A, tol, maxit, x0, shift) {};
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the initial vector with <tt>x0</tt>, the shift with <tt>shift</tt>, the name of the
+     * factorization, as <tt>std::string</tt>, with <tt>factorization</tt> and the refactorization period with
+     * <tt>refactorization</tt>.
+     */
+    ShiftInvPowerMethod(std::map<std::string, std::any> &map);
 
     // Destructor
     virtual ~ShiftInvPowerMethod() override {};
 
+    /**
+     * @brief Sets the strategy of the factorization of the shifted matrix, if it is dense.
+     * @param factorization Name of the strategy: <tt>auto</tt> (default), <tt>partialpivlu</tt>, <tt>fullpivlu</tt>,
+     * <tt>llt</tt>, <tt>ldlt</tt>, <tt>qr</tt> or <tt>planarlu</tt>. @see DenseFactorization
+     */
+    void SetFactorization(const std::string &factorization);
+
+    /**
+     * @brief Returns the strategy of the factorization of the shifted matrix.
+     */
+    std::string GetFactorization() {return _factorization_method;};
+
+    /**
+     * @brief Returns the factorization computed by the last call of ComputeEigs(), which is the one chosen by the
+     * strategy <tt>auto</tt>.
+     */
+    std::string GetComputedFactorization() {return _factorization ? _factorization->GetComputedMethod() : "";};
+
+    /**
+     * @brief Sets the cache storing the factorizations of the shifted matrix, which can be shared with other solvers.
+     * @param cache Cache of the factorizations. @see FactorizationCache
+     */
+    void SetFactorizationCache(const std::shared_ptr<FactorizationCache<T>> &cache);
+
+    /**
+     * @brief Returns the cache storing the factorizations of the shifted matrix.
+     */
+    std::shared_ptr<FactorizationCache<T>> GetFactorizationCache() {return _cache;};
+
+    /**
+     * @brief Sets the number of iterations after which the shift is updated to the Rayleigh quotient.
+     * @param period Number of iterations between two factorizations; zero (default) keeps the shift fixed.
+     */
+    void SetRefactorizationPeriod(const int &period);
+
+    /**
+     * @brief Returns the number of iterations after which the shift is updated to the Rayleigh quotient.
+     */
+    int GetRefactorizationPeriod() {return _refactorization_period;};
+
+    /**
+     * @brief Returns the number of times the shift was updated and the shifted matrix factorized again by the last call
+     * of ComputeEigs().
+     */
+    int GetRefactorizations() {return _refactorizations;};
+
     /**
      * @brief Returns the eigenvalues computed using the inverse power method with shift.
      * @return Vector of complex numbers containing the eigenvalue of \f$A\f$ that is the closest to the shift.
@@ -86,9 +185,66 @@ public:
 
 private:
     /**
-     * @brief Member that stores the LU factorization of the shifted matrix.
+     * @brief Member that stores the factorization of the shifted matrix.
+     */
+    std::shared_ptr<const DenseFactorization<T>> _factorization;
+
+    /**
+     * @brief Member that stores the strategy of the factorization of the shifted matrix.
+     */
+    std::string _factorization_method = "auto";
+
+    /**
+     * @brief Member that stores the cache of the factorizations of the shifted matrix, by default owned by the solver and
+     * storing only the last factorization.
+     */
+    std::shared_ptr<FactorizationCache<T>> _cache = std::make_shared<FactorizationCache<T>>();
+
+    /**
+     * @brief Member that stores the sparse factorization of the shifted matrix, if the matrix is sparse.
+     */
+    SparseFactorization<T> _sparse_factorization;
+
+    /**
+     * @brief Member that stores the LU factorization of the shifted Hessenberg matrix, if a reduction is provided.
+     * @details \f$U\f$ is stored on and above the diagonal, the multipliers on the subdiagonal.
+     */
+    Eigen::Matrix<T, -1, -1> _hessenberg_LU;
+
+    /**
+     * @brief Member that stores whether rows \f$k\f$ and \f$k+1\f$ were swapped at step \f$k\f$ of the factorization
+     * of the shifted Hessenberg matrix.
+     */
+    std::vector<bool> _swapped;
+
+    /**
+     * @brief Member that stores the number of iterations after which the shift is updated, zero for a fixed shift.
+     */
+    int _refactorization_period = 0;
+
+    /**
+     * @brief Member that stores the number of refactorizations executed by the last call of ComputeEigs().
+     */
+    int _refactorizations = 0;
+
+    /**
+     * @brief Factorizes the matrix shifted by the given shift, with the factorization chosen for the matrix.
+     * @param shift Shift of the matrix.
+     */
+    void Factorize(const T &shift);
+
+    /**
+     * @brief Computes the LU factorization with partial pivoting of the shifted Hessenberg matrix.
+     * @param shift Shift of the Hessenberg matrix.
+     */
+    void HessenbergLU(const T &shift);
+
+    /**
+     * @brief Executes the Rayleigh quotient iteration, updating the shift every
+     * ShiftInvPowerMethod::_refactorization_period iterations.
+     * @return The eigenvalue to which the iterations converge.
      */
-    Eigen::FullPivLU<Eigen::Matrix<T, -1, -1>> _LU;
+    T RayleighQuotientIteration();
 
     /**
      * Method to return the eigenvalue of the matrix _A.
@@ -101,9 +257,9 @@ private:
     /**
      * @brief Executes the multiplication step of the inverse power method with shift.
      * @param x vector to be multiplied.
-     * @return Result of the multiplication step, i.e. \f$ (A-sI)^{-1}x\f$.
+     * @param y result of the multiplication step, i.e. \f$ (A-sI)^{-1}x\f$.
      */
-    Eigen::Vector<T,-1> Multiply(const Eigen::Vector<T,-1> &x) override;
+    void Multiply(const Eigen::Vector<T,-1> &x, Eigen::Vector<T,-1> &y) override;
 
 
 };
@@ -1,4 +1,5 @@
 #include "ShiftPowerMethod.h"
+#include "IterationKernels.h"
 
 // CONSTUCTOR
 /**
@@ -24,6 +25,83 @@ ShiftPowerMethod<T>::ShiftPowerMethod(std::map<std::string, std::any> &map) : Ab
     }
 }
 
+// SETTING METHODS
+/**
+ * @details If the size of the reduction does not match the size of the matrix whose eigenvalues are to be computed, it
+ * throws an exception of type InitializationError with message:
+ * <tt>Attempting to set Hessenberg reduction with incorrect size</tt>.
+ */
+template <typename T>
+void ShiftPowerMethod<T>::SetHessenbergReduction(const std::shared_ptr<const HessenbergReduction<T>> &hessenberg) {
+    if (hessenberg->GetSize() != this->GetSize()) {
+        throw(InitializationError("Attempting to set Hessenberg reduction with incorrect size"));
+    }
+    _hessenberg = hessenberg;
+    _H = hessenberg->GetMatrixH();
+}
+
+/**
+ * @details If the matrix is balanced, the reduction has to be the one of the balanced matrix.
+ */
+template <typename T>
+Eigen::Vector<T, -1> ShiftPowerMethod<T>::StartingVector() {
+    if (!_hessenberg) {
+        return AbstractPowerMethod<T>::StartingVector();
+    }
+    Eigen::Matrix<T, -1, -1> x = AbstractPowerMethod<T>::StartingVector();
+    _hessenberg->ApplyQAdjoint(x);
+    return x.col(0);
+}
+
+template <typename T>
+Eigen::Vector<T, -1> ShiftPowerMethod<T>::BackTransform(const Eigen::Vector<T, -1> &x) {
+    if (!_hessenberg) {
+        return AbstractPowerMethod<T>::BackTransform(x);
+    }
+    Eigen::Matrix<T, -1, -1> y = x;
+    _hessenberg->ApplyQ(y);
+    return AbstractPowerMethod<T>::BackTransform(y.col(0));
+}
+
+/**
+ * @details The product with a sparse matrix in compressed sparse row format is executed by Eigen row by row, in
+ * parallel if OpenMP is available and the matrix has enough nonzero entries. The products with dense matrices are
+ * executed by IterationKernels::Gemv, with the instruction set selected at run time.
+ */
+/**
+ * @details The method has been overridden to add an initial step that copies the matrix, or the upper Hessenberg
+ * matrix if a Hessenberg reduction is provided, in planar layout, if the planar layout is selected and the matrix is
+ * dense and complex.
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> ShiftPowerMethod<T>::ComputeEigs() {
+    if (this->UsePlanarLayout()) {
+        _planar_matrix.Set(_hessenberg ? _H : this->WorkMatrix());
+    }
+    return AbstractPowerMethod<T>::ComputeEigs();
+}
+
+template <typename T>
+void ShiftPowerMethod<T>::Multiply(const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+    if (this->UsePlanarLayout()) {
+        _planar_matrix.Multiply(x, y);
+    }
+    else if (_hessenberg) {
+        IterationKernels<T>::Gemv(_H.data(), x.data(), y.data(), _H.rows(), _H.cols());
+    }
+    else if (this->_operator) {
+        this->_operator->Apply(x, y);
+    }
+    else if (this->_sparse) {
+        y.noalias() = this->_A_sparse * x;
+    }
+    else {
+        const Eigen::Matrix<T, -1, -1> &A = this->WorkMatrix();
+        IterationKernels<T>::Gemv(A.data(), x.data(), y.data(), A.rows(), A.cols());
+    }
+    y -= _shift * x;
+}
+
 // Explicit instantiation for double and std::complex<double>
 template class ShiftPowerMethod<double>;
 template class ShiftPowerMethod<std::complex<double>>;
\ No newline at end of file
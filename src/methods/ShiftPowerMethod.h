@@ -2,6 +2,9 @@
 #define SHIFTPOWERMETHOD_H_
 
 #include "AbstractPowerMethod.h"
+#include "HessenbergReduction.h"
+#include "PlanarMatrix.h"
+#include <memory>
 
 /** @class ShiftPowerMethod
  * @brief Class for computing the the eigenvalue of a matrix \f$A\f$ farthes from a particular value \f$\sigma\f$ using the
@@ -21,6 +24,15 @@
  *  where \f$\epsilon\f$ is a prescribed tolerance. In any case, the iterations are stopped when \f$k\f$ exceeds the
  *  maximum number of iterations and in this case the method is said to be non-convergent for the specific instance.
  *
+ *  The matrix can also be given in compressed sparse row format, as <tt>Eigen::SparseMatrix<T, Eigen::RowMajor></tt>:
+ *  each iteration then costs \f$O(nnz)\f$ operations and the shifted matrix is never formed. It can also be given as a
+ *  LinearOperator, which is only applied to vectors.
+ *
+ *  A precomputed Hessenberg reduction \f$A = Q H Q^*\f$ can be provided with ShiftPowerMethod::SetHessenbergReduction.
+ *  In this case the iterations are executed on \f$H - \sigma I\f$ starting from \f$Q^* x^{(0)}\f$, which gives the same
+ *  approximations of the eigenvalue since \f$Q\f$ is unitary. The same reduction can be shared among many solvers with
+ *  different shifts.
+ *
  *  Usage:
  *  @code{.cpp}
     double tol = 1e-10;
@@ -75,6 +87,42 @@ public:
                      const Eigen::Vector<T, -1> &x0, const T &shift) : AbstractPowerMethod<T>(A, tol, maxit, x0)
                              {_shift = shift;};
 
+    /**
+     * @copydoc AbstractEigs<T>::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    ShiftPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractPowerMethod<T>(A) {};
+
+    /**
+     * @brief Constructor; sets the given sparse matrix, tolerance, maximum number of iterations initial vector and
+     * shift.
+     * @param A Square sparse matrix whose eigenvalues are to be computed.
+     * @param tol Tolerance to be used in the stopping criterion of the method.
+     * @param maxit Maximum number of iterations for which the method is to be executed.
+     * @param x0 Initial vector for the iterations of the method.
+     * @param shift Shift applied to the matrix.
+     */
+    ShiftPowerMethod(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit,
+                     const Eigen::Vector<T, -1> &x0, const T &shift) : AbstractPowerMethod<T>(A, tol, maxit, x0)
+                             {_shift = shift;};
+
+    /**
+     * @copydoc AbstractEigs<T>::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    ShiftPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractPowerMethod<T>(A) {};
+
+    /**
+     * @brief Constructor; sets the given linear operator, tolerance, maximum number of iterations initial vector and
+     * shift.
+     * @param A Linear operator whose eigenvalues are to be computed.
+     * @param tol Tolerance to be used in the stopping criterion of the method.
+     * @param maxit Maximum number of iterations for which the method is to be executed.
+     * @param x0 Initial vector for the iterations of the method.
+     * @param shift Shift applied to the operator.
+     */
+    ShiftPowerMethod(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit,
+                     const Eigen::Vector<T, -1> &x0, const T &shift) : AbstractPowerMethod<T>(A, tol, maxit, x0)
+                             {_shift = shift;};
+
     /**
      * @brief Constructor; sets the parameters of the method from a map.
      * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
@@ -86,6 +134,12 @@ public:
     // Destructor
     virtual ~ShiftPowerMethod() override {};
 
+    /**
+     * @brief Returns the eigenvalues computed using the power method with shift.
+     * @return Vector of complex numbers containing the eigenvalue of \f$A\f$ farthest from the shift.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
     /**
      * @brief Sets the shift.
      * @param shift Shift applied to the matrix.
@@ -97,8 +151,36 @@ public:
      */
     T GetShift() {return _shift;};
 
+    /**
+     * @brief Sets a precomputed Hessenberg reduction of the matrix, on which the iterations are then executed.
+     * @param hessenberg Hessenberg reduction of the matrix whose eigenvalues are to be computed, or of the balanced
+     * matrix Balancing::GetMatrix() if the balancing is enabled.
+     */
+    void SetHessenbergReduction(const std::shared_ptr<const HessenbergReduction<T>> &hessenberg);
+
 protected:
 
+    /**
+     * @brief Hessenberg reduction of the matrix, if provided.
+     */
+    std::shared_ptr<const HessenbergReduction<T>> _hessenberg;
+
+    /**
+     * @brief Upper Hessenberg matrix \f$H\f$ of the reduction, if provided.
+     */
+    Eigen::Matrix<T, -1, -1> _H;
+
+    /**
+     * @brief Returns the initial vector, mapped to \f$Q^* x^{(0)}\f$ if a Hessenberg reduction is provided.
+     */
+    Eigen::Vector<T,-1> StartingVector() override;
+
+    /**
+     * @brief Maps the vector back to the basis of the matrix, applying \f$Q\f$ first if a Hessenberg reduction is
+     * provided.
+     */
+    Eigen::Vector<T,-1> BackTransform(const Eigen::Vector<T,-1> &x) override;
+
     /**
      * @brief Shift applied to the matrix.
      * @details Default value: \f$0\f$.
@@ -107,6 +189,12 @@ protected:
 
 private:
 
+    /**
+     * @brief Matrix, or upper Hessenberg matrix \f$H\f$ if a Hessenberg reduction is provided, in planar layout, if
+     * the planar layout is selected.
+     */
+    PlanarMatrix<T> _planar_matrix;
+
     /**
      * Method to return the eigenvalue of the matrix _A.
      * @param lambda approximation obtained at the end of the iterations of the power method applied to (_A - _shift * I).
@@ -117,8 +205,9 @@ private:
     /**
      * @brief Executes the multiplication step of the power method with shift.
      * @param x vector to be multiplied.
-     * @return Result of the multiplication step, i.e. \f$ (A-sI)x = Ax - sx\f$.
+     * @param y result of the multiplication step, i.e. \f$ (A-sI)x = Ax - sx\f$, or \f$ (H-sI)x\f$ if a Hessenberg
+     * reduction is provided.
      */
-    virtual Eigen::Vector<T,-1> Multiply(const Eigen::Vector<T,-1> &x) override {return this->_A * x - _shift * x;};
+    virtual void Multiply(const Eigen::Vector<T,-1> &x, Eigen::Vector<T,-1> &y) override;
 };
 #endif //SHIFTPOWERMETHOD_H_
@@ -0,0 +1,125 @@
+#include "SparseFactorization.h"
+
+/**
+ * @details The diagonal entries that are not stored in \f$A\f$ are stored as explicit zeros, so that the shifted
+ * matrices all have the same pattern. The symbolic analyses executed for a previous matrix are discarded.
+ *
+ * If the given matrix is non square, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to factorize a non square matrix</tt>.
+ */
+template <typename T>
+void SparseFactorization<T>::Analyze(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) {
+    if (A.rows() != A.cols()) {
+        throw(InitializationError("Attempting to factorize a non square matrix"));
+    }
+    int n = A.rows();
+
+    // Pattern of A together with the diagonal
+    std::vector<Eigen::Triplet<T>> triplets;
+    triplets.reserve(A.nonZeros() + n);
+    for (int i = 0; i < A.outerSize(); i++) {
+        for (typename Eigen::SparseMatrix<T, Eigen::RowMajor>::InnerIterator it(A, i); it; ++it) {
+            triplets.emplace_back(it.row(), it.col(), it.value());
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        triplets.emplace_back(i, i, T(0));
+    }
+    _shifted.resize(n, n);
+    _shifted.setFromTriplets(triplets.begin(), triplets.end());
+    _shifted.makeCompressed();
+    _values = Eigen::Map<const Eigen::Vector<T, -1>>(_shifted.valuePtr(), _shifted.nonZeros());
+
+    // Positions of the diagonal entries
+    _diagonal.assign(n, 0);
+    for (int j = 0; j < n; j++) {
+        for (int p = _shifted.outerIndexPtr()[j]; p < _shifted.outerIndexPtr()[j + 1]; p++) {
+            if (_shifted.innerIndexPtr()[p] == j) {
+                _diagonal[j] = p;
+                break;
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<T> difference = _shifted - Eigen::SparseMatrix<T>(_shifted.adjoint());
+    _self_adjoint = difference.norm() <= 1e-12 * _shifted.norm();
+    _analyzed = true;
+    _lu_analyzed = false;
+    _ldlt_analyzed = false;
+    _factorized = false;
+}
+
+/**
+ * @details The values of the shifted matrix are overwritten in place, so that its pattern, and therefore the symbolic
+ * analysis, stays the same. The \f$LDL^*\f$ factorization does not pivot, therefore it can break down on a zero pivot
+ * even if the shifted matrix is non singular: in this case the LU factorization, which pivots, is computed instead.
+ * If the last factorization was computed with the same shift, it is kept and nothing is computed.
+ *
+ * If SparseFactorization::Analyze has not been called, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to factorize before setting the matrix</tt>.
+ */
+template <typename T>
+void SparseFactorization<T>::Factorize(const T &shift) {
+    if (!_analyzed) {
+        throw(InitializationError("Attempting to factorize before setting the matrix"));
+    }
+    if (_factorized && shift == _shift) {
+        return;
+    }
+    _factorized = false;
+    Eigen::Map<Eigen::Vector<T, -1>>(_shifted.valuePtr(), _shifted.nonZeros()) = _values;
+    for (int p : _diagonal) {
+        _shifted.valuePtr()[p] -= shift;
+    }
+
+    _use_ldlt = _self_adjoint && std::imag(shift) == 0;
+    bool success = false;
+    if (_use_ldlt) {
+        if (!_ldlt_analyzed) {
+            _ldlt.analyzePattern(_shifted);
+            _ldlt_analyzed = true;
+            _symbolic_count++;
+        }
+        _ldlt.factorize(_shifted);
+        _numeric_count++;
+        success = (_ldlt.info() == Eigen::Success);
+        // Without pivoting, a zero pivot can occur even if the shifted matrix is non singular
+        _use_ldlt = success;
+    }
+    if (!_use_ldlt) {
+        if (!_lu_analyzed) {
+            _lu.analyzePattern(_shifted);
+            _lu_analyzed = true;
+            _symbolic_count++;
+        }
+        _lu.factorize(_shifted);
+        _numeric_count++;
+        success = (_lu.info() == Eigen::Success);
+    }
+    if (!success) {
+        throw(ConvergenceError("Unable to factorize the shifted matrix"));
+    }
+    _factorized = true;
+    _shift = shift;
+}
+
+template <typename T>
+Eigen::Vector<T, -1> SparseFactorization<T>::Solve(const Eigen::Vector<T, -1> &b) const {
+    Eigen::Vector<T, -1> x(b.size());
+    Solve(b, x);
+    return x;
+}
+
+template <typename T>
+void SparseFactorization<T>::Solve(const Eigen::Vector<T, -1> &b, Eigen::Vector<T, -1> &x) const {
+    if (_use_ldlt) {
+        x = _ldlt.solve(b);
+    }
+    else {
+        x = _lu.solve(b);
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class SparseFactorization<double>;
+template class SparseFactorization<std::complex<double>>;
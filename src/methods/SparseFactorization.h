@@ -0,0 +1,181 @@
+#ifndef SPARSEFACTORIZATION_H_
+#define SPARSEFACTORIZATION_H_
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+#include <complex>
+#include <vector>
+#include "Exceptions.h"
+
+/** @class SparseFactorization
+ * @brief Class for factorizing the shifted matrices \f$A - \sigma I\f$ of a sparse matrix \f$A\f$, for many shifts
+ * \f$\sigma\f$.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The factorization of a sparse matrix is split in two phases @cite Davis :
+ *  1. the symbolic analysis, which depends only on the sparsity pattern: a fill-reducing ordering of the rows and
+ *  columns is computed and the pattern of the factors is determined;
+ *  2. the numeric factorization, which computes the entries of the factors.
+ *
+ * All the shifted matrices have the same pattern, i.e. the pattern of \f$A\f$ together with the diagonal, which is
+ * stored by SparseFactorization::Analyze. Therefore the symbolic analysis is executed only by the first call of
+ * SparseFactorization::Factorize, and the following calls with different shifts only repeat the numeric factorization.
+ *
+ * If \f$A\f$ is symmetric or Hermitian and the shift is real, \f$A - \sigma I\f$ is self-adjoint and it is factorized
+ * as \f$LDL^*\f$ with the approximate minimum degree ordering (<tt>Eigen::SimplicialLDLT</tt>), which only uses the
+ * lower triangular part and costs about half of the LU factorization. Otherwise it is factorized as \f$PA = LU\f$ with
+ * the column approximate minimum degree ordering (<tt>Eigen::SparseLU</tt>), which is also the fallback if the
+ * \f$LDL^*\f$ factorization, computed without pivoting, meets a zero pivot. The symbolic analysis of each of the two
+ * factorizations is executed the first time it is needed.
+ *
+ * If the numeric factorization fails, for instance because the shift is exactly an eigenvalue of \f$A\f$,
+ * SparseFactorization::Factorize throws an exception of type ConvergenceError with message
+ * <tt>Unable to factorize the shifted matrix</tt>.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    SparseFactorization<double> factorization(A);
+    for (double shift : shifts) {
+        factorization.Factorize(shift); // Numeric factorization only
+        std::cout << factorization.Solve(b).transpose() << std::endl;
+    }
+ *  @endcode
+ */
+template <typename T> class SparseFactorization {
+public:
+    /**
+     * @brief Default constructor; the matrix has to be set calling SparseFactorization::Analyze.
+     */
+    SparseFactorization() {};
+
+    /**
+     * @brief Constructor; stores the pattern of the shifted matrices of the given matrix.
+     * @param A Square sparse matrix.
+     */
+    SparseFactorization(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) {Analyze(A);};
+
+    /**
+     * @brief Stores the pattern of the shifted matrices of the given matrix and detects if it is self-adjoint.
+     * @param A Square sparse matrix.
+     */
+    void Analyze(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A);
+
+    /**
+     * @brief Computes the numeric factorization of \f$A - \sigma I\f$, unless it has already been computed.
+     * @param shift Shift \f$\sigma\f$.
+     */
+    void Factorize(const T &shift);
+
+    /**
+     * @brief Solves \f$(A - \sigma I)x = b\f$ with the last computed factorization.
+     * @param b Right-hand side.
+     * @return Solution \f$x\f$.
+     */
+    Eigen::Vector<T, -1> Solve(const Eigen::Vector<T, -1> &b) const;
+
+    /**
+     * @brief Solves \f$(A - \sigma I)x = b\f$ with the last computed factorization, writing the solution in the given
+     * vector.
+     * @param b Right-hand side.
+     * @param x Solution, resized only if its size is wrong.
+     */
+    void Solve(const Eigen::Vector<T, -1> &b, Eigen::Vector<T, -1> &x) const;
+
+    /**
+     * @brief Returns true if SparseFactorization::Analyze has been called.
+     */
+    bool IsAnalyzed() const {return _analyzed;};
+
+    /**
+     * @brief Returns true if the matrix is symmetric or Hermitian.
+     */
+    bool IsSelfAdjoint() const {return _self_adjoint;};
+
+    /**
+     * @brief Returns true if the last factorization is an \f$LDL^*\f$ factorization, false if it is an LU factorization.
+     */
+    bool UsesLDLT() const {return _use_ldlt;};
+
+    /**
+     * @brief Returns the number of symbolic analyses executed, at most one for each kind of factorization.
+     */
+    int GetSymbolicCount() const {return _symbolic_count;};
+
+    /**
+     * @brief Returns the number of numeric factorizations executed.
+     */
+    int GetNumericCount() const {return _numeric_count;};
+
+private:
+
+    /**
+     * @brief Shifted matrix, in compressed column format with the diagonal entries explicitly stored.
+     */
+    Eigen::SparseMatrix<T> _shifted;
+
+    /**
+     * @brief Values of the entries of \f$A\f$, in the order in which they are stored in SparseFactorization::_shifted.
+     */
+    Eigen::Vector<T, -1> _values;
+
+    /**
+     * @brief Positions of the diagonal entries in the array of the values of SparseFactorization::_shifted.
+     */
+    std::vector<int> _diagonal;
+
+    /**
+     * @brief Sparse LU factorization of the shifted matrix.
+     */
+    Eigen::SparseLU<Eigen::SparseMatrix<T>, Eigen::COLAMDOrdering<int>> _lu;
+
+    /**
+     * @brief Sparse \f$LDL^*\f$ factorization of the shifted matrix.
+     */
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<T>, Eigen::Lower, Eigen::AMDOrdering<int>> _ldlt;
+
+    /**
+     * @brief True if the pattern has been stored.
+     */
+    bool _analyzed = false;
+
+    /**
+     * @brief True if the matrix is symmetric or Hermitian.
+     */
+    bool _self_adjoint = false;
+
+    /**
+     * @brief True if the last factorization is an \f$LDL^*\f$ factorization.
+     */
+    bool _use_ldlt = false;
+
+    /**
+     * @brief True if the symbolic analysis of the LU factorization has been executed.
+     */
+    bool _lu_analyzed = false;
+
+    /**
+     * @brief True if the symbolic analysis of the \f$LDL^*\f$ factorization has been executed.
+     */
+    bool _ldlt_analyzed = false;
+
+    /**
+     * @brief Number of symbolic analyses executed.
+     */
+    int _symbolic_count = 0;
+
+    /**
+     * @brief Number of numeric factorizations executed.
+     */
+    int _numeric_count = 0;
+
+    /**
+     * @brief True if the last numeric factorization succeeded.
+     */
+    bool _factorized = false;
+
+    /**
+     * @brief Shift of the last numeric factorization.
+     */
+    T _shift = T(0);
+};
+
+#endif //SPARSEFACTORIZATION_H_
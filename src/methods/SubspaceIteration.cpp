@@ -0,0 +1,210 @@
+#include "SubspaceIteration.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// CONSTRUCTORS
+/**
+ * @details At least the matrix has to be provided. If the number of eigenvalues is not provided, only the largest
+ * magnitude eigenvalue is computed and a warning is given to the user. If the block size is not provided, it is set
+ * by default to \f$\min(n, 2k)\f$. If the tolerance or the maximum number of iterations are not provided, they are set
+ * to the default value and a warning is given to the user.
+ */
+template <typename T>
+SubspaceIteration<T>::SubspaceIteration(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+    // Getting and setting the number of eigenvalues
+    if (map.count("neigs") > 0) {
+        double neigs;
+        try {
+            neigs = std::any_cast<double>(map["neigs"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the number of eigenvalues to double"));
+        }
+        SetNumEigs(int(neigs));
+    }
+    else { // map.count("neigs") == 0
+        std::cerr << "WARNING: Unspecified number of eigenvalues (neigs). Set by default neigs = 1" << std::endl;
+    }
+
+    // Getting and setting the block size
+    if (map.count("block") > 0) {
+        double block_size;
+        try {
+            block_size = std::any_cast<double>(map["block"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the block size to double"));
+        }
+        SetBlockSize(int(block_size));
+    }
+
+    // Getting and setting the degree of the Chebyshev filter
+    if (map.count("filter") > 0) {
+        double degree;
+        try {
+            degree = std::any_cast<double>(map["filter"]);
+        }
+        catch (std::bad_any_cast &e) {
+            throw (InitializationError("Unable to cast the filter degree to double"));
+        }
+        SetFilterDegree(int(degree));
+    }
+}
+
+// SETTING METHODS
+/**
+ * @details If the number of eigenvalues is not between one and the size of the matrix, it throws an exception of type
+ * InitializationError with message: <tt>Attempting to set a number of eigenvalues out of range</tt>. If a block size
+ * smaller than the new number of eigenvalues was set, it is reset to the default one.
+ */
+template <typename T>
+void SubspaceIteration<T>::SetNumEigs(const int &neigs) {
+    if (neigs <= 0 || neigs > this->GetSize()) {
+        throw(InitializationError("Attempting to set a number of eigenvalues out of range"));
+    }
+    _neigs = neigs;
+    if (_block_size < _neigs) {
+        _block_size = 0;
+    }
+}
+
+/**
+ * @details If the block size is smaller than the number of eigenvalues or larger than the size of the matrix, it
+ * throws an exception of type InitializationError with message: <tt>Attempting to set a block size out of range</tt>.
+ */
+template <typename T>
+void SubspaceIteration<T>::SetBlockSize(const int &block_size) {
+    if (block_size < _neigs || block_size > this->GetSize()) {
+        throw(InitializationError("Attempting to set a block size out of range"));
+    }
+    _block_size = block_size;
+}
+
+// COMPUTATION OF EIGENVALUES
+/**
+ * @details The residual of the Ritz pairs is computed from the block residual \f$E = AQ - QH\f$, since
+ * \f$AQz_i - \theta_i Qz_i = AQz_i - QHz_i = Ez_i\f$. For a pair of complex conjugate Ritz values of a real matrix, with
+ * Ritz vector \f$Q(u + iv)\f$, the residual is \f$||Eu + iEv|| = (||Eu||^2 + ||Ev||^2)^{1/2}\f$. To allow zero
+ * eigenvalues, the tolerance is relative to \f$\max(|\theta_i|, \epsilon_m^{2/3} |\theta_1|)\f$, where
+ * \f$\epsilon_m\f$ is the machine precision.
+ *
+ * Each locked vector \f$q\f$ is orthonormalized from the Ritz vectors with a QR factorization \f$QZ = Q'R\f$, so that
+ * its product with \f$A\f$ is obtained as \f$AQ' = AQZR^{-1}\f$ without multiplying by \f$A\f$.
+ *
+ * If the degree of the Chebyshev filter is positive, the damped interval is estimated from
+ * \f$\min(n, \max(20, 2k + 2))\f$ Lanczos steps started from a pseudo-random vector (ChebyshevFilter::Estimate). If the
+ * estimate fails, the iterations are not filtered. Otherwise the initial block and the products \f$AQz_i\f$ of the
+ * vectors that are not locked are filtered before being orthonormalized.
+ *
+ * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> SubspaceIteration<T>::ComputeEigs() {
+    typedef Eigen::Matrix<T, -1, -1> Matrix;
+    int n = this->GetSize();
+    int k = _neigs;
+    int p = GetBlockSize();
+    double eps = std::pow(std::numeric_limits<double>::epsilon(), 2.0 / 3);
+
+    Matrix AQ(n, p), X, Y, H, E, EZ, V, AV, Q_locked;
+    RitzPairs<T> ritz;
+    int locked = 0; // Number of locked vectors, at the beginning of the block
+    int converged = 0; // Number of converged Ritz pairs
+    int it = 0;
+    _products = 0;
+
+    // Products of the Chebyshev filter, counted in the number of products
+    typename ChebyshevFilter<T>::Operator multiply = [this](const Eigen::Vector<T, -1> &x, Eigen::Vector<T, -1> &y) {
+        this->ApplyMatrix(x, y);
+        _products++;
+    };
+    typename ChebyshevFilter<T>::BlockOperator multiply_block = [this](const Matrix &B, Matrix &AB) {
+        this->ApplyMatrix(B, AB);
+        _products += B.cols();
+    };
+    bool filter = _filter.GetDegree() > 0
+                  && _filter.Estimate(multiply, this->RandomBlock(n, 1).col(0), std::min(n, std::max(20, 2 * k + 2)), k);
+
+    // Orthonormal initial block
+    X = this->RandomBlock(n, p);
+    if (filter) {
+        _filter.ApplyBlock(multiply_block, X, Y);
+        X.swap(Y);
+    }
+    Matrix Q = Eigen::HouseholderQR<Matrix>(X).householderQ() * Matrix::Identity(n, p);
+
+    while (true) {
+        // Multiplication step on the vectors that are not locked, as a single block
+        X = Q.rightCols(p - locked);
+        this->ApplyMatrix(X, Y);
+        AQ.rightCols(p - locked) = Y;
+        _products += p - locked;
+        it++;
+
+        // Rayleigh-Ritz projection
+        H.noalias() = Q.adjoint() * AQ;
+        ritz.Compute(H);
+        const Eigen::Vector<std::complex<double>, -1> &theta = ritz.GetValues();
+        const Matrix &Z = ritz.GetVectors();
+
+        // Residuals of the first k Ritz pairs
+        E = AQ;
+        E.noalias() -= Q * H;
+        EZ.noalias() = E * Z.leftCols(ritz.Cover(k));
+        double threshold = eps * std::abs(theta[0]);
+        converged = 0;
+        while (converged < k) {
+            double res = ritz.Norm(EZ, converged);
+            if (res > this->_tol * std::max(std::abs(theta[converged]), threshold) * ritz.Norm(Z, converged)) {
+                break;
+            }
+            converged += ritz.GetUnit(converged);
+        }
+        if (converged >= k || it == this->_maxit) {
+            break;
+        }
+
+        // Locking the converged Ritz vectors
+        V.noalias() = Q * Z;
+        AV.noalias() = AQ * Z;
+        locked = converged;
+        if (locked > 0) {
+            Eigen::HouseholderQR<Matrix> qr(V.leftCols(locked));
+            Q_locked = qr.householderQ() * Matrix::Identity(n, locked);
+            AQ.leftCols(locked) = qr.matrixQR().topLeftCorner(locked, locked).template triangularView<Eigen::Upper>()
+                                    .template solve<Eigen::OnTheRight>(AV.leftCols(locked));
+            Q.leftCols(locked) = Q_locked;
+        }
+
+        // Power step on the other Ritz vectors, filtered and orthonormalized twice against the locked ones
+        X = AV.rightCols(p - locked);
+        if (filter) {
+            _filter.ApplyBlock(multiply_block, X, Y);
+            X.swap(Y);
+        }
+        for (int pass = 0; pass < 2 && locked > 0; pass++) {
+            X.noalias() -= Q_locked * (Q_locked.adjoint() * X);
+        }
+        Q.rightCols(p - locked) = Eigen::HouseholderQR<Matrix>(X).householderQ() * Matrix::Identity(n, p - locked);
+    }
+
+    // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+    this->_it = it;
+    if (converged < k){
+        throw(ConvergenceError("Reached maximum number of iterations"));
+    }
+
+    // Storing the eigenvectors, mapped back to the basis of A
+    V.noalias() = Q * ritz.GetVectors().leftCols(ritz.Cover(k));
+    if (this->_balance) {
+        this->_balancing.BackTransform(V);
+    }
+    _eigenvectors = ritz.ComplexVectors(V, k);
+    return ritz.GetValues().head(k);
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class SubspaceIteration<double>;
+template class SubspaceIteration<std::complex<double>>;
@@ -0,0 +1,197 @@
+#ifndef SUBSPACEITERATION_H_
+#define SUBSPACEITERATION_H_
+
+#include "AbstractEigs.h"
+#include "ChebyshevFilter.h"
+#include "RitzPairs.h"
+
+/** @class SubspaceIteration
+ * @brief Class for computing the largest magnitude eigenvalues of general matrices using the subspace iteration.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The subspace iteration @cite GolubVanLoan (or block power method) computes the \f$k\f$ largest magnitude
+ * eigenvalues of a matrix \f$A\f$. It iterates a block of \f$p \geq k\f$ orthonormal vectors \f$Q\f$ instead of a single
+ * vector, and the subspace spanned by the block converges to the invariant subspace of the \f$p\f$ largest magnitude
+ * eigenvalues. The \f$i\f$-th eigenvalue converges with ratio \f$|\lambda_{p+1} / \lambda_i|\f$, so that a block larger
+ * than \f$k\f$ accelerates the convergence of the wanted eigenvalues. Our implementation can be described in the
+ * following way:
+ *  1. Orthonormalize the initial block \f$Q\f$ with a QR factorization.
+ *  2. At each iteration:
+ *      1. Compute \f$AQ\f$, with a single matrix-matrix product for the whole block.
+ *      2. Compute the projected matrix \f$H = Q^*AQ\f$ of size \f$p\f$ and its eigenpairs \f$(\theta_i, z_i)\f$, sorted
+ *      in descending order of absolute value (Rayleigh-Ritz projection). The Ritz values \f$\theta_i\f$ approximate
+ *      the eigenvalues of \f$A\f$ and the Ritz vectors \f$Qz_i\f$ its eigenvectors.
+ *      3. The Ritz pair is converged if \f$||AQz_i - \theta_i Qz_i|| \leq \epsilon |\theta_i| ||z_i||\f$, where
+ *      \f$\epsilon\f$ is a prescribed tolerance. If the first \f$k\f$ Ritz pairs are converged, return
+ *      \f$\theta_1, \dots, \theta_k\f$.
+ *      4. Lock the leading converged Ritz vectors: they are orthonormalized and kept in the block together with their
+ *      product with \f$A\f$, which is not computed again.
+ *      5. Replace the other vectors of the block by the orthonormalized products \f$AQz_i\f$, and return to step 2.a.
+ *
+ * Since the block is multiplied at once, a dense or sparse matrix is read once per iteration for all the vectors of the
+ * block. The matrix-matrix product (GEMM) reuses each entry of the matrix \f$p\f$ times while it is in cache, and is
+ * much faster than \f$p\f$ separate products with a vector (GEMV), whose speed is limited by the memory bandwidth.
+ * Locked vectors are not multiplied any more, so that the cost of the iterations decreases as the eigenvalues converge.
+ *
+ * For symmetric or Hermitian matrices whose wanted eigenvalues are not well separated, SubspaceIteration::SetFilterDegree
+ * replaces the power step 2.e by a Chebyshev filter (ChebyshevFilter) applied to the products \f$AQz_i\f$: the block is
+ * multiplied by a Chebyshev polynomial of \f$A\f$ damping the interval of the unwanted eigenvalues before each
+ * Rayleigh-Ritz projection (Chebyshev-filtered subspace iteration). The interval is estimated once per call of
+ * ComputeEigs() from a few Lanczos steps. Each iteration then costs the degree plus one block products, but the number
+ * of iterations is much smaller.
+ *
+ * For real matrices the Ritz vectors of a pair of complex conjugate Ritz values are stored as their real and imaginary
+ * parts, so that the iterations use only real arithmetic, and the two vectors are locked together. The block size
+ * should then be larger than \f$k\f$, to contain the whole pair when it is the \f$k\f$-th eigenvalue.
+ *
+ * The matrix can be given as a dense matrix, as a sparse matrix in compressed sparse row format or as a LinearOperator,
+ * in which case LinearOperator::ApplyBlock is used for the products. The initial block is pseudo-random, generated with
+ * a fixed seed so that the results are reproducible. The maximum number of iterations bounds the number of block
+ * iterations. If it is reached the method is said to be non-convergent for the specific instance. The eigenvalues are
+ * returned in descending order of absolute value.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::Matrix<double, -1, -1> A(5,5);
+    A <<    1, 28 , 48, -52, -8,
+            2, -17, -42, 24, 2,
+            0, 12, 25, -12 , 0,
+            2, 0, -4 , 11, 2,
+            -4, -4, 12, 16, 5;
+    SubspaceIteration<double> eigs_solver(A, 1e-10, 1000);
+    eigs_solver.SetNumEigs(2);
+    std::cout << "The two largest magnitude eigenvalues of A are:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class SubspaceIteration : public AbstractEigs<T>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     * @details By default the largest magnitude eigenvalue is computed.
+     */
+    SubspaceIteration(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     * @details By default the largest magnitude eigenvalue is computed.
+     */
+    SubspaceIteration(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A)
+     */
+    SubspaceIteration(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+     */
+    SubspaceIteration(const Eigen::SparseMatrix<T, Eigen::RowMajor> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A)
+     */
+    SubspaceIteration(const std::shared_ptr<const LinearOperator<T>> &A) : AbstractEigs<T>(A) {};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+     */
+    SubspaceIteration(const std::shared_ptr<const LinearOperator<T>> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {};
+
+    /**
+     * @brief Constructor; sets the parameters of the method from a map.
+     * @param map Map containing the parameters of the method. The matrix whose eigenvalues are to be computed has to be
+     * associated with the key <tt>matrix</tt>, the tolerance with <tt>tol</tt>, the maximum number of iterations
+     * with <tt>maxit</tt>, the number of eigenvalues with <tt>neigs</tt>, the block size with <tt>block</tt> and the
+     * degree of the Chebyshev filter with <tt>filter</tt>.
+     */
+    SubspaceIteration(std::map<std::string, std::any> &map);
+
+    // Destructor
+    virtual ~SubspaceIteration() override {};
+
+    /**
+     * @brief Sets the number of eigenvalues to be computed.
+     * @param neigs Number of largest magnitude eigenvalues to be computed.
+     */
+    void SetNumEigs(const int &neigs);
+
+    /**
+     * @brief Sets the number of vectors of the block.
+     * @param block_size Number of vectors of the block, at least the number of eigenvalues to be computed.
+     */
+    void SetBlockSize(const int &block_size);
+
+    /**
+     * @brief Sets the degree of the Chebyshev filter applied before each Rayleigh-Ritz projection.
+     * @param degree Degree of the polynomial; zero (default) disables the filter. The filter assumes that the matrix is
+     * symmetric or Hermitian.
+     */
+    void SetFilterDegree(const int &degree) {_filter.SetDegree(degree);};
+
+    /**
+     * @brief Returns the number of eigenvalues to be computed.
+     */
+    int GetNumEigs() {return _neigs;};
+
+    /**
+     * @brief Returns the number of vectors of the block.
+     */
+    int GetBlockSize() {return _block_size > 0 ? _block_size : std::min(this->GetSize(), 2 * _neigs);};
+
+    /**
+     * @brief Returns the degree of the Chebyshev filter.
+     */
+    int GetFilterDegree() {return _filter.GetDegree();};
+
+    /**
+     * @brief Returns the number of products of the matrix with a vector executed by the last call of ComputeEigs().
+     */
+    int GetProducts() {return _products;};
+
+    /**
+     * @brief Returns the approximations of the eigenvectors computed by the last call of ComputeEigs().
+     * @details The columns are normalized and expressed in the basis of the matrix \f$A\f$, even if the iterations are
+     * executed on the balanced matrix. They are complex even for real matrices, whose eigenvectors can be complex.
+     */
+    Eigen::Matrix<std::complex<double>, -1, -1> GetEigenvectors() {return _eigenvectors;};
+
+    /**
+     * @brief Returns the eigenvalues computed using the subspace iteration.
+     * @return Vector of complex numbers containing the requested eigenvalues in descending order of absolute value.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Number of eigenvalues to be computed.
+     * Default value: <tt>1</tt>.
+     */
+    int _neigs = 1;
+
+    /**
+     * @brief Number of vectors of the block.
+     * @details If zero, the block size is \f$\min(n, 2k)\f$, where \f$k\f$ is the number of eigenvalues.
+     * Default value: <tt>0</tt>.
+     */
+    int _block_size = 0;
+
+    /**
+     * @brief Chebyshev filter applied before each Rayleigh-Ritz projection, disabled by default.
+     */
+    ChebyshevFilter<T> _filter;
+
+    /**
+     * @brief Number of products of the matrix with a vector executed by the last call of ComputeEigs().
+     */
+    int _products = 0;
+
+    /**
+     * @brief Approximations of the eigenvectors computed by the last call of ComputeEigs().
+     */
+    Eigen::Matrix<std::complex<double>, -1, -1> _eigenvectors;
+};
+
+#endif //SUBSPACEITERATION_H_
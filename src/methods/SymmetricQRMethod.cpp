@@ -0,0 +1,116 @@
+#include "SymmetricQRMethod.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @details Computes the eigenvalues reducing the matrix to tridiagonal form and executing implicit QR steps with
+ * Wilkinson shift on the trailing unreduced block of the tridiagonal matrix.
+ *
+ * If the maximum number of iterations is reached it throws an error or type ConvergenceError with message:
+ * <tt>Reached maximum number of iterations</tt>
+ */
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> SymmetricQRMethod<T>::ComputeEigs() {
+    // Reduction to real symmetric tridiagonal form
+    TridiagonalReduction<T> tridiagonal(this->WorkMatrix());
+    Eigen::Vector<double, -1> d = tridiagonal.GetDiagonal();
+    Eigen::Vector<double, -1> e = tridiagonal.GetSubdiagonal();
+    double norm = std::sqrt(d.squaredNorm() + 2 * e.squaredNorm());
+    int it = 0;
+
+    // Loop: hi is the last row of the block that has not converged yet
+    int hi = d.size() - 1;
+    while (hi > 0) {
+        // Looking for a negligible subdiagonal entry: lo is the first row of the active window
+        int lo = hi;
+        while (lo > 0 && !Negligible(d, e, lo, norm)) {
+            lo--;
+        }
+        if (lo > 0) {
+            e(lo - 1) = 0;
+        }
+
+        if (lo == hi) {
+            // Deflation of an eigenvalue
+            hi--;
+        }
+        else {
+            // If the maximum number of iteration is reached, a ConvergenceError is thrown.
+            if (it == this->_maxit) {
+                this->_it = it;
+                throw(ConvergenceError("Reached maximum number of iterations"));
+            }
+            WilkinsonStep(d, e, lo, hi);
+            it++;
+        }
+    }
+    this->_it = it;
+
+    // Returning the eigenvalues in descending order of absolute value
+    Eigen::Vector<std::complex<double>, -1> eigs = d.template cast<std::complex<double>>();
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (std::abs(i) != std::abs(j)) {
+            return std::abs(i) > std::abs(j);
+        }
+        return i.real() > j.real();
+    };
+    std::sort(eigs.data(), eigs.data() + eigs.size(), abs_complex);
+    return eigs;
+}
+
+/**
+ * @details The subdiagonal entry is considered negligible if \f$|t_{k,k-1}| \leq \epsilon (|t_{k-1,k-1}| + |t_{k,k}|)\f$,
+ * where \f$\epsilon\f$ is the tolerance of the method. If both the diagonal entries are zero, the norm of the matrix
+ * is used in place of their sum.
+ */
+template <typename T>
+bool SymmetricQRMethod<T>::Negligible(const Eigen::Vector<double, -1> &d, const Eigen::Vector<double, -1> &e,
+                                      const int &k, const double &norm) {
+    double scale = std::abs(d(k - 1)) + std::abs(d(k));
+    if (scale == 0) {
+        scale = norm;
+    }
+    return std::abs(e(k - 1)) <= this->_tol * scale;
+}
+
+/**
+ * @details The Wilkinson shift is \f$\mu = t_{nn} - t_{n,n-1}^2 / (\delta + \mathrm{sign}(\delta)
+ * \sqrt{\delta^2 + t_{n,n-1}^2})\f$, with \f$\delta = (t_{n-1,n-1} - t_{nn}) / 2\f$. The first Givens rotation is the
+ * one that annihilates the second entry of the first column of \f$T - \mu I\f$; applied to \f$T\f$ by similarity it
+ * creates a bulge in the position \f$(lo+2, lo)\f$, which each following rotation moves one position down the diagonal
+ * until it falls off the active window (@cite GolubVanLoan, Algorithm 8.3.2).
+ */
+template <typename T>
+void SymmetricQRMethod<T>::WilkinsonStep(Eigen::Vector<double, -1> &d, Eigen::Vector<double, -1> &e, const int &lo,
+                                         const int &hi) {
+    // Wilkinson shift
+    double delta = (d(hi - 1) - d(hi)) / 2;
+    double b = e(hi - 1);
+    double mu = d(hi) - b * b / (delta + std::copysign(std::hypot(delta, b), delta));
+
+    // Chasing the bulge: x and z are the entries to which the rotation is applied
+    double x = d(lo) - mu;
+    double z = e(lo);
+    for (int k = lo; k < hi; k++) {
+        double r = std::hypot(x, z);
+        double c = (r == 0) ? 1 : x / r;
+        double s = (r == 0) ? 0 : -z / r;
+        if (k > lo) {
+            e(k - 1) = r;
+        }
+        // Similarity with the rotation on the rows and columns k and k+1
+        double a = d(k), t = e(k), f = d(k + 1);
+        d(k) = c * c * a - 2 * c * s * t + s * s * f;
+        d(k + 1) = s * s * a + 2 * c * s * t + c * c * f;
+        e(k) = c * s * (a - f) + (c * c - s * s) * t;
+        if (k < hi - 1) {
+            z = -s * e(k + 1);
+            e(k + 1) *= c;
+            x = e(k);
+        }
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class SymmetricQRMethod<double>;
+template class SymmetricQRMethod<std::complex<double>>;
@@ -0,0 +1,98 @@
+#ifndef SYMMETRICQRMETHOD_H_
+#define SYMMETRICQRMETHOD_H_
+
+#include "AbstractEigs.h"
+#include "TridiagonalReduction.h"
+
+/** @class SymmetricQRMethod
+ * @brief Class for computing the eigenvalues of symmetric or Hermitian matrices using the symmetric QR Method.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The eigenvalues of a symmetric or Hermitian matrix are real, and the QR method can exploit the symmetry
+ * @cite GolubVanLoan :
+ *  1. The matrix is reduced once to real symmetric tridiagonal form \f$T = Q^* A Q\f$ with the TridiagonalReduction,
+ *  and the form is preserved by the QR iterations.
+ *  2. At each iteration an implicit QR step with Wilkinson shift is executed on \f$T\f$: the shift is the eigenvalue of
+ *  the trailing \f$2\times2\f$ block of \f$T\f$ closest to its last diagonal entry, and the step is carried out by a
+ *  Givens rotation in the top-left corner that creates a bulge, chased down the diagonal with further Givens rotations.
+ *  Each step costs \f$O(n)\f$ operations on the diagonal and the subdiagonal of \f$T\f$ and the convergence is globally
+ *  guaranteed and locally cubic.
+ *  3. The subdiagonal entries \f$t_{k,k-1}\f$ such that \f$|t_{k,k-1}| \leq \epsilon (|t_{k-1,k-1}| + |t_{k,k}|)\f$,
+ *  where \f$\epsilon\f$ is a prescribed tolerance, are set to zero, and the steps are executed only on the trailing
+ *  unreduced block as in QRMethod. The method stops when every block has deflated.
+ *
+ * The overall cost is dominated by the \f$O(n^3)\f$ reduction, while the iterations cost \f$O(n^2)\f$ operations, against
+ * the \f$O(n^3)\f$ operations of the iterations of QRMethod on a general matrix.
+ *
+ * If the given matrix is not symmetric (or Hermitian) up to a relative error \f$10^{-12}\f$, the constructors throw an
+ * exception of type InitializationError with message <tt>Attempting to set a non self-adjoint matrix</tt>.
+ *
+ * The maximum number of iterations bounds the total number of QR steps. If it is reached the method is said to be
+ * non-convergent for the specific instance. The eigenvalues are returned in descending order of absolute value.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    double tol = 1e-10;
+    int maxit = 1000;
+    Eigen::Matrix<double, -1, -1> A(4,4);
+    A <<    4, 1, 2, 0,
+            1, 3, 0, 1,
+            2, 0, 1, 1,
+            0, 1, 1, 2;
+    SymmetricQRMethod<double> eigs_solver(A, tol, maxit);
+    std::cout << "The eigenvalues of A are:\n" << eigs_solver.ComputeEigs();
+ *  @endcode
+ */
+template <typename T> class SymmetricQRMethod : public AbstractEigs<T>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     */
+    SymmetricQRMethod(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {this->CheckSelfAdjoint();};
+
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+     */
+    SymmetricQRMethod(const Eigen::Matrix<T, -1, -1> &A, const double &tol, const int &maxit)
+    : AbstractEigs<T>(A, tol, maxit) {this->CheckSelfAdjoint();};
+
+    /**
+     * @copydoc  AbstractEigs::AbstractEigs(std::map<std::string, std::any> &map)
+     */
+    SymmetricQRMethod(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+        this->CheckDense();
+        this->CheckSelfAdjoint();
+    };
+
+    // Destructor
+    virtual ~SymmetricQRMethod() override {};
+
+    /**
+     * @brief Returns the eigenvalues computed using the symmetric QR method.
+     * @return Vector of complex numbers, with zero imaginary part, containing the eigenvalues of the matrix.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Returns true if the subdiagonal entry \f$t_{k,k-1}\f$ of the tridiagonal matrix is negligible.
+     * @param d Diagonal of the tridiagonal matrix.
+     * @param e Subdiagonal of the tridiagonal matrix.
+     * @param k Row index of the subdiagonal entry, with \f$k \geq 1\f$.
+     * @param norm Norm of the tridiagonal matrix, used if both the diagonal entries are zero.
+     */
+    bool Negligible(const Eigen::Vector<double, -1> &d, const Eigen::Vector<double, -1> &e, const int &k,
+                    const double &norm);
+
+    /**
+     * @brief Executes one implicit QR step with Wilkinson shift on the active window of a tridiagonal matrix.
+     * @param d Diagonal of the tridiagonal matrix, overwritten with the result of the step.
+     * @param e Subdiagonal of the tridiagonal matrix, overwritten with the result of the step.
+     * @param lo Index of the first row and column of the active window.
+     * @param hi Index of the last row and column of the active window.
+     */
+    static void WilkinsonStep(Eigen::Vector<double, -1> &d, Eigen::Vector<double, -1> &e, const int &lo,
+                              const int &hi);
+};
+
+#endif //SYMMETRICQRMETHOD_H_
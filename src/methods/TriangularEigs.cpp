@@ -0,0 +1,35 @@
+#include "TriangularEigs.h"
+#include <algorithm>
+
+template <typename T>
+Eigen::Vector<std::complex<double>, -1> TriangularEigs<T>::ComputeEigs() {
+    Eigen::Vector<std::complex<double>, -1> eigs = (this->_A).diagonal().template cast<std::complex<double>>();
+    this->_it = 0;
+
+    // Returning the eigenvalues in descending order of absolute value
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (std::abs(i) != std::abs(j)) {
+            return std::abs(i) > std::abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(eigs.data(), eigs.data() + eigs.size(), abs_complex);
+    return eigs;
+}
+
+/**
+ * @details The entries outside the triangular part have to be exactly zero, since the diagonal entries are otherwise
+ * only approximations of the eigenvalues.
+ */
+template <typename T>
+void TriangularEigs<T>::CheckTriangular() {
+    bool upper = (this->_A).template triangularView<Eigen::StrictlyLower>().toDenseMatrix().isZero(0);
+    bool lower = (this->_A).template triangularView<Eigen::StrictlyUpper>().toDenseMatrix().isZero(0);
+    if (!upper && !lower) {
+        throw(InitializationError("Attempting to set a non triangular matrix"));
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class TriangularEigs<double>;
+template class TriangularEigs<std::complex<double>>;
@@ -0,0 +1,51 @@
+#ifndef TRIANGULAREIGS_H_
+#define TRIANGULAREIGS_H_
+
+#include "AbstractEigs.h"
+
+/** @class TriangularEigs
+ * @brief Class for computing the eigenvalues of triangular (or diagonal) matrices.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details The characteristic polynomial of an upper or lower triangular matrix \f$A\f$ is
+ * \f$\det(A - \lambda I) = \prod_i (a_{ii} - \lambda)\f$, therefore its eigenvalues are exactly its diagonal entries and
+ * no iteration is needed @cite GolubVanLoan . The cost of the method is \f$O(n \log n)\f$, for sorting the eigenvalues,
+ * which are returned in descending order of absolute value as in QRMethod.
+ *
+ * If the given matrix is neither upper nor lower triangular, the constructors throw an exception of type
+ * InitializationError with message <tt>Attempting to set a non triangular matrix</tt>.
+ *
+ * The tolerance and the maximum number of iterations are not used.
+ */
+template <typename T> class TriangularEigs : public AbstractEigs<T>{
+public:
+    /**
+     * @copydoc AbstractEigs::AbstractEigs(const Eigen::Matrix<T, -1, -1> &A)
+     */
+    TriangularEigs(const Eigen::Matrix<T, -1, -1> &A) : AbstractEigs<T>(A) {CheckTriangular();};
+
+    /**
+     * @copydoc  AbstractEigs::AbstractEigs(std::map<std::string, std::any> &map)
+     */
+    TriangularEigs(std::map<std::string, std::any> &map) : AbstractEigs<T>(map) {
+        this->CheckDense();
+        CheckTriangular();
+    };
+
+    // Destructor
+    virtual ~TriangularEigs() override {};
+
+    /**
+     * @brief Returns the eigenvalues of the triangular matrix, i.e. its diagonal entries.
+     * @return Vector of complex numbers containing the eigenvalues of the matrix.
+     */
+    virtual Eigen::Vector<std::complex<double>, -1> ComputeEigs() override;
+
+private:
+
+    /**
+     * @brief Checks that the matrix is upper or lower triangular.
+     */
+    void CheckTriangular();
+};
+
+#endif //TRIANGULAREIGS_H_
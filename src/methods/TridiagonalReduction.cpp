@@ -0,0 +1,51 @@
+#include "TridiagonalReduction.h"
+#include <algorithm>
+
+/**
+ * @details If the given matrix is non square, it throws an exception of type InitializationError with message:
+ * <tt>Attempting to reduce a non square matrix</tt>.
+ *
+ * At step \f$k\f$ the reflector \f$H = I - \tau v v^*\f$ such that \f$H^* a = \beta e_1\f$, with \f$\beta\f$ real, is
+ * computed for the part \f$a\f$ of the column \f$k\f$ below the diagonal. The trailing part \f$A_{22}\f$ is then
+ * overwritten with \f$H^* A_{22} H = A_{22} - v w^* - w v^*\f$, where \f$p = \tau A_{22} v\f$ and
+ * \f$w = p - \frac{1}{2}\bar{\tau}(v^*p)\,v\f$.
+ */
+template <typename T>
+void TridiagonalReduction<T>::Compute(const Eigen::Matrix<T, -1, -1> &A) {
+    if (A.rows() != A.cols()) {
+        throw(InitializationError("Attempting to reduce a non square matrix"));
+    }
+    int n = A.rows();
+    Eigen::Matrix<T, -1, -1> M = A;
+    _diag.resize(n);
+    _subdiag.resize(std::max(n - 1, 0));
+
+    Eigen::Vector<T, -1> v, p;
+    for (int k = 0; k < n - 1; k++) {
+        int m = n - k - 1; // Size of the trailing part
+        Eigen::Vector<T, -1> essential(m - 1);
+        T h;
+        double beta;
+        M.col(k).tail(m).makeHouseholder(essential, h, beta);
+        _subdiag(k) = beta;
+        if (h == T(0)) {
+            continue;
+        }
+        v.resize(m);
+        v(0) = 1;
+        v.tail(m - 1) = essential;
+        auto A22 = M.bottomRightCorner(m, m);
+        T tau = Eigen::numext::conj(h);
+        p.noalias() = tau * (A22.template selfadjointView<Eigen::Lower>() * v);
+        double alpha = 0.5 * std::real(h * v.dot(p));
+        p -= alpha * v;
+        A22.template selfadjointView<Eigen::Lower>().rankUpdate(v, p, T(-1));
+    }
+    for (int k = 0; k < n; k++) {
+        _diag(k) = std::real(M(k, k));
+    }
+}
+
+// Explicit instantiation for double and std::complex<double>
+template class TridiagonalReduction<double>;
+template class TridiagonalReduction<std::complex<double>>;
@@ -0,0 +1,82 @@
+#ifndef TRIDIAGONALREDUCTION_H_
+#define TRIDIAGONALREDUCTION_H_
+
+#include <Eigen/Dense>
+#include <complex>
+#include "Exceptions.h"
+
+/** @class TridiagonalReduction
+ * @brief Class for reducing a symmetric or Hermitian matrix to real symmetric tridiagonal form by a unitary similarity
+ * transformation.
+ * @tparam T Can be <tt>double</tt> or <tt>std::complex<double></tt>.
+ * @details Every Hermitian matrix \f$A\f$ of size \f$n\f$ can be reduced to tridiagonal form \f$T = Q^* A Q\f$, where
+ * \f$Q\f$ is unitary @cite GolubVanLoan . This is the Hessenberg form of \f$A\f$ (see HessenbergReduction), which is
+ * tridiagonal since the similarity preserves the symmetry. Since \f$T\f$ and \f$A\f$ are similar they have the same
+ * eigenvalues, and the matrix \f$T\f$ is described by only \f$2n-1\f$ real numbers, so that a QR iteration costs
+ * \f$O(n)\f$ operations.
+ *
+ * The matrix \f$Q\f$ is the product of \f$n-1\f$ Householder reflectors, chosen as in Eigen so that the subdiagonal
+ * entries are real also for complex Hermitian matrices. Each reflector is applied to the trailing part of the matrix
+ * with a Hermitian matrix-vector product and a rank-2 update, as in the LAPACK routine <tt>dsytd2</tt>, and only the
+ * lower triangular part of the matrix is referenced. The reduction costs \f$\frac{4}{3}n^3\f$ operations, therefore it
+ * is meant to be computed once, for instance by SymmetricQRMethod.
+ *
+ *  Usage:
+ *  @code{.cpp}
+    Eigen::Matrix<double, -1, -1> A(3,3);
+    A <<    4, 1, 2,
+            1, 3, 0,
+            2, 0, 1;
+    TridiagonalReduction<double> tridiagonal(A);
+    std::cout << "Diagonal: " << tridiagonal.GetDiagonal().transpose() << std::endl;
+    std::cout << "Subdiagonal: " << tridiagonal.GetSubdiagonal().transpose() << std::endl;
+ *  @endcode
+ */
+template <typename T> class TridiagonalReduction {
+public:
+    /**
+     * @brief Default constructor; the reduction has to be computed calling TridiagonalReduction::Compute.
+     */
+    TridiagonalReduction() {};
+
+    /**
+     * @brief Constructor; computes the tridiagonal reduction of the given matrix.
+     * @param A Symmetric or Hermitian matrix to be reduced. Only its lower triangular part is referenced.
+     */
+    TridiagonalReduction(const Eigen::Matrix<T, -1, -1> &A) {Compute(A);};
+
+    /**
+     * @brief Computes the tridiagonal reduction of the given matrix.
+     * @param A Symmetric or Hermitian matrix to be reduced. Only its lower triangular part is referenced.
+     */
+    void Compute(const Eigen::Matrix<T, -1, -1> &A);
+
+    /**
+     * @brief Returns the size of the reduced matrix.
+     */
+    int GetSize() const {return _diag.size();};
+
+    /**
+     * @brief Returns the diagonal of the tridiagonal matrix \f$T\f$.
+     */
+    const Eigen::Vector<double, -1> &GetDiagonal() const {return _diag;};
+
+    /**
+     * @brief Returns the subdiagonal of the tridiagonal matrix \f$T\f$.
+     */
+    const Eigen::Vector<double, -1> &GetSubdiagonal() const {return _subdiag;};
+
+private:
+
+    /**
+     * @brief Diagonal of the tridiagonal matrix.
+     */
+    Eigen::Vector<double, -1> _diag;
+
+    /**
+     * @brief Subdiagonal of the tridiagonal matrix.
+     */
+    Eigen::Vector<double, -1> _subdiag;
+};
+
+#endif //TRIDIAGONALREDUCTION_H_
@@ -6,11 +6,29 @@
 #include "Eigen/Eigenvalues"
 #include "Eigen/Dense"
 
+#include "ArnoldiMethod.h"
+#include "Balancing.h"
+#include "BisectionMethod.h"
+#include "ChebyshevFilter.h"
+#include "CpuDispatch.h"
+#include "EigsPlanner.h"
+#include "FactorizationCache.h"
+#include "HessenbergReduction.h"
 #include "InvPowerMethod.h"
+#include "IterationKernels.h"
+#include "LanczosMethod.h"
+#include "LinearOperator.h"
+#include "LOBPCGMethod.h"
+#include "PlanarLU.h"
+#include "PlanarMatrix.h"
 #include "PowerMethod.h"
 #include "QRMethod.h"
 #include "ShiftPowerMethod.h"
 #include "ShiftInvPowerMethod.h"
+#include "SparseFactorization.h"
+#include "SubspaceIteration.h"
+#include "SymmetricQRMethod.h"
+#include "TriangularEigs.h"
 
 #include "Exceptions.h"
 
@@ -112,8 +130,9 @@ void MethodsTest<std::complex<double>>::Initialization() {
     map["shift"] = shift;
 }
 
-// Class for testing methods defined only for double matrices (QRMethod)
+// Classes for testing methods separately for double and std::complex<double> matrices (QRMethod)
 typedef MethodsTest<double> MethodsTest_double;
+typedef MethodsTest<std::complex<double>> MethodsTest_complex;
 
 // Typed test suite
 typedef testing::Types<double, std::complex<double>> eigsTypes ;
@@ -217,6 +236,1077 @@ TYPED_TEST(MethodsTest, ShiftInvPowerMethod) {
     EXPECT_NEAR(this->exact_eigs[2].imag(), this->computed_eigs[0].imag(), 1e-8);
 }
 
+TYPED_TEST(MethodsTest, ShiftMethodsHessenbergReduction) {
+    // The same reduction is shared by the power method with shift and the inverse power method with shift
+    auto hessenberg = std::make_shared<const HessenbergReduction<TypeParam>>(this->A);
+    auto p_shiftPowerMethod = std::make_unique<ShiftPowerMethod<TypeParam>>(this->A, this->tol, this->maxit, this->x0, this->shift);
+    p_shiftPowerMethod->SetHessenbergReduction(hessenberg);
+    this->computed_eigs = p_shiftPowerMethod->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real() ,1e-8);
+    EXPECT_NEAR(this->exact_eigs[0].imag(), this->computed_eigs[0].imag() ,1e-8);
+
+    auto p_shiftInvPowerMethod = std::make_unique<ShiftInvPowerMethod<TypeParam>>(this->A, this->tol, this->maxit, this->x0, this->shift);
+    p_shiftInvPowerMethod->SetHessenbergReduction(hessenberg);
+    this->computed_eigs = p_shiftInvPowerMethod->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[2].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    auto wrong_size = std::make_shared<const HessenbergReduction<TypeParam>>(Eigen::Matrix<TypeParam, -1, -1>::Ones(3, 3));
+    ASSERT_THROW_MSG(p_shiftInvPowerMethod->SetHessenbergReduction(wrong_size), InitializationError, "Attempting to set Hessenberg reduction with incorrect size");
+}
+
+TYPED_TEST(MethodsTest, HessenbergReduction) {
+    // Random matrix large enough to span several panels of the blocked reduction
+    int N = 100;
+    std::srand(3);
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N);
+    HessenbergReduction<TypeParam> hessenberg(B);
+    Eigen::Matrix<TypeParam, -1, -1> H = hessenberg.GetMatrixH();
+    Eigen::Matrix<TypeParam, -1, -1> Q = hessenberg.GetMatrixQ();
+    EXPECT_NEAR(0, (Q * H * Q.adjoint() - B).norm() / B.norm(), 1e-13);
+    EXPECT_NEAR(0, (Q.adjoint() * Q - Eigen::Matrix<TypeParam, -1, -1>::Identity(N, N)).norm(), 1e-13);
+    for (int j = 0; j < N; j++) {
+        for (int i = j + 2; i < N; i++) {
+            ASSERT_TRUE(H(i, j) == TypeParam(0));
+        }
+    }
+    Eigen::Matrix<TypeParam, -1, -1> X = B;
+    hessenberg.ApplyQAdjoint(X);
+    EXPECT_NEAR(0, (X - Q.adjoint() * B).norm() / B.norm(), 1e-13);
+
+    ASSERT_THROW_MSG(hessenberg.Compute(Eigen::Matrix<TypeParam, -1, -1>::Ones(3, 4)), InitializationError, "Attempting to reduce a non square matrix");
+}
+
+TYPED_TEST(MethodsTest, Balancing) {
+    // Badly scaled matrix with an isolated eigenvalue in the last row
+    int N = 20;
+    std::srand(4);
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N);
+    for (int i = 0; i < N; i++) {
+        B.row(i) *= std::pow(10.0, i % 7 - 3);
+        B.col(i) /= std::pow(10.0, i % 7 - 3);
+    }
+    B.row(N - 1).head(N - 1).setZero();
+    Balancing<TypeParam> balancing(B);
+    ASSERT_EQ(balancing.GetHigh(), N - 2);
+    Eigen::Matrix<TypeParam, -1, -1> X = Eigen::Matrix<TypeParam, -1, -1>::Identity(N, N);
+    balancing.BackTransform(X);
+    EXPECT_NEAR(0, (X.inverse() * B * X - balancing.GetMatrix()).norm() / B.norm(), 1e-13);
+    EXPECT_LT(balancing.GetMatrix().norm(), 1e-3 * B.norm());
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ(std::log2(balancing.GetScaling()(i)), std::round(std::log2(balancing.GetScaling()(i))));
+    }
+    balancing.Apply(X);
+    EXPECT_TRUE(X.isApprox(Eigen::Matrix<TypeParam, -1, -1>::Identity(N, N)));
+
+    ASSERT_THROW_MSG(balancing.Compute(Eigen::Matrix<TypeParam, -1, -1>::Ones(3, 4)), InitializationError, "Attempting to balance a non square matrix");
+}
+
+TYPED_TEST(MethodsTest, PowerMethodsBalancing) {
+    this->map["balance"] = 1.0;
+    this->p_eigsSolver = std::make_unique<ShiftInvPowerMethod<TypeParam>>(this->map);
+    ASSERT_TRUE(this->p_eigsSolver->GetBalance());
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[2].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // The eigenvector is mapped back to the basis of the matrix
+    auto p_powerMethod = std::make_unique<PowerMethod<TypeParam>>(this->map);
+    this->computed_eigs = p_powerMethod->ComputeEigs();
+    Eigen::Vector<TypeParam, -1> v = p_powerMethod->GetEigenvector();
+    TypeParam lambda = v.dot(this->A * v);
+    EXPECT_NEAR(0, (this->A * v - lambda * v).norm(), 1e-6);
+}
+
+TYPED_TEST(MethodsTest, SparsePowerMethods) {
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> A_sparse = this->A.sparseView();
+    this->p_eigsSolver = std::make_unique<PowerMethod<TypeParam>>(A_sparse, this->tol, this->maxit, this->x0);
+    ASSERT_TRUE(this->p_eigsSolver->IsSparse());
+    ASSERT_EQ(this->n, this->p_eigsSolver->GetSize());
+    ASSERT_EQ(0, this->p_eigsSolver->GetMatrix().size());
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[0].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // Sparse matrix from the map
+    this->map["matrix"] = A_sparse;
+    this->p_eigsSolver = std::make_unique<ShiftPowerMethod<TypeParam>>(this->map);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[0].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // Large sparse tridiagonal matrix with a_00 = 10, a_ii = 2 for i > 0 and -1 on the off diagonals. The eigenvector
+    // of its largest eigenvalue has entries (-1/8)^i, therefore the eigenvalue is 10 - (-1/8) = 10.125.
+    int N = 100000;
+    std::vector<Eigen::Triplet<TypeParam>> triplets;
+    for (int i = 0; i < N; i++) {
+        triplets.emplace_back(i, i, (i == 0) ? 10 : 2);
+        if (i > 0) {
+            triplets.emplace_back(i, i - 1, -1);
+            triplets.emplace_back(i - 1, i, -1);
+        }
+    }
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> L(N, N);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+    ShiftPowerMethod<TypeParam> shiftPowerMethod(L, this->tol, this->maxit, Eigen::Vector<TypeParam, -1>::Ones(N),
+                                                 TypeParam(1));
+    this->computed_eigs = shiftPowerMethod.ComputeEigs();
+    EXPECT_NEAR(10.125, this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(0, this->computed_eigs[0].imag(), 1e-8);
+    Eigen::Vector<TypeParam, -1> v = shiftPowerMethod.GetEigenvector();
+    EXPECT_NEAR(0, (L * v - TypeParam(10.125) * v).norm(), 1e-4);
+
+    // Methods not supporting sparse matrices
+    ASSERT_THROW_MSG(this->p_eigsSolver->SetBalance(true), InitializationError, "Attempting to balance a sparse matrix");
+    ASSERT_THROW_MSG(QRMethod<TypeParam> qrMethod(this->map), InitializationError, "Sparse matrices are not supported by this method");
+}
+
+TYPED_TEST(MethodsTest, Factorizations) {
+    // Every strategy gives the same eigenvalue
+    for (std::string factorization : {"auto", "partialpivlu", "fullpivlu", "qr"}) {
+        this->map["factorization"] = factorization;
+        auto p_shiftInvPowerMethod = std::make_unique<ShiftInvPowerMethod<TypeParam>>(this->map);
+        ASSERT_EQ(factorization, p_shiftInvPowerMethod->GetFactorization());
+        this->computed_eigs = p_shiftInvPowerMethod->ComputeEigs();
+        EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[2].imag(), this->computed_eigs[0].imag(), 1e-8);
+        if (factorization == "auto") {
+            ASSERT_EQ("partialpivlu", p_shiftInvPowerMethod->GetComputedFactorization());
+        }
+    }
+
+    // Shift very close to an eigenvalue
+    ShiftInvPowerMethod<TypeParam> shiftInvPowerMethod(this->A, this->tol, this->maxit, this->x0,
+                                                       TypeParam(this->exact_eigs[2].real() + 1e-13));
+    shiftInvPowerMethod.SetFactorization("qr");
+    this->computed_eigs = shiftInvPowerMethod.ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[2].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // Symmetric or Hermitian positive definite matrix: the Cholesky factorization is chosen
+    Eigen::Matrix<TypeParam, -1, -1> S = this->A.adjoint() * this->A;
+    double smallest = Eigen::SelfAdjointEigenSolver<Eigen::Matrix<TypeParam, -1, -1>>(S).eigenvalues()[0];
+    InvPowerMethod<TypeParam> invPowerMethod(S, this->tol, this->maxit, this->x0);
+    this->computed_eigs = invPowerMethod.ComputeEigs();
+    ASSERT_EQ("llt", invPowerMethod.GetComputedFactorization());
+    EXPECT_NEAR(1, this->computed_eigs[0].real() / smallest, 1e-8);
+    invPowerMethod.SetFactorization("ldlt");
+    this->computed_eigs = invPowerMethod.ComputeEigs();
+    EXPECT_NEAR(1, this->computed_eigs[0].real() / smallest, 1e-8);
+
+    // Errors
+    ASSERT_THROW_MSG(invPowerMethod.SetFactorization("cholesky"), InitializationError, "Unknown factorization");
+    shiftInvPowerMethod.SetFactorization("llt");
+    ASSERT_THROW_MSG(shiftInvPowerMethod.ComputeEigs(), ConvergenceError, "Unable to factorize the shifted matrix");
+    this->map["factorization"] = 1.0;
+    ASSERT_THROW_MSG(InvPowerMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the factorization to string");
+}
+
+TYPED_TEST(MethodsTest, FactorizationCache) {
+    // Changing the initial vector, the tolerance or the maximum number of iterations does not factorize again
+    auto cache = std::make_shared<FactorizationCache<TypeParam>>(2);
+    ShiftInvPowerMethod<TypeParam> shiftInvPowerMethod(this->A, this->tol, this->maxit, this->x0, this->shift);
+    shiftInvPowerMethod.SetFactorizationCache(cache);
+    this->computed_eigs = shiftInvPowerMethod.ComputeEigs();
+    shiftInvPowerMethod.SetInitVec(Eigen::Vector<TypeParam, -1>::Ones(this->n));
+    shiftInvPowerMethod.SetTol(1e-12);
+    shiftInvPowerMethod.SetMaxit(2 * this->maxit);
+    this->computed_eigs = shiftInvPowerMethod.ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_EQ(1, cache->GetMisses());
+    EXPECT_EQ(1, cache->GetHits());
+
+    // The cache is shared with other solvers
+    ShiftInvPowerMethod<TypeParam> otherShiftInvPowerMethod(this->A, this->tol, this->maxit, this->x0, this->shift);
+    otherShiftInvPowerMethod.SetFactorizationCache(cache);
+    this->computed_eigs = otherShiftInvPowerMethod.ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_EQ(1, cache->GetMisses());
+    EXPECT_EQ(2, cache->GetHits());
+
+    // A new shift or a new strategy is factorized, and the least recently used factorization is discarded
+    shiftInvPowerMethod.SetShift(TypeParam(this->exact_eigs[0].real() + 0.1));
+    this->computed_eigs = shiftInvPowerMethod.ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    shiftInvPowerMethod.SetFactorization("qr");
+    this->computed_eigs = shiftInvPowerMethod.ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_EQ(3, cache->GetMisses());
+    EXPECT_EQ(2, cache->GetSize());
+    otherShiftInvPowerMethod.ComputeEigs();
+    EXPECT_EQ(4, cache->GetMisses());
+
+    // A different matrix has a different fingerprint
+    Eigen::Matrix<TypeParam, -1, -1> B = this->A;
+    EXPECT_EQ(FactorizationCache<TypeParam>::Fingerprint(this->A), FactorizationCache<TypeParam>::Fingerprint(B));
+    B(0, 0) += 1e-15;
+    EXPECT_NE(FactorizationCache<TypeParam>::Fingerprint(this->A), FactorizationCache<TypeParam>::Fingerprint(B));
+    InvPowerMethod<TypeParam> invPowerMethod(this->A, this->tol, this->maxit, this->x0);
+    invPowerMethod.SetFactorizationCache(cache);
+    invPowerMethod.ComputeEigs();
+    invPowerMethod.SetBalance(true);
+    this->computed_eigs = invPowerMethod.ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[this->n-1].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_EQ(6, cache->GetMisses());
+
+    // Errors
+    ASSERT_THROW_MSG(FactorizationCache<TypeParam> wrong_capacity(0), InitializationError, "Attempting to set capacity <= 0");
+    ASSERT_THROW_MSG(invPowerMethod.SetFactorizationCache(nullptr), InitializationError, "Attempting to set a null factorization cache");
+}
+
+TYPED_TEST(MethodsTest, SparseInvPowerMethods) {
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> A_sparse = this->A.sparseView();
+    this->p_eigsSolver = std::make_unique<InvPowerMethod<TypeParam>>(A_sparse, this->tol, this->maxit, this->x0);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[this->n-1].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[this->n-1].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    this->map["matrix"] = A_sparse;
+    auto p_shiftInvPowerMethod = std::make_unique<ShiftInvPowerMethod<TypeParam>>(this->map);
+    this->computed_eigs = p_shiftInvPowerMethod->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[2].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[2].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // Sweep over the shifts: each exact eigenvalue is found from a shift close to it
+    for (int i = 0; i < this->n; i++) {
+        p_shiftInvPowerMethod->SetShift(TypeParam(this->exact_eigs[i].real() + 0.1));
+        this->computed_eigs = p_shiftInvPowerMethod->ComputeEigs();
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[0].real(), 1e-8);
+    }
+
+    // The symbolic analysis is executed once, the numeric factorization once per shift
+    int N = 1000;
+    std::vector<Eigen::Triplet<TypeParam>> triplets;
+    for (int i = 0; i < N; i++) {
+        triplets.emplace_back(i, i, (i == 0) ? 10 : 2);
+        if (i > 0) {
+            triplets.emplace_back(i, i - 1, -1);
+            triplets.emplace_back(i - 1, i, -1);
+        }
+    }
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> L(N, N);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+    SparseFactorization<TypeParam> factorization(L);
+    ASSERT_TRUE(factorization.IsSelfAdjoint());
+    Eigen::Vector<TypeParam, -1> b = Eigen::Vector<TypeParam, -1>::Random(N);
+    for (double shift : {-1.0, 0.5, 1.5}) {
+        factorization.Factorize(TypeParam(shift));
+        ASSERT_TRUE(factorization.UsesLDLT());
+        Eigen::Vector<TypeParam, -1> x = factorization.Solve(b);
+        EXPECT_NEAR(0, (L * x - TypeParam(shift) * x - b).norm(), 1e-8 * b.norm());
+    }
+    EXPECT_EQ(1, factorization.GetSymbolicCount());
+    EXPECT_EQ(3, factorization.GetNumericCount());
+    // The same shift is not factorized again
+    factorization.Factorize(TypeParam(1.5));
+    EXPECT_EQ(3, factorization.GetNumericCount());
+
+    // The first pivot of L - 10 I is zero: the LU factorization is used instead of the LDLT factorization
+    factorization.Factorize(TypeParam(10));
+    ASSERT_FALSE(factorization.UsesLDLT());
+    Eigen::Vector<TypeParam, -1> x = factorization.Solve(b);
+    EXPECT_NEAR(0, (L * x - TypeParam(10) * x - b).norm(), 1e-8 * b.norm());
+
+    ShiftInvPowerMethod<TypeParam> shiftInvPowerMethod(L, this->tol, this->maxit, Eigen::Vector<TypeParam, -1>::Ones(N),
+                                                       TypeParam(10));
+    this->computed_eigs = shiftInvPowerMethod.ComputeEigs();
+    EXPECT_NEAR(10.125, this->computed_eigs[0].real(), 1e-8);
+
+    // Exactly singular shifted matrix
+    factorization.Analyze(Eigen::SparseMatrix<TypeParam, Eigen::RowMajor>(N, N));
+    ASSERT_THROW_MSG(factorization.Factorize(TypeParam(0)), ConvergenceError, "Unable to factorize the shifted matrix");
+}
+
+TYPED_TEST(MethodsTest, IterationKernels) {
+    // The fused kernel gives the same results of the separate operations
+    int N = 1001;
+    Eigen::Vector<TypeParam, -1> x = Eigen::Vector<TypeParam, -1>::Random(N);
+    Eigen::Vector<TypeParam, -1> y = Eigen::Vector<TypeParam, -1>::Random(N);
+    Eigen::Vector<TypeParam, -1> y_scaled = 0.25 * y;
+    double norm2;
+    TypeParam dot = IterationKernels<TypeParam>::ScaleNormDot(x.data(), y.data(), N, 0.25, norm2);
+    EXPECT_NEAR(0, (y - y_scaled).norm(), 1e-14);
+    EXPECT_NEAR(y_scaled.squaredNorm(), norm2, 1e-12 * norm2);
+    EXPECT_NEAR(0, std::abs(x.dot(y_scaled) - dot), 1e-12 * x.norm() * y.norm());
+
+    // Every path supported by the processor gives the same results
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N - 2);
+    Eigen::Vector<TypeParam, -1> z(N);
+    std::string best = CpuDispatch::GetPathName();
+    for (const std::string &path : CpuDispatch::GetSupportedPaths()) {
+        CpuDispatch::SetPath(path);
+        ASSERT_EQ(path, CpuDispatch::GetPathName());
+        IterationKernels<TypeParam>::Gemv(B.data(), x.data(), z.data(), N, N - 2);
+        EXPECT_NEAR(0, (z - B * x.head(N - 2)).norm(), 1e-12 * z.norm());
+        y = y_scaled;
+        dot = IterationKernels<TypeParam>::ScaleNormDot(x.data(), y.data(), N, 4, norm2);
+        EXPECT_NEAR(0, std::abs(x.dot(4.0 * y_scaled) - dot), 1e-12 * x.norm() * y.norm());
+        this->p_eigsSolver = std::make_unique<PowerMethod<TypeParam>>(this->A, this->tol, this->maxit, this->x0);
+        this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+        EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[0].imag(), this->computed_eigs[0].imag(), 1e-8);
+    }
+    CpuDispatch::SetPath(best);
+    ASSERT_THROW_MSG(CpuDispatch::SetPath("neon"), InitializationError, "Unsupported kernel path");
+}
+
+TYPED_TEST(MethodsTest, PlanarLayout) {
+    // Every power method gives the same eigenvalues with the planar layout
+    this->map["planar"] = 1.0;
+    std::vector<std::unique_ptr<AbstractPowerMethod<TypeParam>>> solvers;
+    solvers.push_back(std::make_unique<PowerMethod<TypeParam>>(this->map));
+    solvers.push_back(std::make_unique<ShiftPowerMethod<TypeParam>>(this->map));
+    solvers.push_back(std::make_unique<InvPowerMethod<TypeParam>>(this->map));
+    solvers.push_back(std::make_unique<ShiftInvPowerMethod<TypeParam>>(this->map));
+    std::vector<int> expected = {0, 0, this->n - 1, 2};
+    for (int k = 0; k < 4; k++) {
+        ASSERT_TRUE(solvers[k]->IsPlanar());
+        this->computed_eigs = solvers[k]->ComputeEigs();
+        EXPECT_NEAR(this->exact_eigs[expected[k]].real(), this->computed_eigs[0].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[expected[k]].imag(), this->computed_eigs[0].imag(), 1e-8);
+    }
+
+    // Product and solution of systems in planar layout
+    int N = 203;
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N);
+    Eigen::Vector<TypeParam, -1> x = Eigen::Vector<TypeParam, -1>::Random(N), y;
+    PlanarMatrix<TypeParam> planar_matrix;
+    planar_matrix.Set(B);
+    planar_matrix.Multiply(x, y);
+    EXPECT_NEAR(0, (y - B * x).norm(), 1e-12 * y.norm());
+    PlanarLU<TypeParam> planar_lu;
+    planar_lu.Compute(B);
+    planar_lu.Solve(y, x);
+    EXPECT_NEAR(0, (B * x - y).norm(), 1e-10 * y.norm());
+
+    this->map["planar"] = std::string("yes");
+    ASSERT_THROW_MSG(PowerMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the planar layout to double");
+}
+
+TYPED_TEST(MethodsTest, MatrixFreePowerMethods) {
+    Eigen::Matrix<TypeParam, -1, -1> A = this->A;
+    std::shared_ptr<const LinearOperator<TypeParam>> A_operator = std::make_shared<FunctionOperator<TypeParam>>(this->n,
+        [A](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {y.noalias() = A * x;});
+    this->p_eigsSolver = std::make_unique<PowerMethod<TypeParam>>(A_operator, this->tol, this->maxit, this->x0);
+    ASSERT_TRUE(this->p_eigsSolver->IsMatrixFree());
+    ASSERT_EQ(this->n, this->p_eigsSolver->GetSize());
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[0].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // Linear operator from the map
+    this->map["matrix"] = A_operator;
+    this->p_eigsSolver = std::make_unique<ShiftPowerMethod<TypeParam>>(this->map);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_NEAR(this->exact_eigs[0].imag(), this->computed_eigs[0].imag(), 1e-8);
+
+    // Block application, column by column by default
+    Eigen::Matrix<TypeParam, -1, -1> X = Eigen::Matrix<TypeParam, -1, -1>::Random(this->n, 3), Y;
+    A_operator->ApplyBlock(X, Y);
+    EXPECT_NEAR(0, (Y - A * X).norm(), 1e-12);
+
+    // Large stencil never stored: same matrix of the test SparsePowerMethods, with largest eigenvalue 10.125
+    int N = 1000000;
+    auto stencil = std::make_shared<FunctionOperator<TypeParam>>(N,
+        [N](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {
+            y = 2 * x;
+            y(0) = 10.0 * x(0);
+            y.head(N - 1) -= x.tail(N - 1);
+            y.tail(N - 1) -= x.head(N - 1);
+        });
+    PowerMethod<TypeParam> powerMethod(stencil);
+    this->computed_eigs = powerMethod.ComputeEigs();
+    EXPECT_NEAR(10.125, this->computed_eigs[0].real(), 1e-6);
+    EXPECT_NEAR(0, this->computed_eigs[0].imag(), 1e-6);
+
+    // Methods not supporting linear operators
+    ASSERT_THROW_MSG(this->p_eigsSolver->SetBalance(true), InitializationError, "Attempting to balance a linear operator");
+    ASSERT_THROW_MSG(InvPowerMethod<TypeParam> invPowerMethod(this->map), InitializationError, "Linear operators are not supported by this method");
+    ASSERT_THROW_MSG(this->p_eigsSolver.reset(new PowerMethod<TypeParam>(std::shared_ptr<const LinearOperator<TypeParam>>())), InitializationError, "Attempting to set a null linear operator");
+    ASSERT_THROW_MSG(FunctionOperator<TypeParam> wrong_size(-1, nullptr), InitializationError, "Attempting to set an operator with negative size");
+}
+
+TYPED_TEST(MethodsTest, SubspaceIteration) {
+    // Two largest magnitude eigenvalues of the small matrix, from the map
+    this->map["neigs"] = 2.0;
+    this->map["block"] = 3.0;
+    auto p_subspace = std::make_unique<SubspaceIteration<TypeParam>>(this->map);
+    ASSERT_EQ(3, p_subspace->GetBlockSize());
+    this->computed_eigs = p_subspace->ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), 2);
+    for (int i = 0; i < 2; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+
+    // Matrix similar to a block diagonal matrix with eigenvalues 10 * 0.9^i and a pair 8 +- 3i
+    int N = 200;
+    std::srand(9);
+    Eigen::Matrix<double, -1, -1> D = Eigen::Matrix<double, -1, -1>::Zero(N, N);
+    for (int i = 0; i < N; i++) {
+        D(i, i) = 10 * std::pow(0.9, i);
+    }
+    D(1, 1) = 8; D(1, 2) = 3; D(2, 1) = -3; D(2, 2) = 8;
+    Eigen::Matrix<double, -1, -1> S = Eigen::Matrix<double, -1, -1>::Identity(N, N)
+                                      + 0.1 * Eigen::Matrix<double, -1, -1>::Random(N, N);
+    Eigen::Matrix<TypeParam, -1, -1> B = (S * D * S.inverse()).template cast<TypeParam>();
+    Eigen::Vector<std::complex<double>, -1> exact(4);
+    exact << 10, std::complex<double>(8, 3), std::complex<double>(8, -3), 10 * std::pow(0.9, 3);
+
+    SubspaceIteration<TypeParam> subspace(B, 1e-12, this->maxit);
+    subspace.SetNumEigs(4);
+    ASSERT_EQ(8, subspace.GetBlockSize());
+    this->computed_eigs = subspace.ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), 4);
+    Eigen::Matrix<std::complex<double>, -1, -1> V = subspace.GetEigenvectors();
+    Eigen::Matrix<std::complex<double>, -1, -1> B_complex = B.template cast<std::complex<double>>();
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NEAR(0, (this->computed_eigs.array() - exact[i]).abs().minCoeff(), 1e-8);
+        EXPECT_NEAR(1, V.col(i).norm(), 1e-12);
+        EXPECT_NEAR(0, (B_complex * V.col(i) - this->computed_eigs[i] * V.col(i)).norm(), 1e-8);
+    }
+    // The converged vectors are locked and not multiplied any more
+    EXPECT_LT(subspace.GetProducts(), subspace.GetIterations() * subspace.GetBlockSize());
+
+    // Sparse matrix and linear operator
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> B_sparse = B.sparseView();
+    SubspaceIteration<TypeParam> sparseSubspace(B_sparse, 1e-12, this->maxit);
+    sparseSubspace.SetNumEigs(4);
+    EXPECT_NEAR(0, (sparseSubspace.ComputeEigs() - this->computed_eigs).norm(), 1e-8);
+    std::shared_ptr<const LinearOperator<TypeParam>> B_operator = std::make_shared<FunctionOperator<TypeParam>>(N,
+        [B](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {y.noalias() = B * x;});
+    SubspaceIteration<TypeParam> operatorSubspace(B_operator, 1e-12, this->maxit);
+    operatorSubspace.SetNumEigs(4);
+    EXPECT_NEAR(0, (operatorSubspace.ComputeEigs() - this->computed_eigs).norm(), 1e-8);
+
+    ASSERT_THROW_MSG(subspace.SetNumEigs(0), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(subspace.SetNumEigs(N + 1), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(subspace.SetBlockSize(3), InitializationError, "Attempting to set a block size out of range");
+    ASSERT_THROW_MSG(subspace.SetBlockSize(N + 1), InitializationError, "Attempting to set a block size out of range");
+    subspace.SetMaxit(3);
+    ASSERT_THROW_MSG(subspace.ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    this->map["neigs"] = std::string("two");
+    ASSERT_THROW_MSG(SubspaceIteration<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the number of eigenvalues to double");
+}
+
+TYPED_TEST(MethodsTest, ArnoldiMethod) {
+    // Two largest magnitude eigenvalues of the small matrix, from the map
+    this->map["neigs"] = 2.0;
+    auto p_arnoldi = std::make_unique<ArnoldiMethod<TypeParam>>(this->map);
+    this->computed_eigs = p_arnoldi->ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), 2);
+    for (int i = 0; i < 2; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+
+    // Matrix similar to a block diagonal matrix with eigenvalues 10 * 0.9^i, -9.5 and a pair 8 +- 3i
+    int N = 200;
+    std::srand(10);
+    Eigen::Matrix<double, -1, -1> D = Eigen::Matrix<double, -1, -1>::Zero(N, N);
+    for (int i = 0; i < N; i++) {
+        D(i, i) = 10 * std::pow(0.9, i);
+    }
+    D(1, 1) = 8; D(1, 2) = 3; D(2, 1) = -3; D(2, 2) = 8;
+    D(3, 3) = -9.5;
+    Eigen::Matrix<double, -1, -1> S = Eigen::Matrix<double, -1, -1>::Identity(N, N)
+                                      + 0.1 * Eigen::Matrix<double, -1, -1>::Random(N, N);
+    Eigen::Matrix<TypeParam, -1, -1> B = (S * D * S.inverse()).template cast<TypeParam>();
+    Eigen::Matrix<std::complex<double>, -1, -1> B_complex = B.template cast<std::complex<double>>();
+    auto check = [&B_complex](ArnoldiMethod<TypeParam> &arnoldi, const Eigen::Vector<std::complex<double>, -1> &exact) {
+        Eigen::Vector<std::complex<double>, -1> computed = arnoldi.ComputeEigs();
+        ASSERT_EQ(computed.size(), exact.size());
+        Eigen::Matrix<std::complex<double>, -1, -1> V = arnoldi.GetEigenvectors();
+        for (int i = 0; i < exact.size(); i++) {
+            EXPECT_NEAR(0, (computed.array() - exact[i]).abs().minCoeff(), 1e-8);
+            EXPECT_NEAR(1, V.col(i).norm(), 1e-12);
+            EXPECT_NEAR(0, (B_complex * V.col(i) - computed[i] * V.col(i)).norm(), 1e-8);
+        }
+    };
+
+    // Largest magnitude, largest real part and closest to a shift
+    Eigen::Vector<std::complex<double>, -1> magnitude(4), real(4), shift(3);
+    magnitude << 10, -9.5, std::complex<double>(8, 3), std::complex<double>(8, -3);
+    real << 10, std::complex<double>(8, 3), std::complex<double>(8, -3), 10 * std::pow(0.9, 4);
+    shift << 10 * std::pow(0.9, 28), 10 * std::pow(0.9, 29), 10 * std::pow(0.9, 30);
+    ArnoldiMethod<TypeParam> arnoldi(B, 1e-12, this->maxit);
+    arnoldi.SetNumEigs(4);
+    ASSERT_EQ(20, arnoldi.GetSubspaceSize());
+    check(arnoldi, magnitude);
+    // Each restart multiplies only the vectors that are not kept
+    EXPECT_LT(arnoldi.GetProducts(), arnoldi.GetIterations() * arnoldi.GetSubspaceSize());
+    arnoldi.SetSelection("real");
+    check(arnoldi, real);
+    arnoldi.SetNumEigs(3);
+    arnoldi.SetSelection("shift");
+    arnoldi.SetShift(0.5);
+    check(arnoldi, shift);
+
+    // Sparse matrix and linear operator
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> B_sparse = B.sparseView();
+    ArnoldiMethod<TypeParam> sparseArnoldi(B_sparse, 1e-12, this->maxit);
+    sparseArnoldi.SetNumEigs(4);
+    check(sparseArnoldi, magnitude);
+    sparseArnoldi.SetNumEigs(3);
+    sparseArnoldi.SetSelection("shift");
+    sparseArnoldi.SetShift(0.5);
+    check(sparseArnoldi, shift);
+    std::shared_ptr<const LinearOperator<TypeParam>> B_operator = std::make_shared<FunctionOperator<TypeParam>>(N,
+        [B](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {y.noalias() = B * x;});
+    ArnoldiMethod<TypeParam> operatorArnoldi(B_operator, 1e-12, this->maxit);
+    operatorArnoldi.SetNumEigs(4);
+    operatorArnoldi.SetSubspaceSize(30);
+    check(operatorArnoldi, magnitude);
+    operatorArnoldi.SetSelection("shift");
+    ASSERT_THROW_MSG(operatorArnoldi.ComputeEigs(), InitializationError, "Linear operators are not supported by this method");
+
+    ASSERT_THROW_MSG(arnoldi.SetNumEigs(0), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(arnoldi.SetNumEigs(N + 1), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(arnoldi.SetSubspaceSize(4), InitializationError, "Attempting to set a subspace size out of range");
+    ASSERT_THROW_MSG(arnoldi.SetSubspaceSize(N + 1), InitializationError, "Attempting to set a subspace size out of range");
+    ASSERT_THROW_MSG(arnoldi.SetSelection("smallest"), InitializationError, "Unknown selection rule");
+    arnoldi.SetSelection("magnitude");
+    arnoldi.SetMaxit(1);
+    ASSERT_THROW_MSG(arnoldi.ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    this->map["selection"] = 1.0;
+    ASSERT_THROW_MSG(ArnoldiMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the selection to string");
+}
+
+TYPED_TEST(MethodsTest, LanczosMethod) {
+    // Symmetric or Hermitian matrix with eigenvalues 5, 4.5, 4, -3, -3.5 and the others equispaced in [-1, 1]
+    int N = 300;
+    std::srand(11);
+    Eigen::Vector<double, -1> d = Eigen::Vector<double, -1>::LinSpaced(N, -1, 1);
+    d.head(5) << 5, 4.5, 4, -3, -3.5;
+    Eigen::Matrix<TypeParam, -1, -1> Q = Eigen::HouseholderQR<Eigen::Matrix<TypeParam, -1, -1>>(
+            Eigen::Matrix<TypeParam, -1, -1>::Random(N, N)).householderQ();
+    Eigen::Matrix<TypeParam, -1, -1> B = Q * d.template cast<TypeParam>().asDiagonal() * Q.adjoint();
+    B = ((B + B.adjoint()) / 2).eval();
+    auto check = [&B](LanczosMethod<TypeParam> &lanczos, const Eigen::Vector<double, -1> &exact) {
+        Eigen::Vector<std::complex<double>, -1> computed = lanczos.ComputeEigs();
+        ASSERT_EQ(computed.size(), exact.size());
+        Eigen::Matrix<TypeParam, -1, -1> V = lanczos.GetEigenvectors();
+        for (int i = 0; i < exact.size(); i++) {
+            EXPECT_NEAR(exact[i], computed[i].real(), 1e-10);
+            EXPECT_EQ(0, computed[i].imag());
+            EXPECT_NEAR(1, V.col(i).norm(), 1e-12);
+            EXPECT_NEAR(0, (B * V.col(i) - computed[i].real() * V.col(i)).norm(), 1e-8);
+        }
+    };
+
+    // Largest magnitude, largest and smallest eigenvalues
+    Eigen::Vector<double, -1> magnitude(4), largest(3), smallest(2);
+    magnitude << 5, 4.5, 4, -3.5;
+    largest << 5, 4.5, 4;
+    smallest << -3.5, -3;
+    LanczosMethod<TypeParam> lanczos(B, 1e-12, this->maxit);
+    lanczos.SetNumEigs(4);
+    ASSERT_EQ(20, lanczos.GetSubspaceSize());
+    check(lanczos, magnitude);
+    // The basis is orthogonalized against the previous vectors only at some of the steps
+    EXPECT_LT(lanczos.GetReorthogonalizations(), lanczos.GetProducts());
+    lanczos.SetReorthogonalization("full");
+    check(lanczos, magnitude);
+    EXPECT_EQ(lanczos.GetReorthogonalizations(), lanczos.GetProducts());
+    lanczos.SetNumEigs(3);
+    lanczos.SetSelection("largest");
+    check(lanczos, largest);
+    lanczos.SetNumEigs(2);
+    lanczos.SetSelection("smallest");
+    lanczos.SetReorthogonalization("partial");
+    check(lanczos, smallest);
+
+    // Sparse matrix, linear operator and map
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> B_sparse = B.sparseView();
+    LanczosMethod<TypeParam> sparseLanczos(B_sparse, 1e-12, this->maxit);
+    sparseLanczos.SetNumEigs(4);
+    check(sparseLanczos, magnitude);
+    std::shared_ptr<const LinearOperator<TypeParam>> B_operator = std::make_shared<FunctionOperator<TypeParam>>(N,
+        [B](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {y.noalias() = B * x;});
+    LanczosMethod<TypeParam> operatorLanczos(B_operator, 1e-12, this->maxit);
+    operatorLanczos.SetNumEigs(2);
+    operatorLanczos.SetSelection("smallest");
+    operatorLanczos.SetSubspaceSize(10);
+    check(operatorLanczos, smallest);
+    this->map["matrix"] = B;
+    this->map["tol"] = 1e-12;
+    this->map["neigs"] = 3.0;
+    this->map["selection"] = std::string("largest");
+    this->map["reorthogonalization"] = std::string("full");
+    LanczosMethod<TypeParam> mapLanczos(this->map);
+    check(mapLanczos, largest);
+
+    ASSERT_THROW_MSG(lanczos.SetNumEigs(0), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(lanczos.SetNumEigs(N + 1), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(lanczos.SetSubspaceSize(2), InitializationError, "Attempting to set a subspace size out of range");
+    ASSERT_THROW_MSG(lanczos.SetSubspaceSize(N + 1), InitializationError, "Attempting to set a subspace size out of range");
+    ASSERT_THROW_MSG(lanczos.SetSelection("real"), InitializationError, "Unknown selection rule");
+    ASSERT_THROW_MSG(lanczos.SetReorthogonalization("selective"), InitializationError, "Unknown reorthogonalization");
+    lanczos.SetMaxit(1);
+    ASSERT_THROW_MSG(lanczos.ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    ASSERT_THROW_MSG(LanczosMethod<TypeParam> non_self_adjoint(this->A), InitializationError, "Attempting to set a non self-adjoint matrix");
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> A_sparse = this->A.sparseView();
+    ASSERT_THROW_MSG(LanczosMethod<TypeParam> non_self_adjoint(A_sparse), InitializationError, "Attempting to set a non self-adjoint matrix");
+    this->map["reorthogonalization"] = 1.0;
+    ASSERT_THROW_MSG(LanczosMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the reorthogonalization to string");
+}
+
+TYPED_TEST(MethodsTest, LOBPCGMethod) {
+    // Positive definite discrete Laplacian on a 15 x 15 grid, with a diagonal varying along the rows
+    int g = 15, N = g * g;
+    std::vector<Eigen::Triplet<TypeParam>> entries;
+    for (int i = 0; i < g; i++) {
+        for (int j = 0; j < g; j++) {
+            entries.emplace_back(i * g + j, i * g + j, 4 + 0.1 * i);
+            if (j + 1 < g) {
+                entries.emplace_back(i * g + j, i * g + j + 1, -1);
+                entries.emplace_back(i * g + j + 1, i * g + j, -1);
+            }
+            if (i + 1 < g) {
+                entries.emplace_back(i * g + j, (i + 1) * g + j, -1);
+                entries.emplace_back((i + 1) * g + j, i * g + j, -1);
+            }
+        }
+    }
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> B_sparse(N, N);
+    B_sparse.setFromTriplets(entries.begin(), entries.end());
+    Eigen::Matrix<TypeParam, -1, -1> B = B_sparse;
+    Eigen::Vector<double, -1> exact = Eigen::SelfAdjointEigenSolver<Eigen::Matrix<TypeParam, -1, -1>>(B, Eigen::EigenvaluesOnly).eigenvalues();
+    auto check = [&B, &exact](LOBPCGMethod<TypeParam> &lobpcg) {
+        int k = lobpcg.GetNumEigs();
+        Eigen::Vector<std::complex<double>, -1> computed = lobpcg.ComputeEigs();
+        ASSERT_EQ(computed.size(), k);
+        Eigen::Matrix<TypeParam, -1, -1> V = lobpcg.GetEigenvectors();
+        for (int i = 0; i < k; i++) {
+            EXPECT_NEAR(exact[i], computed[i].real(), 1e-10);
+            EXPECT_EQ(0, computed[i].imag());
+            EXPECT_NEAR(1, V.col(i).norm(), 1e-12);
+            EXPECT_NEAR(0, (B * V.col(i) - computed[i].real() * V.col(i)).norm(), 1e-8);
+        }
+    };
+
+    // Sparse matrix, without preconditioner and with the incomplete Cholesky factorization
+    LOBPCGMethod<TypeParam> lobpcg(B_sparse, 1e-10, this->maxit);
+    lobpcg.SetNumEigs(4);
+    ASSERT_EQ(9, lobpcg.GetBlockSize());
+    check(lobpcg);
+    int iterations = lobpcg.GetIterations();
+    // The converged vectors are not multiplied any more
+    EXPECT_LT(lobpcg.GetProducts(), (iterations + 1) * lobpcg.GetBlockSize());
+    lobpcg.SetPreconditioner("ichol");
+    check(lobpcg);
+    EXPECT_LT(lobpcg.GetIterations(), iterations);
+
+    // Dense matrix with the Jacobi preconditioner, set from the map
+    this->map["matrix"] = B;
+    this->map["tol"] = 1e-10;
+    this->map["neigs"] = 3.0;
+    this->map["block"] = 5.0;
+    this->map["preconditioner"] = std::string("jacobi");
+    LOBPCGMethod<TypeParam> denseLobpcg(this->map);
+    ASSERT_EQ("jacobi", denseLobpcg.GetPreconditioner());
+    check(denseLobpcg);
+
+    // Linear operator, with the exact inverse as preconditioner
+    std::shared_ptr<const LinearOperator<TypeParam>> B_operator = std::make_shared<FunctionOperator<TypeParam>>(N,
+        [B_sparse](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {y.noalias() = B_sparse * x;});
+    Eigen::LLT<Eigen::Matrix<TypeParam, -1, -1>> llt(B);
+    std::shared_ptr<const LinearOperator<TypeParam>> inverse = std::make_shared<FunctionOperator<TypeParam>>(N,
+        [llt](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {y = llt.solve(x);});
+    LOBPCGMethod<TypeParam> operatorLobpcg(B_operator, 1e-10, this->maxit);
+    operatorLobpcg.SetNumEigs(4);
+    operatorLobpcg.SetPreconditioner(inverse);
+    ASSERT_EQ("operator", operatorLobpcg.GetPreconditioner());
+    check(operatorLobpcg);
+    EXPECT_LT(operatorLobpcg.GetIterations(), lobpcg.GetIterations());
+    operatorLobpcg.SetPreconditioner("jacobi");
+    ASSERT_THROW_MSG(operatorLobpcg.ComputeEigs(), InitializationError, "Linear operators are not supported by this method");
+
+    ASSERT_THROW_MSG(lobpcg.SetNumEigs(0), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(lobpcg.SetNumEigs(N / 3 + 1), InitializationError, "Attempting to set a number of eigenvalues out of range");
+    ASSERT_THROW_MSG(lobpcg.SetBlockSize(3), InitializationError, "Attempting to set a block size out of range");
+    ASSERT_THROW_MSG(lobpcg.SetBlockSize(N / 3 + 1), InitializationError, "Attempting to set a block size out of range");
+    ASSERT_THROW_MSG(lobpcg.SetPreconditioner("ilu"), InitializationError, "Unknown preconditioner");
+    ASSERT_THROW_MSG(lobpcg.SetPreconditioner(std::shared_ptr<const LinearOperator<TypeParam>>()), InitializationError, "Attempting to set an invalid preconditioner");
+    lobpcg.SetMaxit(2);
+    ASSERT_THROW_MSG(lobpcg.ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    ASSERT_THROW_MSG(LOBPCGMethod<TypeParam> non_self_adjoint(this->A), InitializationError, "Attempting to set a non self-adjoint matrix");
+    this->map["preconditioner"] = 1.0;
+    ASSERT_THROW_MSG(LOBPCGMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the preconditioner to string");
+}
+
+TYPED_TEST(MethodsTest, ChebyshevFilter) {
+    // Filter on a diagonal matrix: one at the scaling point and bounded by 1 / T_d((s - c) / e) on the interval
+    int N = 200;
+    Eigen::Vector<double, -1> d = Eigen::Vector<double, -1>::LinSpaced(N, -1, 0.5);
+    d[N - 1] = 1;
+    auto diagonal = [&d](const Eigen::Vector<TypeParam, -1> &x, Eigen::Vector<TypeParam, -1> &y) {
+        y = d.cast<TypeParam>().cwiseProduct(x);
+    };
+    ChebyshevFilter<TypeParam> filter;
+    ASSERT_FALSE(filter.IsActive());
+    filter.SetDegree(8);
+    filter.SetInterval(-1, 0.5, 1);
+    ASSERT_TRUE(filter.IsActive());
+    Eigen::Vector<TypeParam, -1> x = Eigen::Vector<TypeParam, -1>::Ones(N), y;
+    filter.Apply(diagonal, x, y);
+    EXPECT_NEAR(1, std::abs(y[N - 1]), 1e-12);
+    EXPECT_LT(y.head(N - 1).cwiseAbs().maxCoeff(), (1 + 1e-12) / std::cosh(8 * std::acosh(5.0 / 3)));
+    Eigen::Matrix<TypeParam, -1, -1> Y;
+    filter.ApplyBlock([&diagonal](const Eigen::Matrix<TypeParam, -1, -1> &X, Eigen::Matrix<TypeParam, -1, -1> &Z) {
+        Eigen::Vector<TypeParam, -1> z;
+        Z.resize(X.rows(), X.cols());
+        for (int j = 0; j < X.cols(); j++) {
+            diagonal(X.col(j), z);
+            Z.col(j) = z;
+        }
+    }, x.replicate(1, 2), Y);
+    EXPECT_NEAR(0, (Y.col(0) - y).norm(), 1e-14);
+    EXPECT_NEAR(0, (Y.col(1) - y).norm(), 1e-14);
+
+    // The estimated interval contains the unwanted eigenvalues of the matrix, but not the largest one
+    d.head(N - 1) = Eigen::Vector<double, -1>::LinSpaced(N - 1, -0.8, 0.5);
+    ASSERT_TRUE(filter.Estimate(diagonal, x, 20, 1));
+    EXPECT_LT(filter.GetUpper(), 1);
+    EXPECT_NEAR(-0.8, filter.GetLower(), 1e-2);
+    EXPECT_GT(filter.GetScale(), filter.GetUpper());
+
+    // Hermitian matrix with eigenvalues 1, 0.995 and the others in [-0.9, 0.95]
+    std::srand(11);
+    d = Eigen::Vector<double, -1>::LinSpaced(N, -0.9, 0.95);
+    d[N - 2] = 0.995;
+    d[N - 1] = 1;
+    Eigen::Matrix<TypeParam, -1, -1> U = Eigen::HouseholderQR<Eigen::Matrix<TypeParam, -1, -1>>(
+            Eigen::Matrix<TypeParam, -1, -1>::Random(N, N)).householderQ();
+    Eigen::Matrix<TypeParam, -1, -1> B = U * d.cast<TypeParam>().asDiagonal() * U.adjoint();
+    B = (B + B.adjoint()) / 2;
+
+    // Power method: the filter cuts the number of iterations and of products
+    PowerMethod<TypeParam> power(B, 1e-12, 10000, Eigen::Vector<TypeParam, -1>::Ones(N));
+    EXPECT_NEAR(1, power.ComputeEigs()[0].real(), 1e-8);
+    int iterations = power.GetIterations(), products = power.GetProducts();
+    ASSERT_EQ(iterations, products);
+    power.SetFilterDegree(10);
+    ASSERT_EQ(10, power.GetFilterDegree());
+    EXPECT_NEAR(1, power.ComputeEigs()[0].real(), 1e-8);
+    EXPECT_LT(10 * power.GetIterations(), iterations);
+    EXPECT_LT(power.GetProducts(), products);
+    EXPECT_NEAR(0, (B * power.GetEigenvector() - power.GetEigenvector()).norm(), 1e-5);
+
+    // Subspace iteration: three largest magnitude eigenvalues
+    SubspaceIteration<TypeParam> subspace(B, 1e-10, 10000);
+    subspace.SetNumEigs(3);
+    Eigen::Vector<std::complex<double>, -1> computed = subspace.ComputeEigs();
+    iterations = subspace.GetIterations();
+    products = subspace.GetProducts();
+    subspace.SetFilterDegree(10);
+    EXPECT_NEAR(0, (subspace.ComputeEigs() - computed).norm(), 1e-8);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NEAR(d[N - 1 - i], computed[i].real(), 1e-8);
+    }
+    EXPECT_LT(10 * subspace.GetIterations(), iterations);
+    EXPECT_LT(subspace.GetProducts(), products);
+
+    // Degree from the map
+    this->map["filter"] = 4.0;
+    PowerMethod<TypeParam> mapPower(this->map);
+    ASSERT_EQ(4, mapPower.GetFilterDegree());
+    this->map["neigs"] = 1.0;
+    SubspaceIteration<TypeParam> mapSubspace(this->map);
+    ASSERT_EQ(4, mapSubspace.GetFilterDegree());
+
+    ASSERT_THROW_MSG(filter.SetDegree(-1), InitializationError, "Attempting to set a negative filter degree");
+    ASSERT_THROW_MSG(filter.SetInterval(1, 1, 2), InitializationError, "Attempting to set an empty interval");
+    ASSERT_THROW_MSG(filter.SetInterval(-1, 1, 0.5), InitializationError, "Attempting to set a scaling point inside the interval");
+    ASSERT_THROW_MSG(power.SetFilterDegree(-1), InitializationError, "Attempting to set a negative filter degree");
+    this->map["filter"] = std::string("ten");
+    ASSERT_THROW_MSG(PowerMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the filter degree to double");
+    ASSERT_THROW_MSG(SubspaceIteration<TypeParam> wrong_subspace(this->map), InitializationError, "Unable to cast the filter degree to double");
+}
+
+TYPED_TEST(MethodsTest, RayleighQuotientIteration) {
+    // Symmetric tridiagonal matrix with eigenvalues close to 1, 2, ..., N
+    int N = 100;
+    std::vector<Eigen::Triplet<TypeParam>> triplets;
+    for (int i = 0; i < N; i++) {
+        triplets.emplace_back(i, i, i + 1);
+        if (i > 0) {
+            triplets.emplace_back(i, i - 1, 0.3);
+            triplets.emplace_back(i - 1, i, 0.3);
+        }
+    }
+    Eigen::SparseMatrix<TypeParam, Eigen::RowMajor> B_sparse(N, N);
+    B_sparse.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::Matrix<TypeParam, -1, -1> B = B_sparse;
+    Eigen::Vector<double, -1> exact = Eigen::SelfAdjointEigenSolver<Eigen::Matrix<TypeParam, -1, -1>>(B, Eigen::EigenvaluesOnly).eigenvalues();
+    // Rough estimate of the 50th eigenvalue, with ratio 0.45 / 0.55 for the fixed shift
+    TypeParam shift = 0.55 * exact[49] + 0.45 * exact[50];
+    Eigen::Vector<TypeParam, -1> ones = Eigen::Vector<TypeParam, -1>::Ones(N);
+
+    ShiftInvPowerMethod<TypeParam> fixed(B, 1e-12, this->maxit, ones, shift);
+    EXPECT_NEAR(exact[49], fixed.ComputeEigs()[0].real(), 1e-8);
+    ASSERT_EQ(0, fixed.GetRefactorizationPeriod());
+    ASSERT_EQ(0, fixed.GetRefactorizations());
+    int iterations = fixed.GetIterations();
+
+    // Updating the shift at every iteration or every three iterations
+    for (int period : {1, 3}) {
+        ShiftInvPowerMethod<TypeParam> rqi(B, 1e-12, this->maxit, ones, shift);
+        rqi.SetRefactorizationPeriod(period);
+        this->computed_eigs = rqi.ComputeEigs();
+        EXPECT_NEAR(exact[49], this->computed_eigs[0].real(), 1e-10);
+        EXPECT_NEAR(0, this->computed_eigs[0].imag(), 1e-12);
+        EXPECT_LT(5 * rqi.GetIterations(), iterations);
+        EXPECT_GT(rqi.GetRefactorizations(), 0);
+        EXPECT_LE(rqi.GetRefactorizations(), rqi.GetIterations() / period);
+        Eigen::Vector<TypeParam, -1> v = rqi.GetEigenvector();
+        EXPECT_NEAR(1, v.norm(), 1e-12);
+        EXPECT_NEAR(0, (B * v - exact[49] * v).norm(), 1e-8);
+    }
+
+    // Sparse matrix and Hessenberg reduction, with the period from the map
+    this->map["matrix"] = B_sparse;
+    this->map["x0"] = ones;
+    this->map["shift"] = shift;
+    this->map["tol"] = 1e-12;
+    this->map["refactorization"] = 2.0;
+    ShiftInvPowerMethod<TypeParam> sparseRqi(this->map);
+    ASSERT_EQ(2, sparseRqi.GetRefactorizationPeriod());
+    EXPECT_NEAR(exact[49], sparseRqi.ComputeEigs()[0].real(), 1e-10);
+    EXPECT_LT(5 * sparseRqi.GetIterations(), iterations);
+    ShiftInvPowerMethod<TypeParam> hessenbergRqi(B, 1e-12, this->maxit, ones, shift);
+    hessenbergRqi.SetHessenbergReduction(std::make_shared<const HessenbergReduction<TypeParam>>(B));
+    hessenbergRqi.SetRefactorizationPeriod(1);
+    EXPECT_NEAR(exact[49], hessenbergRqi.ComputeEigs()[0].real(), 1e-10);
+
+    ASSERT_THROW_MSG(fixed.SetRefactorizationPeriod(-1), InitializationError, "Attempting to set a negative refactorization period");
+    hessenbergRqi.SetMaxit(2);
+    ASSERT_THROW_MSG(hessenbergRqi.ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    this->map["refactorization"] = std::string("one");
+    ASSERT_THROW_MSG(ShiftInvPowerMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the refactorization period to double");
+}
+
+TYPED_TEST(MethodsTest, PowerMethodAcceleration) {
+    // Hermitian matrix with eigenvalues 1, 0.99 and the others in [-0.5, 0.9]
+    int N = 200;
+    std::srand(13);
+    Eigen::Vector<double, -1> d = Eigen::Vector<double, -1>::LinSpaced(N, -0.5, 0.9);
+    d[N - 2] = 0.99;
+    d[N - 1] = 1;
+    Eigen::Matrix<TypeParam, -1, -1> U = Eigen::HouseholderQR<Eigen::Matrix<TypeParam, -1, -1>>(
+            Eigen::Matrix<TypeParam, -1, -1>::Random(N, N)).householderQ();
+    Eigen::Matrix<TypeParam, -1, -1> B = U * d.cast<TypeParam>().asDiagonal() * U.adjoint();
+    B = (B + B.adjoint()) / 2;
+    Eigen::Vector<TypeParam, -1> ones = Eigen::Vector<TypeParam, -1>::Ones(N);
+
+    PowerMethod<TypeParam> power(B, 1e-12, 10000, ones);
+    ASSERT_EQ("none", power.GetAcceleration());
+    EXPECT_NEAR(1, power.ComputeEigs()[0].real(), 1e-9);
+    int iterations = power.GetIterations();
+    ASSERT_EQ(0, power.GetIterationsSaved());
+
+    // Aitken extrapolation: the saved iterations are estimated close to the actual ones
+    power.SetAcceleration("aitken");
+    EXPECT_NEAR(1, power.ComputeEigs()[0].real(), 1e-9);
+    EXPECT_LT(power.GetIterations(), iterations);
+    EXPECT_GT(power.GetIterationsSaved(), 0);
+    EXPECT_NEAR(iterations, power.GetIterations() + power.GetIterationsSaved(), 0.2 * iterations);
+
+    // Momentum with the exact and with the estimated second eigenvalue
+    power.SetAcceleration("momentum");
+    power.SetSecondEigenvalue(0.99);
+    EXPECT_NEAR(1, power.ComputeEigs()[0].real(), 1e-9);
+    EXPECT_LT(3 * power.GetIterations(), iterations);
+    EXPECT_GT(power.GetIterationsSaved(), 0);
+    EXPECT_NEAR(0, (B * power.GetEigenvector() - power.GetEigenvector()).norm(), 1e-5);
+    power.SetSecondEigenvalue(0);
+    EXPECT_NEAR(1, power.ComputeEigs()[0].real(), 1e-9);
+    EXPECT_LT(power.GetIterations(), iterations);
+
+    // Accelerators of the inverse power method, from the map: the iterated matrix is the inverse of B + 2I
+    this->map["matrix"] = Eigen::Matrix<TypeParam, -1, -1>(B + 2 * Eigen::Matrix<TypeParam, -1, -1>::Identity(N, N));
+    this->map["x0"] = ones;
+    this->map["tol"] = 1e-12;
+    this->map["maxit"] = 10000.0;
+    this->map["acceleration"] = std::string("momentum");
+    this->map["lambda2"] = 1 / (1.5 + 1.4 / (N - 1));
+    InvPowerMethod<TypeParam> invPower(this->map);
+    ASSERT_EQ("momentum", invPower.GetAcceleration());
+    ASSERT_EQ(1 / (1.5 + 1.4 / (N - 1)), invPower.GetSecondEigenvalue());
+    EXPECT_NEAR(1.5, invPower.ComputeEigs()[0].real(), 1e-9);
+
+    ASSERT_THROW_MSG(power.SetAcceleration("chebyshev"), InitializationError, "Unknown acceleration");
+    ASSERT_THROW_MSG(power.SetSecondEigenvalue(-1), InitializationError, "Attempting to set a negative estimate of the second eigenvalue");
+    this->map["lambda2"] = std::string("0.5");
+    ASSERT_THROW_MSG(InvPowerMethod<TypeParam> wrong_second(this->map), InitializationError, "Unable to cast the second eigenvalue to double");
+    this->map["acceleration"] = 1.0;
+    ASSERT_THROW_MSG(InvPowerMethod<TypeParam> wrong_type(this->map), InitializationError, "Unable to cast the acceleration to string");
+}
+
+TYPED_TEST(MethodsTest, SymmetricQRMethod) {
+    // Random symmetric or Hermitian matrix, the exact eigenvalues are computed using Eigen
+    int N = 100;
+    std::srand(5);
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N);
+    B = (B + B.adjoint()).eval();
+    this->exact_eigs = Eigen::SelfAdjointEigenSolver<Eigen::Matrix<TypeParam, -1, -1>>(B, Eigen::EigenvaluesOnly).eigenvalues();
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) { return abs(i) > abs(j);};
+    std::sort(this->exact_eigs.data(), this->exact_eigs.data() + N, abs_complex);
+
+    this->p_eigsSolver = std::make_unique<SymmetricQRMethod<TypeParam>>(B, 1e-14, this->maxit);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), N);
+    for (int i = 0; i < N ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-10);
+        EXPECT_EQ(0, this->computed_eigs[i].imag());
+    }
+    // At most a few steps are needed for each eigenvalue
+    EXPECT_LT(this->p_eigsSolver->GetIterations(), 3 * N);
+
+    this->p_eigsSolver = std::make_unique<SymmetricQRMethod<TypeParam>>(B, this->tol, 3);
+    ASSERT_THROW_MSG(this->p_eigsSolver->ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    ASSERT_THROW_MSG(this->p_eigsSolver.reset(new SymmetricQRMethod<TypeParam>(this->A)), InitializationError, "Attempting to set a non self-adjoint matrix");
+}
+
+TYPED_TEST(MethodsTest, BisectionMethod) {
+    // Random symmetric or Hermitian matrix, the exact eigenvalues are computed using Eigen
+    int N = 100;
+    std::srand(6);
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N);
+    B = (B + B.adjoint()).eval();
+    Eigen::Vector<double, -1> exact = Eigen::SelfAdjointEigenSolver<Eigen::Matrix<TypeParam, -1, -1>>(B, Eigen::EigenvaluesOnly).eigenvalues();
+
+    // Eigenvalues with given indices
+    auto p_bisection = std::make_unique<BisectionMethod<TypeParam>>(B, 1e-14, this->maxit);
+    p_bisection->SetIndices(10, 19);
+    this->computed_eigs = p_bisection->ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_NEAR(exact[10 + i], this->computed_eigs[i].real(), 1e-10);
+        EXPECT_EQ(0, this->computed_eigs[i].imag());
+    }
+
+    // Eigenvalues in an interval, set from the map
+    this->map["matrix"] = B;
+    this->map["tol"] = 1e-14;
+    this->map["lower"] = -1.0;
+    this->map["upper"] = 2.0;
+    p_bisection = std::make_unique<BisectionMethod<TypeParam>>(this->map);
+    this->computed_eigs = p_bisection->ComputeEigs();
+    int first = std::lower_bound(exact.data(), exact.data() + N, -1.0) - exact.data();
+    int last = std::lower_bound(exact.data(), exact.data() + N, 2.0) - exact.data();
+    ASSERT_EQ(this->computed_eigs.size(), last - first);
+    for (int i = first; i < last; i++) {
+        EXPECT_NEAR(exact[i], this->computed_eigs[i - first].real(), 1e-10);
+    }
+
+    ASSERT_THROW_MSG(p_bisection->SetInterval(1, 1), InitializationError, "Attempting to set an empty interval");
+    ASSERT_THROW_MSG(p_bisection->SetIndices(5, N), InitializationError, "Attempting to set indices out of range");
+    ASSERT_THROW_MSG(p_bisection->SetIndices(5, 4), InitializationError, "Attempting to set indices out of range");
+    p_bisection = std::make_unique<BisectionMethod<TypeParam>>(B, 1e-14, 3);
+    ASSERT_THROW_MSG(p_bisection->ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    ASSERT_THROW_MSG(p_bisection.reset(new BisectionMethod<TypeParam>(this->A)), InitializationError, "Attempting to set a non self-adjoint matrix");
+}
+
+TYPED_TEST(MethodsTest, EigsPlanner) {
+    int N = 30;
+    std::srand(7);
+    Eigen::Matrix<TypeParam, -1, -1> B = Eigen::Matrix<TypeParam, -1, -1>::Random(N, N);
+
+    // Triangular matrix: the eigenvalues are the diagonal entries and no iteration is executed
+    Eigen::Matrix<TypeParam, -1, -1> U = B.template triangularView<Eigen::Upper>();
+    this->map["matrix"] = U;
+    EigsPlanner<TypeParam> planner(this->map);
+    ASSERT_EQ(planner.GetMethod(), "triangular");
+    ASSERT_TRUE(planner.GetStructure().IsTriangular());
+    ASSERT_FALSE(planner.GetStructure().IsDiagonal());
+    ASSERT_EQ(planner.GetStructure().upper_bandwidth, N - 1);
+    EXPECT_NEAR(planner.GetStructure().fill_ratio, (N + 1) / (2.0 * N), 1e-14);
+    this->p_eigsSolver = planner.CreateSolver();
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    ASSERT_EQ(this->p_eigsSolver->GetIterations(), 0);
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ(std::count(this->computed_eigs.data(), this->computed_eigs.data() + N, std::complex<double>(U(i, i))), 1);
+    }
+
+    // Self-adjoint matrix, all the eigenvalues or only some of them
+    Eigen::Matrix<TypeParam, -1, -1> S = B + B.adjoint();
+    this->map["matrix"] = S;
+    ASSERT_EQ(EigsPlanner<TypeParam>(this->map).GetMethod(), "symqr");
+    this->map["first"] = 0.0;
+    this->map["last"] = 4.0;
+    ASSERT_EQ(EigsPlanner<TypeParam>(this->map).GetMethod(), "bisection");
+    this->computed_eigs = MakeEigsSolver<TypeParam>(this->map)->ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), 5);
+
+    // General matrix: only some eigenvalues are not available
+    this->map["matrix"] = this->A;
+    ASSERT_THROW_MSG(EigsPlanner<TypeParam> planner_slice(this->map), InitializationError, "No method available for the requested eigenvalues");
+    ASSERT_THROW_MSG(TriangularEigs<TypeParam> triangular(this->A), InitializationError, "Attempting to set a non triangular matrix");
+}
+
+TEST_F(MethodsTest_double, EigsPlannerGeneralMatrix) {
+    this->p_eigsSolver = MakeEigsSolver<double>(this->map);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    for (int i = 0; i < n ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+    ASSERT_EQ(EigsPlanner<double>(this->map).GetMethod(), "qr");
+
+    // Matrix already in Hessenberg form
+    Eigen::Matrix<double, -1, -1> H = HessenbergReduction<double>(this->A).GetMatrixH();
+    this->map["matrix"] = H;
+    ASSERT_TRUE(EigsPlanner<double>(this->map).GetStructure().IsHessenberg());
+    this->computed_eigs = MakeEigsSolver<double>(this->map)->ComputeEigs();
+    for (int i = 0; i < n ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+    }
+}
+
+TEST_F(MethodsTest_double, BalancingIterations){
+    // Symmetric matrix made badly scaled by a diagonal similarity with entries from 1e-5 to 1e5
+    int N = 20;
+    std::srand(4);
+    Eigen::Matrix<double, -1, -1> M = Eigen::Matrix<double, -1, -1>::Random(N, N);
+    M = (M + M.transpose()).eval();
+    Eigen::Vector<double, -1> d(N);
+    for (int i = 0; i < N; i++) {
+        d(i) = std::pow(10.0, -5 + 10.0 * i / (N - 1));
+    }
+    Eigen::Matrix<double, -1, -1> B = d.asDiagonal() * M * d.cwiseInverse().asDiagonal();
+    this->exact_eigs = Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, -1, -1>>(M).eigenvalues();
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) { return abs(i) > abs(j);};
+    std::sort(this->exact_eigs.data(), this->exact_eigs.data() + N, abs_complex);
+    Eigen::Vector<double, -1> x = Eigen::Vector<double, -1>::Ones(N);
+
+    // Without balancing the inverse power method with the LU factorization with full pivoting does not converge
+    auto p_invPowerMethod = std::make_unique<InvPowerMethod<double>>(B, 1e-12, this->maxit, x);
+    p_invPowerMethod->SetFactorization("fullpivlu");
+    ASSERT_THROW_MSG(p_invPowerMethod->ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+    p_invPowerMethod->SetBalance(true);
+    this->computed_eigs = p_invPowerMethod->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[N - 1].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_LT(p_invPowerMethod->GetIterations(), 50);
+
+    auto p_powerMethod = std::make_unique<PowerMethod<double>>(B, 1e-12, this->maxit, x);
+    p_powerMethod->ComputeEigs();
+    int it_unbalanced = p_powerMethod->GetIterations();
+    p_powerMethod->SetBalance(true);
+    this->computed_eigs = p_powerMethod->ComputeEigs();
+    EXPECT_NEAR(this->exact_eigs[0].real(), this->computed_eigs[0].real(), 1e-8);
+    EXPECT_LT(p_powerMethod->GetIterations(), it_unbalanced);
+
+    // Without balancing the QR method returns inaccurate eigenvalues
+    auto p_QRMethod = std::make_unique<QRMethod<double>>(B, 1e-14, this->maxit);
+    p_QRMethod->SetBalance(true);
+    this->computed_eigs = p_QRMethod->ComputeEigs();
+    for (int i = 0; i < N ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+}
 
 TEST_F(MethodsTest_double, QRMethod){
     this->p_eigsSolver = std::make_unique<QRMethod<double>>(this->A, this->tol, this->maxit);
@@ -229,3 +1319,108 @@ TEST_F(MethodsTest_double, QRMethod){
     ASSERT_THROW_MSG(this->p_eigsSolver->ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
 
 }
+
+TEST_F(MethodsTest_double, QRMethodComplexConjugateEigs){
+    // Random matrix with pairs of complex conjugate eigenvalues, the exact eigenvalues are computed using Eigen
+    int N = 60;
+    std::srand(0);
+    Eigen::Matrix<double, -1, -1> B = Eigen::Matrix<double, -1, -1>::Random(N, N);
+    this->exact_eigs = Eigen::EigenSolver<Eigen::Matrix<double, -1, -1>>(B, false).eigenvalues();
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (abs(i) != abs(j)) {
+            return abs(i) > abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(this->exact_eigs.data(), this->exact_eigs.data() + N, abs_complex);
+
+    this->p_eigsSolver = std::make_unique<QRMethod<double>>(B, 1e-14, this->maxit);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    ASSERT_EQ(this->computed_eigs.size(), N);
+    for (int i = 0; i < N ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+}
+
+TEST_F(MethodsTest_double, QRMethodReducibleMatrix){
+    // Block diagonal matrix: the Hessenberg form has zero subdiagonal entries and the blocks are processed independently
+    int N = 30;
+    std::srand(1);
+    Eigen::Matrix<double, -1, -1> B = Eigen::Matrix<double, -1, -1>::Zero(N + n, N + n);
+    B.topLeftCorner(N, N) = Eigen::Matrix<double, -1, -1>::Random(N, N);
+    B.bottomRightCorner(n, n) = A;
+    Eigen::Vector<std::complex<double>, -1> exact(N + n);
+    exact << Eigen::EigenSolver<Eigen::Matrix<double, -1, -1>>(B.topLeftCorner(N, N), false).eigenvalues(), exact_eigs;
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (abs(i) != abs(j)) {
+            return abs(i) > abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(exact.data(), exact.data() + N + n, abs_complex);
+
+    this->p_eigsSolver = std::make_unique<QRMethod<double>>(B, 1e-14, this->maxit);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    for (int i = 0; i < N + n ; i++) {
+        EXPECT_NEAR(exact[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(exact[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+}
+
+TEST_F(MethodsTest_double, QRMethodLargeMatrix){
+    // Random matrix large enough to use the multishift iterations with aggressive early deflation
+    int N = 150;
+    std::srand(2);
+    Eigen::Matrix<double, -1, -1> B = Eigen::Matrix<double, -1, -1>::Random(N, N);
+    this->exact_eigs = Eigen::EigenSolver<Eigen::Matrix<double, -1, -1>>(B, false).eigenvalues();
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (abs(i) != abs(j)) {
+            return abs(i) > abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(this->exact_eigs.data(), this->exact_eigs.data() + N, abs_complex);
+
+    this->p_eigsSolver = std::make_unique<QRMethod<double>>(B, 1e-14, this->maxit);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    for (int i = 0; i < N ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+}
+
+TEST_F(MethodsTest_complex, QRMethod){
+    this->p_eigsSolver = std::make_unique<QRMethod<std::complex<double>>>(this->map);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    for (int i = 0; i < n ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+    this->p_eigsSolver = std::make_unique<QRMethod<std::complex<double>>>(this->A, this->tol, 3);
+    ASSERT_THROW_MSG(this->p_eigsSolver->ComputeEigs(), ConvergenceError, "Reached maximum number of iterations");
+}
+
+TEST_F(MethodsTest_complex, QRMethodLargeMatrix){
+    // Random complex matrix, the exact eigenvalues are computed using Eigen
+    int N = 150;
+    std::srand(8);
+    Eigen::Matrix<std::complex<double>, -1, -1> B = Eigen::Matrix<std::complex<double>, -1, -1>::Random(N, N);
+    this->exact_eigs = Eigen::ComplexEigenSolver<Eigen::Matrix<std::complex<double>, -1, -1>>(B, false).eigenvalues();
+    auto abs_complex = [](std::complex<double> i, std::complex<double> j) {
+        if (abs(i) != abs(j)) {
+            return abs(i) > abs(j);
+        }
+        return (i.real() != j.real()) ? (i.real() > j.real()) : (i.imag() > j.imag());
+    };
+    std::sort(this->exact_eigs.data(), this->exact_eigs.data() + N, abs_complex);
+
+    this->p_eigsSolver = std::make_unique<QRMethod<std::complex<double>>>(B, 1e-14, this->maxit);
+    this->computed_eigs = this->p_eigsSolver->ComputeEigs();
+    for (int i = 0; i < N ; i++) {
+        EXPECT_NEAR(this->exact_eigs[i].real(), this->computed_eigs[i].real(), 1e-8);
+        EXPECT_NEAR(this->exact_eigs[i].imag(), this->computed_eigs[i].imag(), 1e-8);
+    }
+    // About two steps are needed for each eigenvalue
+    EXPECT_LT(this->p_eigsSolver->GetIterations(), 4 * N);
+}